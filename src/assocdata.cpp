@@ -289,6 +289,23 @@ Parent_* Assoc_<Parent_>::Index( ArrayIndexListT* ixList)
   SizeT recordNum;
   bool ixEmpty = ixList->ToAssocIndex( recordNum);
 
+  // plain files are accessed through a memory mapping: no seek and read
+  // per record, the record is copied straight from the page cache
+  // (structs are stored packed in the file, they are read tag by tag)
+  const char* record = (this->Type() == GDL_STRUCT) ? NULL :
+    fileUnits[ lun].MappedRange( fileOffset + recordNum * sliceSize, sliceSize);
+  if( record != NULL)
+    {
+      if( ixEmpty)
+	{
+	  Parent_* res = Parent_::New( this->Dim(), BaseGDL::NOZERO);
+	  memcpy( res->DataAddr(), record, sliceSize);
+	  return res;
+	}
+      memcpy( this->DataAddr(), record, sliceSize);
+      return Parent_::Index( ixList);
+    }
+
   istream& fs = fileUnits[lun].Compress()?static_cast<std::istream&>(fileUnits[lun].IgzStream()):static_cast<std::istream&>(fileUnits[lun].IStream());
   fileUnits[ lun].Seek( fileOffset + recordNum * sliceSize);
   Parent_::Read( fs,
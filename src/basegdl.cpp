@@ -91,6 +91,11 @@ BaseGDL* BaseGDL::Transpose( DUInt* perm)
   throw GDLException("BaseGDL::Transpose(...) called.");
 }
 
+void BaseGDL::TransposeInPlace()
+{
+  throw GDLException("BaseGDL::TransposeInPlace() called.");
+}
+
 void BaseGDL::MinMax(DLong* minE, DLong* maxE,
               BaseGDL** minVal, BaseGDL** maxVal, bool omitNaN,
               SizeT start, SizeT stop, SizeT step, DLong valIx, bool useAbs)
@@ -489,6 +489,7 @@ public:
   virtual int HashCompare( BaseGDL* p2) const;
   
   virtual BaseGDL* Transpose( DUInt* perm);
+  virtual void TransposeInPlace(); // square 2D arrays only
   virtual BaseGDL* Rotate( DLong dir);
   virtual void Reverse( DLong dim);
   virtual BaseGDL* DupReverse( DLong dim);
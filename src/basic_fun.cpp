@@ -50,6 +50,7 @@
 #include <limits>
 #include <string>
 #include <fstream>
+#include <list>
 //#include <memory>
 #include <regex.h> // stregex
 
@@ -72,6 +73,7 @@ extern "C" char **environ;
 #include "typedefs.hpp"
 #include "base64.hpp"
 #include "objects.hpp"
+#include "list.hpp" // STRSPLIT result
 //#include "file.hpp"
 
 
@@ -1169,10 +1171,10 @@ namespace lib {
 					  BaseGDL::NOZERO);
 		
 	SizeT nE=p1Float->N_Elements();
-	// #pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
+#pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i<nE; i++)
+#pragma omp for
+	  for( OMPInt i=0; i<nE; i++)
 	    {
 	      (*res)[i]=Complex( (*p0Float)[0], (*p1Float)[i]);
 	    }
@@ -1185,10 +1187,10 @@ namespace lib {
 					  BaseGDL::NOZERO);
 		
 	SizeT nE=p0Float->N_Elements();
-	// #pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
+#pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i<nE; i++)
+#pragma omp for
+	  for( OMPInt i=0; i<nE; i++)
 	    {
 	      (*res)[i]=Complex( (*p0Float)[i], (*p1Float)[0]);
 	    }
@@ -1201,10 +1203,10 @@ namespace lib {
 					  BaseGDL::NOZERO);
 
 	SizeT nE=p1Float->N_Elements();
-	// #pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
+#pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i<nE; i++)
+#pragma omp for
+	  for( OMPInt i=0; i<nE; i++)
 	    {
 	      (*res)[i]=Complex( (*p0Float)[i], (*p1Float)[i]);
 	    }
@@ -1217,10 +1219,10 @@ namespace lib {
 					  BaseGDL::NOZERO);
 		
 	SizeT nE=p0Float->N_Elements();
-	// #pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
+#pragma omp parallel if (nE >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nE))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i<nE; i++)
+#pragma omp for
+	  for( OMPInt i=0; i<nE; i++)
 	    {
 	      (*res)[i]=Complex( (*p0Float)[i], (*p1Float)[i]);
 	    }
@@ -1809,20 +1811,27 @@ namespace lib {
     BaseGDL* e1=e->GetParDefined( 0);//, "LOGICAL_AND");
     BaseGDL* e2=e->GetParDefined( 1);//, "LOGICAL_AND");
 
+    // LogTrue( i) throws for structs, not to happen in the parallel loops
+    for( SizeT p=0; p<2; ++p)
+      if( e->GetParDefined( p)->Type() == GDL_STRUCT)
+	e->Throw( "Struct expression not allowed in this context: " + e->GetParString( p));
+
     ULong nEl1 = e1->N_Elements();
     ULong nEl2 = e2->N_Elements();
 
     Data_<SpDByte>* res;
+    Guard<Data_<SpDByte> > resGuard;
 
     if( e1->Scalar()) 
       {
 	if( e1->LogTrue(0)) 
 	  {
 	    res= new Data_<SpDByte>( e2->Dim(), BaseGDL::NOZERO);
-	    // #pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
+	    resGuard.Init( res);
+#pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
 	    {
-	      // #pragma omp for
-	      for( SizeT i=0; i < nEl2; i++)
+#pragma omp for
+	      for( OMPInt i=0; i < nEl2; i++)
 		(*res)[i] = e2->LogTrue( i) ? 1 : 0;
 	    }
 	  }
@@ -1836,10 +1845,11 @@ namespace lib {
 	if( e2->LogTrue(0)) 
 	  {
 	    res= new Data_<SpDByte>( e1->Dim(), BaseGDL::NOZERO);
-	    // #pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
+	    resGuard.Init( res);
+#pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
 	    {
-	      // #pragma omp for
-	      for( SizeT i=0; i < nEl1; i++)
+#pragma omp for
+	      for( OMPInt i=0; i < nEl1; i++)
 		(*res)[i] = e1->LogTrue( i) ? 1 : 0;
 	    }
 	  }
@@ -1851,24 +1861,26 @@ namespace lib {
     else if( nEl2 < nEl1) 
       {
 	res= new Data_<SpDByte>( e2->Dim(), BaseGDL::NOZERO);
-	// #pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
+	resGuard.Init( res);
+#pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i < nEl2; i++)
+#pragma omp for
+	  for( OMPInt i=0; i < nEl2; i++)
 	    (*res)[i] = (e1->LogTrue( i) && e2->LogTrue( i)) ? 1 : 0;
 	}
       }
     else // ( nEl2 >= nEl1)
       {
 	res= new Data_<SpDByte>( e1->Dim(), BaseGDL::NOZERO);
-	// #pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
+	resGuard.Init( res);
+#pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i < nEl1; i++)
+#pragma omp for
+	  for( OMPInt i=0; i < nEl1; i++)
 	    (*res)[i] = (e1->LogTrue( i) && e2->LogTrue( i)) ? 1 : 0;
 	}
       }
-    return res;
+    return resGuard.release();
   }
 
   // gdl_ naming because of weired namespace problem in MSVC
@@ -1882,30 +1894,38 @@ namespace lib {
     BaseGDL* e1=e->GetParDefined( 0);//, "LOGICAL_OR");
     BaseGDL* e2=e->GetParDefined( 1);//, "LOGICAL_OR");
 
+    // LogTrue( i) throws for structs, not to happen in the parallel loops
+    for( SizeT p=0; p<2; ++p)
+      if( e->GetParDefined( p)->Type() == GDL_STRUCT)
+	e->Throw( "Struct expression not allowed in this context: " + e->GetParString( p));
+
     ULong nEl1 = e1->N_Elements();
     ULong nEl2 = e2->N_Elements();
 
     Data_<SpDByte>* res;
+    Guard<Data_<SpDByte> > resGuard;
 
     if( e1->Scalar()) 
       {
 	if( e1->LogTrue(0)) 
 	  {
 	    res= new Data_<SpDByte>( e2->Dim(), BaseGDL::NOZERO);
-	    // #pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
+	    resGuard.Init( res);
+#pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
 	    {
-	      // #pragma omp for
-	      for( SizeT i=0; i < nEl2; i++)
+#pragma omp for
+	      for( OMPInt i=0; i < nEl2; i++)
 		(*res)[i] = 1;
 	    }
 	  }
 	else
 	  {
 	    res= new Data_<SpDByte>( e2->Dim(), BaseGDL::NOZERO);
-	    // #pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
+	    resGuard.Init( res);
+#pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
 	    {
-	      // #pragma omp for
-	      for( SizeT i=0; i < nEl2; i++)
+#pragma omp for
+	      for( OMPInt i=0; i < nEl2; i++)
 		(*res)[i] = e2->LogTrue( i) ? 1 : 0;
 	    }
 	  }
@@ -1915,20 +1935,22 @@ namespace lib {
 	if( e2->LogTrue(0)) 
 	  {
 	    res= new Data_<SpDByte>( e1->Dim(), BaseGDL::NOZERO);
-	    // #pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
+	    resGuard.Init( res);
+#pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
 	    {
-	      // #pragma omp for
-	      for( SizeT i=0; i < nEl1; i++)
+#pragma omp for
+	      for( OMPInt i=0; i < nEl1; i++)
 		(*res)[i] = 1;
 	    }
 	  }
 	else
 	  {
 	    res= new Data_<SpDByte>( e1->Dim(), BaseGDL::NOZERO);
-	    // #pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
+	    resGuard.Init( res);
+#pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
 	    {
-	      // #pragma omp for
-	      for( SizeT i=0; i < nEl1; i++)
+#pragma omp for
+	      for( OMPInt i=0; i < nEl1; i++)
 		(*res)[i] = e1->LogTrue( i) ? 1 : 0;
 	    }
 	  }
@@ -1936,24 +1958,26 @@ namespace lib {
     else if( nEl2 < nEl1) 
       {
 	res= new Data_<SpDByte>( e2->Dim(), BaseGDL::NOZERO);
-	// #pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
+	resGuard.Init( res);
+#pragma omp parallel if (nEl2 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl2))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i < nEl2; i++)
+#pragma omp for
+	  for( OMPInt i=0; i < nEl2; i++)
 	    (*res)[i] = (e1->LogTrue( i) || e2->LogTrue( i)) ? 1 : 0;
 	}
       }
     else // ( nEl2 >= nEl1)
       {
 	res= new Data_<SpDByte>( e1->Dim(), BaseGDL::NOZERO);
-	// #pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
+	resGuard.Init( res);
+#pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
 	{
-	  // #pragma omp for
-	  for( SizeT i=0; i < nEl1; i++)
+#pragma omp for
+	  for( OMPInt i=0; i < nEl1; i++)
 	    (*res)[i] = (e1->LogTrue( i) || e2->LogTrue( i)) ? 1 : 0;
 	}
       }
-    return res;
+    return resGuard.release();
   }
 
   BaseGDL* logical_true( BaseGDL* e1, bool isReference)//( EnvT* e);
@@ -1969,18 +1993,109 @@ namespace lib {
     // 
     //     BaseGDL* e1=e->GetParDefined( 0);//, "LOGICAL_TRUE");
     //     
+    // LogTrue( i) throws for structs, not to happen in the parallel loop
+    if( e1->Type() == GDL_STRUCT)
+      throw GDLException( "Struct expression not allowed in this context.");
+
     ULong nEl1 = e1->N_Elements();
 
     Data_<SpDByte>* res = new Data_<SpDByte>( e1->Dim(), BaseGDL::NOZERO);
-    // #pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
+#pragma omp parallel if (nEl1 >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl1))
     {
-      // #pragma omp for
-      for( SizeT i=0; i < nEl1; i++)
+#pragma omp for
+      for( OMPInt i=0; i < nEl1; i++)
 	(*res)[i] = e1->LogTrue( i) ? 1 : 0;
     }    
     return res;
   }
 
+  // r[d + k*nDim] = d-th subscript of the one-dimensional index ix[k]
+  template< typename T>
+  static void array_indices_kernel( const DLong64GDL* ix, const SizeT* dim, SizeT nDim, T* r)
+  {
+    SizeT nIx = ix->N_Elements();
+    TRACEOMP( __FILE__, __LINE__)
+#pragma omp parallel for if (nIx >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nIx))
+    for( OMPInt k=0; k<nIx; ++k)
+      {
+	SizeT v = (*ix)[ k];
+	T* rk = r + k * nDim;
+	for( SizeT d=0; d+1<nDim; ++d)
+	  {
+	    SizeT q = v / dim[ d];
+	    rk[ d] = v - q * dim[ d];
+	    v = q;
+	  }
+	rk[ nDim-1] = v;
+      }
+  }
+
+  BaseGDL* array_indices( EnvT* e)
+  {
+    e->NParam( 2);
+
+    BaseGDL* p0 = e->GetParDefined( 0);
+    BaseGDL* p1 = e->GetParDefined( 1);
+
+    DType ty = p1->Type();
+    if( !NumericType( ty) || ComplexType( ty))
+      e->Throw( "Index must be of integer type.");
+
+    static int dimensionsIx = e->KeywordIx( "DIMENSIONS");
+    SizeT dim[ MAXRANK];
+    SizeT nDim;
+    SizeT nTot;
+    if( e->KeywordSet( dimensionsIx))
+      {
+	// A is the vector of dimensions
+	DLong64GDL* dimA = e->GetParAs<DLong64GDL>( 0);
+	nDim = dimA->N_Elements();
+	if( nDim > MAXRANK)
+	  e->Throw( "Only " + i2s( MAXRANK) + " dimensions allowed.");
+	nTot = 1;
+	for( SizeT d=0; d<nDim; ++d)
+	  {
+	    if( (*dimA)[ d] < 1)
+	      e->Throw( "Array dimensions must be greater than 0.");
+	    dim[ d] = (*dimA)[ d];
+	    nTot *= dim[ d];
+	  }
+      }
+    else
+      {
+	nDim = p0->Rank();
+	for( SizeT d=0; d<nDim; ++d) dim[ d] = p0->Dim( d);
+	if( nDim == 0)
+	  {
+	    nDim = 1;
+	    dim[ 0] = 1;
+	  }
+	nTot = p0->N_Elements();
+      }
+
+    DLong64GDL* ix = e->GetParAs<DLong64GDL>( 1);
+    SizeT nIx = ix->N_Elements();
+    for( SizeT k=0; k<nIx; ++k)
+      if( (*ix)[ k] < 0 || (*ix)[ k] >= static_cast<DLong64>( nTot))
+	e->Throw( "Index out of range.");
+
+    // as the former array_indices.pro: LONARR(nDim, N_ELEMENTS(ix))
+    dimension resDim( nDim, nIx);
+    resDim.Purge();
+
+    // LONG64 for a 64 bit index or if LONG cannot hold the subscripts
+    if( ty == GDL_LONG64 || ty == GDL_ULONG64 ||
+	nTot > static_cast<SizeT>( std::numeric_limits<DLong>::max()))
+      {
+	DLong64GDL* res = new DLong64GDL( resDim, BaseGDL::NOZERO);
+	array_indices_kernel( ix, dim, nDim, &(*res)[ 0]);
+	return res;
+      }
+    DLongGDL* res = new DLongGDL( resDim, BaseGDL::NOZERO);
+    array_indices_kernel( ix, dim, nDim, &(*res)[ 0]);
+    return res;
+  }
+
   BaseGDL* replicate( EnvT* e)
   {
     SizeT nParam=e->NParam();
@@ -2004,7 +2119,6 @@ namespace lib {
     BaseGDL* p0 = e->GetPar( 0);
     if( p0 == NULL)
       e->Throw("Variable is undefined: " + e->GetParString(0));
-    DStringGDL* p0S = static_cast<DStringGDL*>(p0->Convert2(GDL_STRING,BaseGDL::COPY));
     
     DLong mode = 0;
     if( nParam == 2)
@@ -2030,72 +2144,22 @@ namespace lib {
 		      ")> is out of allowed range.");
 	  }
       }
+
+    // a temporary string argument is trimmed in place
+    DStringGDL* p0S;
+    if( p0->Type() == GDL_STRING && e->StealLocalPar( 0))
+      p0S = static_cast<DStringGDL*>( p0);
+    else
+      p0S = static_cast<DStringGDL*>(p0->Convert2(GDL_STRING,BaseGDL::COPY));
     
     SizeT nEl = p0S->N_Elements();
 
-    if( mode == 2) // both
-      {
-	TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if ((nEl*10) >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= (nEl*10)))
-	  {
-#pragma omp for
-	    for( OMPInt i=0; i<nEl; ++i)
-	      {
-		unsigned long first= (*p0S)[ i].find_first_not_of(" \t");
-//		if( first == (*p0S)[ i].npos)
-                if (first >= (*p0S)[i].length())
-		  {
-		    (*p0S)[ i] = "";
-		  }
-		else
-		  {
-		    unsigned long last = (*p0S)[ i].find_last_not_of(" \t");
-		    (*p0S)[ i] = (*p0S)[ i].substr(first,last-first+1);
-		  }
-	      }
-	  }
-      }
-    else if( mode == 1) // leading
-      {
-	TRACEOMP( __FILE__, __LINE__)
+    TRACEOMP( __FILE__, __LINE__)
 #pragma omp parallel if ((nEl*10) >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= (nEl*10)))
-	  {
-#pragma omp for
-	    for( OMPInt i=0; i<nEl; ++i)
-	      {
-		unsigned long first= (*p0S)[ i].find_first_not_of(" \t");
-//		if( first == (*p0S)[ i].npos)
-            if (first >= (*p0S)[i].length())
-		  {
-		    (*p0S)[ i] = "";
-		  }
-		else
-		  {
-		    (*p0S)[ i] = (*p0S)[ i].substr(first);
-		  }
-	      }
-	  }
-      }
-    else // trailing
       {
-	TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if ((nEl*10) >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= (nEl*10)))
-	  {
 #pragma omp for
-	    for( OMPInt i=0; i<nEl; ++i)
-	      {
-		unsigned long last = (*p0S)[ i].find_last_not_of(" \t");
-//		if( last == (*p0S)[ i].npos)
-            if (last >= (*p0S)[i].length())
-		  {
-		    (*p0S)[ i] = "";
-		  }
-		else
-		  {
-		    (*p0S)[ i] = (*p0S)[ i].substr(0,last+1);
-		  }
-	      }
-	  }
+	for( OMPInt i=0; i<nEl; ++i)
+	  StrTrimInplace( (*p0S)[ i], mode);
       }
     return p0S;
   }
@@ -2104,20 +2168,25 @@ namespace lib {
   {
     e->NParam( 1);
 
-    DStringGDL* p0S = e->GetParAs<DStringGDL>( 0);
+    BaseGDL* p0 = e->GetParDefined( 0);
 
     bool removeAll =  e->KeywordSet(0);
 
-    DStringGDL* res = new DStringGDL( p0S->Dim(), BaseGDL::NOZERO);
+    // a temporary string argument is compressed in place
+    DStringGDL* res;
+    if( p0->Type() == GDL_STRING && e->StealLocalPar( 0))
+      res = static_cast<DStringGDL*>( p0);
+    else
+      res = static_cast<DStringGDL*>( p0->Convert2( GDL_STRING, BaseGDL::COPY));
 
-    SizeT nEl = p0S->N_Elements();
+    SizeT nEl = res->N_Elements();
     TRACEOMP( __FILE__, __LINE__)
 #pragma omp parallel if ((nEl*10) >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= (nEl*10)))
       {
 #pragma omp for
 	for( OMPInt i=0; i<nEl; ++i)
 	  {
-	    (*res)[ i] = StrCompress((*p0S)[ i], removeAll);
+	    StrCompressInplace((*res)[ i], removeAll);
 	  }
       }
     return res;
@@ -2400,10 +2469,10 @@ namespace lib {
     DLongGDL* res = new DLongGDL( p0S->Dim(), BaseGDL::NOZERO);
 
     SizeT nEl = p0S->N_Elements();
-    // #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
     {
-      // #pragma omp for
-      for( SizeT i=0; i<nEl; ++i)
+#pragma omp for
+      for( OMPInt i=0; i<nEl; ++i)
 	{
 	  (*res)[ i] = (*p0S)[ i].length();
 	}
@@ -2534,10 +2603,10 @@ namespace lib {
   BaseGDL* total_cu_template( T* res, bool omitNaN) {
     SizeT nEl = res->N_Elements();
     if (omitNaN) {
-      // #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
       {
-        // #pragma omp for
-        for (SizeT i = 0; i < nEl; ++i)
+#pragma omp for
+        for (OMPInt i = 0; i < nEl; ++i)
           NaN2Zero((*res)[i]);
       }
     }
@@ -3570,6 +3639,114 @@ namespace lib {
     return new DByteGDL( result ? 1 : 0 );
   }
 
+  // MIN/MAX along DIMENSION for non-complex numeric types. Instead of one strided walk per
+  // result element, a block of up to MINMAX_DIM_CHUNK consecutive results is updated slice by
+  // slice along the searched dimension, every slice being contiguous in memory. Same choice
+  // as Data_::MinMax(): first occurrence; /NAN skips non-finite values (if all are, the
+  // subscript is 0, as Data_::MinMax() returns for an all-NaN slice).
+  const SizeT MINMAX_DIM_CHUNK = 1024;
+
+  template<typename T>
+  void minmax_over_dim_template(T* src, SizeT inner, SizeT nSearch, SizeT outer, bool omitNaN,
+    T* minRes, DLongGDL* minIx, T* maxRes, DLongGDL* maxIx)
+  {
+    typedef typename T::Ty Ty;
+    const Ty* p = &(*src)[0];
+    SizeT nChunk = (inner + MINMAX_DIM_CHUNK - 1) / MINMAX_DIM_CHUNK;
+    OMPInt nItems = outer * nChunk;
+    SizeT nEl = src->N_Elements();
+#pragma omp parallel for if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+    for (OMPInt it = 0; it < nItems; ++it) {
+      SizeT o = it / nChunk;
+      SizeT i0 = (it - o * nChunk) * MINMAX_DIM_CHUNK;
+      SizeT n = (inner - i0 < MINMAX_DIM_CHUNK) ? inner - i0 : MINMAX_DIM_CHUNK;
+      SizeT base = o * nSearch * inner + i0;
+      Ty mn[MINMAX_DIM_CHUNK], mx[MINMAX_DIM_CHUNK];
+      DLong imn[MINMAX_DIM_CHUNK], imx[MINMAX_DIM_CHUNK];
+      bool valid[MINMAX_DIM_CHUNK];
+      for (SizeT i = 0; i < n; ++i) {
+        mn[i] = mx[i] = p[base + i];
+        imn[i] = imx[i] = base + i;
+        valid[i] = !omitNaN || std::isfinite((double) p[base + i]);
+      }
+      for (SizeT k = 1; k < nSearch; ++k) {
+        SizeT off = base + k * inner;
+        const Ty* q = p + off;
+        if (omitNaN) {
+          for (SizeT i = 0; i < n; ++i) {
+            Ty x = q[i];
+            if (!std::isfinite((double) x)) continue;
+            if (!valid[i] || x < mn[i]) { mn[i] = x; imn[i] = off + i; }
+            if (!valid[i] || x > mx[i]) { mx[i] = x; imx[i] = off + i; }
+            valid[i] = true;
+          }
+        } else {
+          for (SizeT i = 0; i < n; ++i) {
+            Ty x = q[i];
+            bool lt = x < mn[i];
+            bool gt = x > mx[i];
+            mn[i] = lt ? x : mn[i];
+            imn[i] = lt ? (DLong) (off + i) : imn[i];
+            mx[i] = gt ? x : mx[i];
+            imx[i] = gt ? (DLong) (off + i) : imx[i];
+          }
+        }
+      }
+      if (omitNaN) for (SizeT i = 0; i < n; ++i) if (!valid[i]) imn[i] = imx[i] = 0;
+      SizeT r = o * inner + i0;
+      if (minRes != NULL) for (SizeT i = 0; i < n; ++i) (*minRes)[r + i] = mn[i];
+      if (minIx != NULL) for (SizeT i = 0; i < n; ++i) (*minIx)[r + i] = imn[i];
+      if (maxRes != NULL) for (SizeT i = 0; i < n; ++i) (*maxRes)[r + i] = mx[i];
+      if (maxIx != NULL) for (SizeT i = 0; i < n; ++i) (*maxIx)[r + i] = imx[i];
+    }
+  }
+
+  // returns false for types not handled by minmax_over_dim_template()
+  bool minmax_over_dim(BaseGDL* src, SizeT inner, SizeT nSearch, SizeT outer, bool omitNaN,
+    BaseGDL* minRes, DLongGDL* minIx, BaseGDL* maxRes, DLongGDL* maxIx)
+  {
+    switch (src->Type()) {
+    case GDL_BYTE:
+      minmax_over_dim_template(static_cast<DByteGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DByteGDL*> (minRes), minIx, static_cast<DByteGDL*> (maxRes), maxIx);
+      return true;
+    case GDL_INT:
+      minmax_over_dim_template(static_cast<DIntGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DIntGDL*> (minRes), minIx, static_cast<DIntGDL*> (maxRes), maxIx);
+      return true;
+    case GDL_UINT:
+      minmax_over_dim_template(static_cast<DUIntGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DUIntGDL*> (minRes), minIx, static_cast<DUIntGDL*> (maxRes), maxIx);
+      return true;
+    case GDL_LONG:
+      minmax_over_dim_template(static_cast<DLongGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DLongGDL*> (minRes), minIx, static_cast<DLongGDL*> (maxRes), maxIx);
+      return true;
+    case GDL_ULONG:
+      minmax_over_dim_template(static_cast<DULongGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DULongGDL*> (minRes), minIx, static_cast<DULongGDL*> (maxRes), maxIx);
+      return true;
+    case GDL_LONG64:
+      minmax_over_dim_template(static_cast<DLong64GDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DLong64GDL*> (minRes), minIx, static_cast<DLong64GDL*> (maxRes), maxIx);
+      return true;
+    case GDL_ULONG64:
+      minmax_over_dim_template(static_cast<DULong64GDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DULong64GDL*> (minRes), minIx, static_cast<DULong64GDL*> (maxRes), maxIx);
+      return true;
+    case GDL_FLOAT:
+      minmax_over_dim_template(static_cast<DFloatGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DFloatGDL*> (minRes), minIx, static_cast<DFloatGDL*> (maxRes), maxIx);
+      return true;
+    case GDL_DOUBLE:
+      minmax_over_dim_template(static_cast<DDoubleGDL*> (src), inner, nSearch, outer, omitNaN,
+        static_cast<DDoubleGDL*> (minRes), minIx, static_cast<DDoubleGDL*> (maxRes), maxIx);
+      return true;
+    default:
+      return false;
+    }
+  }
+
   BaseGDL* min_fun( EnvT* e) {
     SizeT nParam = e->NParam(1);
     BaseGDL* searchArr = e->GetParDefined(0);
@@ -3627,21 +3804,23 @@ namespace lib {
         minElArr = new DLongGDL(destDim);
       }
 
-      SizeT rIx = 0;
+      if (absSet || searchStride == 1 || !minmax_over_dim(searchArr, searchStride, nSearch, nEl / outerStride, omitNaN,
+        resArr, (nParam == 2 ? minElArr : NULL), (maxSet ? maxVal : NULL), (subMax ? maxElArr : NULL))) {
 #pragma omp parallel if ((nEl/outerStride)*searchStride >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= (nEl/outerStride)*searchStride))
-      {
+        {
 #pragma omp for
-        for (SizeT o = 0; o < nEl; o += outerStride) {
-          SizeT rIx = (o / outerStride) * searchStride;
-          for (SizeT i = 0; i < searchStride; ++i) {
-            searchArr->MinMax(
-              (nParam == 2 ? &((*minElArr)[rIx]) : NULL),
-              (subMax ? &((*maxElArr)[rIx]) : NULL),
-              &resArr,
-              (maxSet ? &maxVal : NULL),
-              omitNaN, o + i, searchLimit + o + i, searchStride, rIx, absSet
-              );
-            rIx++;
+          for (SizeT o = 0; o < nEl; o += outerStride) {
+            SizeT rIx = (o / outerStride) * searchStride;
+            for (SizeT i = 0; i < searchStride; ++i) {
+              searchArr->MinMax(
+                (nParam == 2 ? &((*minElArr)[rIx]) : NULL),
+                (subMax ? &((*maxElArr)[rIx]) : NULL),
+                &resArr,
+                (maxSet ? &maxVal : NULL),
+                omitNaN, o + i, searchLimit + o + i, searchStride, rIx, absSet
+                );
+              rIx++;
+            }
           }
         }
       }
@@ -3735,20 +3914,23 @@ namespace lib {
         maxElArr = new DLongGDL(destDim);
       }
 
+      if (absSet || searchStride == 1 || !minmax_over_dim(searchArr, searchStride, nSearch, nEl / outerStride, omitNaN,
+        (minSet ? minVal : NULL), (subMin ? minElArr : NULL), resArr, (nParam == 2 ? maxElArr : NULL))) {
 #pragma omp parallel if ((nEl/outerStride)*searchStride >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= (nEl/outerStride)*searchStride))
-      {
+        {
 #pragma omp for
-        for (SizeT o = 0; o < nEl; o += outerStride) {
-          SizeT rIx = (o/outerStride)*searchStride;
-          for (SizeT i = 0; i < searchStride; ++i) {
-            searchArr->MinMax(
-              (subMin ? &((*minElArr)[rIx]) : NULL),
-              (nParam == 2 ? &((*maxElArr)[rIx]) : NULL),
-              (minSet ? &minVal : NULL),
-              &resArr,
-              omitNaN, o + i, searchLimit + o + i, searchStride, rIx, absSet
-              );
-            rIx++;
+          for (SizeT o = 0; o < nEl; o += outerStride) {
+            SizeT rIx = (o/outerStride)*searchStride;
+            for (SizeT i = 0; i < searchStride; ++i) {
+              searchArr->MinMax(
+                (subMin ? &((*minElArr)[rIx]) : NULL),
+                (nParam == 2 ? &((*maxElArr)[rIx]) : NULL),
+                (minSet ? &minVal : NULL),
+                &resArr,
+                omitNaN, o + i, searchLimit + o + i, searchStride, rIx, absSet
+                );
+              rIx++;
+            }
           }
         }
       }
@@ -3821,9 +4003,20 @@ namespace lib {
 	    if (j == rank)
 	      e->Throw( "Incorrect permutation vector.");
 	  }
+	if( rank == 2 && perm[0] == 1 && p0->Dim(0) == p0->Dim(1) && e->StealLocalPar( 0))
+	  {
+	    p0->TransposeInPlace();
+	    return p0;
+	  }
 	return p0->Transpose( perm);
       }
 
+    // square matrix passed as a temporary (e.g. TEMPORARY(a)): no copy needed
+    if( rank == 2 && p0->Dim(0) == p0->Dim(1) && e->StealLocalPar( 0))
+      {
+	p0->TransposeInPlace();
+	return p0;
+      }
     return p0->Transpose( NULL);
   }
 
@@ -6842,52 +7035,90 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
     return dRes->Convert2(GDL_BYTE);
   } 
   
-  BaseGDL* strtok_fun(EnvT* e) {
-    SizeT nParam = e->NParam(1);
-
-    DString stringIn;
-    e->AssureStringScalarPar(0, stringIn);
-
-    DString pattern = " \t";
-    if (nParam > 1) {
-      e->AssureStringScalarPar(1, pattern);
-    }
-
-    static int extractIx = e->KeywordIx( "EXTRACT");
-    bool extract = e->KeywordSet( extractIx);
-
-    static int countIx = e->KeywordIx( "COUNT");
-    bool countPresent = e->KeywordPresent( countIx);
-     
-    static int lengthIx = e->KeywordIx( "LENGTH");
-    bool lengthPresent = e->KeywordPresent( lengthIx);
+  // compiled regular expressions, most recently used first. Shared by
+  // STREGEX, STRTOK/STRSPLIT(/REGEX) and STRMATCH, so that calling them in
+  // a loop with the same pattern does not recompile it every time.
+  // An entry holds one copy per thread: glibc's regexec() locks the
+  // regex_t, so concurrent matching needs independent copies.
+  struct RegexCacheEntry
+  {
+    DString pattern;
+    int cflags;
+    vector<regex_t*> copies;
+  };
+  static std::list<RegexCacheEntry> regexCache;
+  static const SizeT regexCacheSize = 32;
 
-    static int pre0Ix = e->KeywordIx("PRESERVE_NULL");
-    bool pre0 = e->KeywordSet(pre0Ix);
+  static void FreeRegexCopies( vector<regex_t*>& copies)
+  {
+    for( SizeT i = 0; i < copies.size(); ++i)
+      {
+	regfree( copies[ i]);
+	delete copies[ i];
+      }
+    copies.clear();
+  }
 
-    static int regexIx = e->KeywordIx("REGEX");
-    bool regex = e->KeywordSet(regexIx);
-    char err_msg[MAX_REGEXPERR_LENGTH];
-    regex_t regexp;
+  // at least nCopies compiled copies of pattern, valid until the next call
+  static const vector<regex_t*>& CachedRegex( EnvT* e, const DString& pattern,
+					      int cflags, SizeT nCopies = 1)
+  {
+    std::list<RegexCacheEntry>::iterator it = regexCache.begin();
+    for( ; it != regexCache.end(); ++it)
+      if( it->cflags == cflags && it->pattern == pattern) break;
 
-    static int foldCaseIx = e->KeywordIx( "FOLD_CASE" );
-    bool foldCaseKW = e->KeywordSet( foldCaseIx );
-    //FOLD_CASE can only be specified if the REGEX keyword is set
-    if (!regex && foldCaseKW)   e->Throw("Conflicting keywords.");
+    if( it == regexCache.end())
+      {
+	if( regexCache.size() >= regexCacheSize)
+	  {
+	    FreeRegexCopies( regexCache.back().copies);
+	    regexCache.pop_back();
+	  }
+	regexCache.push_front( RegexCacheEntry());
+	regexCache.front().pattern = pattern;
+	regexCache.front().cflags = cflags;
+      }
+    else if( it != regexCache.begin())
+      regexCache.splice( regexCache.begin(), regexCache, it);
 
-    vector<long> tokenStart;
-    vector<long> tokenLen;
+    RegexCacheEntry& entry = regexCache.front();
+    while( entry.copies.size() < nCopies)
+      {
+	regex_t* regexp = new regex_t;
+	int compRes = regcomp( regexp, pattern.c_str(), cflags);
+	if( compRes)
+	  {
+	    char err_msg[MAX_REGEXPERR_LENGTH];
+	    regerror( compRes, regexp, err_msg, MAX_REGEXPERR_LENGTH);
+	    delete regexp;
+	    if( entry.copies.empty()) regexCache.pop_front();
+	    e->Throw( "Error processing regular expression: " +
+		      pattern + "\n           " + string( err_msg) + ".");
+	  }
+	entry.copies.push_back( regexp);
+      }
+    return entry.copies;
+  }
 
-    int strLen = stringIn.length();
+  // number of threads for a loop over nEl strings
+  static inline int StringLoopThreads( SizeT nEl)
+  {
+    if( nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl) && CpuTPOOL_NTHREADS > 1)
+      return CpuTPOOL_NTHREADS;
+    return 1;
+  }
 
-    DString escape = "";
-    static int ESCAPEIx=e->KeywordIx("ESCAPE");
-    
-    //ESCAPE cannot be specified with the FOLD_CASE or REGEX keywords.
-    if (regex && e->KeywordPresent(ESCAPEIx))   e->Throw("Conflicting keywords.");
-    if (foldCaseKW && e->KeywordPresent(ESCAPEIx))   e->Throw("Conflicting keywords.");
+  // STRTOK tokens of stringIn: separated by any character of pattern, or
+  // by the matches of regexp if not NULL. Characters following one of
+  // escape are not separators.
+  static void StrTokens( const DString& stringIn, const DString& pattern,
+			 const regex_t* regexp, const DString& escape, bool pre0,
+			 vector<long>& tokenStart, vector<long>& tokenLen)
+  {
+    tokenStart.clear();
+    tokenLen.clear();
+    if( pattern.size() == 0) return;
 
-    e->AssureStringScalarKWIfPresent(ESCAPEIx, escape);
     vector<long> escList;
     long pos = 0;
     while (pos != string::npos) {
@@ -6900,46 +7131,16 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
     vector<long>::iterator escBeg = escList.begin();
     vector<long>::iterator escEnd = escList.end();
 
+    bool regex = (regexp != NULL);
+    int strLen = stringIn.length();
     long tokB = 0;
     long tokE;
     long nextE = 0;
     long actLen;
-    //special case: pattern void string
-    if (pattern.size()==0) {
-      if (lengthPresent) {
-        e->AssureGlobalKW(lengthIx);
-        e->SetKW(lengthIx, new DLongGDL(0));
-      }
-     if (countPresent) {
-        e->AssureGlobalKW(countIx);
-        e->SetKW(countIx, new DLongGDL(0));
-      }   
-      if (!extract) return new DLongGDL(0); else return new DStringGDL("");
-    }
-      
-    // If regex then compile regex. 
-    // set the compile flags to use the REG_ICASE facility in case /FOLD_CASE is given.
-    int cflags = REG_EXTENDED;
-    if (foldCaseKW)
-      cflags |= REG_ICASE;
-
-    if (regex) {
-      if (pattern == " \t") pattern = " "; // regcomp doesn't like "\t" JMG
-      int compRes = regcomp(&regexp, pattern.c_str(), cflags);
-      if (compRes) {
-        regerror(compRes, &regexp, err_msg, MAX_REGEXPERR_LENGTH);
-        e->Throw("Error processing regular expression: " +
-		 pattern + "\n           " + string(err_msg) + ".");
-      }
-    }
-
-    if (foldCaseKW && !regex) { //duplicate pattern with ascii chars upcased
-      pattern=pattern+StrUpCase(pattern);
-    }
     for (;;) {
       regmatch_t pmatch[1];
       if (regex) {
-        int matchres = regexec(&regexp, stringIn.c_str() + nextE, 1, pmatch, 0);
+        int matchres = regexec(regexp, stringIn.c_str() + nextE, 1, pmatch, 0);
         tokE = matchres ? -1 : pmatch[0].rm_so;
       } else {
         tokE = stringIn.find_first_of(pattern, nextE);
@@ -6967,35 +7168,14 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
       if (regex) nextE += pmatch[0].rm_eo;
       else nextE = tokE + 1;
     } // for(;;)
+  }
 
-    if (regex) regfree(&regexp);
-
+  // STRTOK result for one string: token positions, or the tokens with
+  // the escape characters removed (EXTRACT)
+  static BaseGDL* StrTokResult( const DString& stringIn, const vector<long>& tokenStart,
+				const vector<long>& tokenLen, bool extract, const DString& escape)
+  {
     SizeT nTok = tokenStart.size();
-    if (countPresent) {
-        e->AssureGlobalKW(countIx);
-         if (nTok > 0) {
-          DLongGDL* count = new DLongGDL(nTok);
-          e->SetKW(countIx, count);
-        } else {
-          e->SetKW(countIx, new DLongGDL(0));
-        }
-      }
-     
-      if (lengthPresent) {
-        e->AssureGlobalKW(lengthIx);
-
-        if (nTok > 0) {
-          dimension dim(nTok);
-          DLongGDL* len = new DLongGDL(dim);
-          for (int i = 0; i < nTok; i++)
-            (*len)[i] = tokenLen[i];
-
-          e->SetKW(lengthIx, len);
-        } else {
-          e->SetKW(lengthIx, new DLongGDL(0));
-        }
-      }
-    
     if (!extract) {
 
       if (nTok == 0) return new DLongGDL(0);
@@ -7005,7 +7185,7 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
       for (int i = 0; i < nTok; i++)
         (*d)[i] = tokenStart[i];
       return d;
-    } else {
+    }
 
     // EXTRACT
     if (nTok == 0) return new DStringGDL("");
@@ -7024,7 +7204,243 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
       }
     }
     return d;
+  }
+
+  static DLongGDL* StrTokLengths( const vector<long>& tokenLen)
+  {
+    SizeT nTok = tokenLen.size();
+    if (nTok == 0) return new DLongGDL(0);
+    DLongGDL* len = new DLongGDL(dimension(nTok));
+    for (int i = 0; i < nTok; i++)
+      (*len)[i] = tokenLen[i];
+    return len;
+  }
+
+  // STRTOK pattern and regex compile flags from the keywords
+  static void StrTokPattern( EnvT* e, bool regex, bool foldCaseKW, DString& pattern, int& cflags)
+  {
+    // set the compile flags to use the REG_ICASE facility in case /FOLD_CASE is given.
+    cflags = REG_EXTENDED;
+    if (foldCaseKW)
+      cflags |= REG_ICASE;
+
+    if (regex) {
+      if (pattern == " \t") pattern = " "; // regcomp doesn't like "\t" JMG
+    }
+
+    if (foldCaseKW && !regex) { //duplicate pattern with ascii chars upcased
+      pattern=pattern+StrUpCase(pattern);
+    }
+  }
+
+  BaseGDL* strtok_fun(EnvT* e) {
+    SizeT nParam = e->NParam(1);
+
+    DString stringIn;
+    e->AssureStringScalarPar(0, stringIn);
+
+    DString pattern = " \t";
+    if (nParam > 1) {
+      e->AssureStringScalarPar(1, pattern);
+    }
+
+    static int extractIx = e->KeywordIx( "EXTRACT");
+    bool extract = e->KeywordSet( extractIx);
+
+    static int countIx = e->KeywordIx( "COUNT");
+    bool countPresent = e->KeywordPresent( countIx);
+     
+    static int lengthIx = e->KeywordIx( "LENGTH");
+    bool lengthPresent = e->KeywordPresent( lengthIx);
+
+    static int pre0Ix = e->KeywordIx("PRESERVE_NULL");
+    bool pre0 = e->KeywordSet(pre0Ix);
+
+    static int regexIx = e->KeywordIx("REGEX");
+    bool regex = e->KeywordSet(regexIx);
+
+    static int foldCaseIx = e->KeywordIx( "FOLD_CASE" );
+    bool foldCaseKW = e->KeywordSet( foldCaseIx );
+    //FOLD_CASE can only be specified if the REGEX keyword is set
+    if (!regex && foldCaseKW)   e->Throw("Conflicting keywords.");
+
+    DString escape = "";
+    static int ESCAPEIx=e->KeywordIx("ESCAPE");
+    
+    //ESCAPE cannot be specified with the FOLD_CASE or REGEX keywords.
+    if (regex && e->KeywordPresent(ESCAPEIx))   e->Throw("Conflicting keywords.");
+    if (foldCaseKW && e->KeywordPresent(ESCAPEIx))   e->Throw("Conflicting keywords.");
+
+    e->AssureStringScalarKWIfPresent(ESCAPEIx, escape);
+
+    vector<long> tokenStart;
+    vector<long> tokenLen;
+
+    //special case: pattern void string: no tokens
+    const regex_t* regexp = NULL;
+    if (pattern.size() > 0) {
+      int cflags;
+      StrTokPattern( e, regex, foldCaseKW, pattern, cflags);
+      if (regex) regexp = CachedRegex( e, pattern, cflags)[ 0];
+    }
+
+    StrTokens( stringIn, pattern, regexp, escape, pre0, tokenStart, tokenLen);
+
+    SizeT nTok = tokenStart.size();
+    if (countPresent) {
+      e->AssureGlobalKW(countIx);
+      e->SetKW(countIx, new DLongGDL(nTok));
     }
+     
+    if (lengthPresent) {
+      e->AssureGlobalKW(lengthIx);
+      e->SetKW(lengthIx, StrTokLengths( tokenLen));
+    }
+    
+    return StrTokResult( stringIn, tokenStart, tokenLen, extract, escape);
+  }
+
+  // STRSPLIT: STRTOK for a scalar, a LIST of the STRTOK results for an
+  // array (COUNT is then an array, LENGTH a LIST)
+  BaseGDL* strsplit_fun(EnvT* e) {
+    SizeT nParam = e->NParam(1);
+
+    BaseGDL* p0 = e->GetParDefined(0);
+    SizeT nStr = p0->N_Elements();
+    if (nStr <= 1) return strtok_fun(e); // same keywords
+
+    DStringGDL* strIn = e->GetParAs<DStringGDL>(0);
+    DStringGDL* patIn = NULL;
+    SizeT nPat = 1;
+    if (nParam > 1) {
+      patIn = e->GetParAs<DStringGDL>(1);
+      nPat = patIn->N_Elements();
+      if (nPat != 1 && nPat != nStr)
+        e->Throw("PATTERN must be a scalar or have the same number of elements as STRING.");
+    }
+
+    static int extractIx = e->KeywordIx( "EXTRACT");
+    bool extract = e->KeywordSet( extractIx);
+    static int countIx = e->KeywordIx( "COUNT");
+    bool countPresent = e->KeywordPresent( countIx);
+    static int lengthIx = e->KeywordIx( "LENGTH");
+    bool lengthPresent = e->KeywordPresent( lengthIx);
+    static int pre0Ix = e->KeywordIx("PRESERVE_NULL");
+    bool pre0 = e->KeywordSet(pre0Ix);
+    static int regexIx = e->KeywordIx("REGEX");
+    bool regex = e->KeywordSet(regexIx);
+    static int foldCaseIx = e->KeywordIx( "FOLD_CASE" );
+    bool foldCaseKW = e->KeywordSet( foldCaseIx );
+    if (!regex && foldCaseKW)   e->Throw("Conflicting keywords.");
+    DString escape = "";
+    static int ESCAPEIx=e->KeywordIx("ESCAPE");
+    if (regex && e->KeywordPresent(ESCAPEIx))   e->Throw("Conflicting keywords.");
+    if (foldCaseKW && e->KeywordPresent(ESCAPEIx))   e->Throw("Conflicting keywords.");
+    e->AssureStringScalarKWIfPresent(ESCAPEIx, escape);
+
+    vector< vector<long> > tokenStart( nStr);
+    vector< vector<long> > tokenLen( nStr);
+
+    if (nPat == 1) {
+      // one pattern: tokenize in parallel, one regex copy per thread
+      DString pattern = (patIn != NULL) ? (*patIn)[0] : DString(" \t");
+      int nThreads = StringLoopThreads( nStr);
+      const vector<regex_t*>* regexps = NULL;
+      if (pattern.size() > 0) {
+        int cflags;
+        StrTokPattern( e, regex, foldCaseKW, pattern, cflags);
+        if (regex) regexps = &CachedRegex( e, pattern, cflags, nThreads);
+      }
+#pragma omp parallel for num_threads(nThreads)
+      for (OMPInt i = 0; i < nStr; ++i)
+        StrTokens( (*strIn)[i], pattern,
+                   (regexps != NULL) ? (*regexps)[ currentThreadNumber()] : NULL,
+                   escape, pre0, tokenStart[i], tokenLen[i]);
+    } else {
+      for (SizeT i = 0; i < nStr; ++i) {
+        DString pattern = (*patIn)[i];
+        const regex_t* regexp = NULL;
+        if (pattern.size() > 0) {
+          int cflags;
+          StrTokPattern( e, regex, foldCaseKW, pattern, cflags);
+          if (regex) regexp = CachedRegex( e, pattern, cflags)[ 0];
+        }
+        StrTokens( (*strIn)[i], pattern, regexp, escape, pre0, tokenStart[i], tokenLen[i]);
+      }
+    }
+
+    vector<BaseGDL*> items( nStr);
+    for (SizeT i = 0; i < nStr; ++i)
+      items[i] = StrTokResult( (*strIn)[i], tokenStart[i], tokenLen[i], extract, escape);
+    BaseGDL* res = LIST_NewFromData( e, items);
+    Guard<BaseGDL> resGuard( res);
+
+    if (countPresent) {
+      DLongGDL* count = new DLongGDL( dimension( nStr), BaseGDL::NOZERO);
+      for (SizeT i = 0; i < nStr; ++i) (*count)[i] = tokenStart[i].size();
+      e->AssureGlobalKW(countIx);
+      e->SetKW(countIx, count);
+    }
+    if (lengthPresent) {
+      vector<BaseGDL*> lengths( nStr);
+      for (SizeT i = 0; i < nStr; ++i) lengths[i] = StrTokLengths( tokenLen[i]);
+      BaseGDL* lengthList = LIST_NewFromData( e, lengths);
+      e->AssureGlobalKW(lengthIx);
+      e->SetKW(lengthIx, lengthList);
+    }
+    return resGuard.release();
+  }
+
+  // STRMATCH wildcards (*, ?, [...], [!...], \ escapes) as a POSIX
+  // regular expression matching the whole string
+  static DString WildcardToRegex( const DString& wild)
+  {
+    DString re = "^";
+    for (SizeT i = 0; i < wild.size(); ++i) {
+      char c = wild[i];
+      bool escaped = (i > 0 && wild[i-1] == '\\');
+      if (!escaped) {
+        switch (c) {
+        case '.': case '(': case ')': case '+': case '{': case '}':
+        case '|': case '^': case '$':
+          re += '\\'; re += c; continue;
+        case '*': re += ".*"; continue;
+        case '?': re += '.'; continue;
+        case '[':
+          if (i+1 < wild.size() && wild[i+1] == '!') { re += "[^"; ++i; continue;}
+          break;
+        default: break;
+        }
+      }
+      re += c;
+    }
+    re += '$';
+    return re;
+  }
+
+  BaseGDL* strmatch_fun( EnvT* e)
+  {
+    e->NParam( 2);
+    DStringGDL* stringExpr = e->GetParAs<DStringGDL>(0);
+    if (e->GetParDefined(1)->Rank() != 0)
+      e->Throw( "second argument must be a scalar string");
+    DString wild;
+    e->AssureStringScalarPar(1, wild);
+
+    static int foldCaseIx = e->KeywordIx( "FOLD_CASE" );
+    int cflags = REG_EXTENDED | REG_NOSUB;
+    if (e->KeywordSet( foldCaseIx))
+      cflags |= REG_ICASE;
+
+    SizeT nEl = stringExpr->N_Elements();
+    int nThreads = StringLoopThreads( nEl);
+    const vector<regex_t*>& regexps = CachedRegex( e, WildcardToRegex( wild), cflags, nThreads);
+
+    DByteGDL* res = new DByteGDL( stringExpr->Dim(), BaseGDL::NOZERO);
+#pragma omp parallel for num_threads(nThreads)
+    for (OMPInt i = 0; i < nEl; ++i)
+      (*res)[i] = (regexec( regexps[ currentThreadNumber()], (*stringExpr)[i].c_str(), 0, NULL, 0) == 0);
+    return res;
   }
 
   BaseGDL* getenv_fun( EnvT* e)
@@ -7167,8 +7583,6 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
     if( booleanKW && (subexprKW || extractKW || lengthKW))
       e->Throw( "Conflicting keywords.");
   
-    char err_msg[MAX_REGEXPERR_LENGTH];
-
     // set the compile flags 
     int cflags = REG_EXTENDED;
     if (foldCaseKW)
@@ -7176,18 +7590,10 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
     if (booleanKW)
       cflags |= REG_NOSUB;
 
-    // compile the regular expression
-    regex_t regexp;
-    int compRes = regcomp( &regexp, pattern.c_str(), cflags);
-    SizeT nSubExpr = regexp.re_nsub + 1;
-    
-    //    cout << regexp.re_nsub << endl;
-
-    if (compRes) {
-      regerror(compRes, &regexp, err_msg, MAX_REGEXPERR_LENGTH);
-      e->Throw( "Error processing regular expression: "+
-		pattern+"\n           "+string(err_msg)+".");
-    }
+    // compiled regular expression, one copy per thread
+    int nThreads = StringLoopThreads( dim.NDimElements());
+    const vector<regex_t*>& regexps = CachedRegex( e, pattern, cflags, nThreads);
+    SizeT nSubExpr = regexps[ 0]->re_nsub + 1;
 
     BaseGDL* result;
 
@@ -7231,19 +7637,23 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
     int nmatch = 1;
     if( subexprKW) nmatch = nSubExpr;
 
-    regmatch_t* pmatch = new regmatch_t[nSubExpr];
-    ArrayGuard<regmatch_t> pmatchGuard( pmatch);
+    // one match array per thread
+    regmatch_t* pmatchAll = new regmatch_t[nSubExpr * nThreads];
+    ArrayGuard<regmatch_t> pmatchGuard( pmatchAll);
 
     //    cout << "dim " << dim.NDimElements() << endl;	    
-    for( SizeT s=0; s<dim.NDimElements(); ++s)
+#pragma omp parallel for num_threads(nThreads)
+    for( OMPInt s=0; s<dim.NDimElements(); ++s)
       {
 	int eflags = 0; 
+	regmatch_t* pmatch = pmatchAll + nSubExpr * currentThreadNumber();
+	const regex_t* regexp = regexps[ currentThreadNumber()];
 
 	for( SizeT sE=0; sE<nSubExpr; ++sE)
 	  pmatch[sE].rm_so = -1;
 
 	// now match towards the string
-	int matchres = regexec( &regexp, (*stringExpr)[s].c_str(),  nmatch, pmatch, eflags);
+	int matchres = regexec( regexp, (*stringExpr)[s].c_str(),  nmatch, pmatch, eflags);
 
 	// subexpressions
 	if ( extractKW && subexprKW) {
@@ -7291,8 +7701,6 @@ template <typename Ty, typename T2>  static inline Ty do_mean_cpx_nan(const Ty*
 
       }
 
-    regfree( &regexp);
-
     if( lengthKW)
       e->SetKW( lengthIx, len);    
 
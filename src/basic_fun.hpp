@@ -90,6 +90,7 @@ namespace lib {
   BaseGDL* gdl_logical_or( EnvT* e);
   BaseGDL* logical_true( BaseGDL* p0, bool isReference);//( EnvT* e);
 
+  BaseGDL* array_indices( EnvT* e);
   BaseGDL* replicate( EnvT* e);
 
   BaseGDL* strcompress( EnvT* e);
@@ -153,7 +154,9 @@ namespace lib {
 
   // the following by Peter Messmer 
   // (messmer@users.sourceforge.net)
-  BaseGDL* strtok_fun( EnvT* e); // strsplit
+  BaseGDL* strtok_fun( EnvT* e);
+  BaseGDL* strsplit_fun( EnvT* e);
+  BaseGDL* strmatch_fun( EnvT* e);
   BaseGDL* getenv_fun( EnvT* e);
   BaseGDL* tag_names_fun( EnvT* e);
   BaseGDL* stregex_fun( EnvT* e);
@@ -232,6 +232,7 @@ namespace lib {
 #endif
 
     sem_onexit();
+    shm_onexit();
 
     BaseGDL* status = e->GetKW(1);
     if (status == NULL) exit(EXIT_SUCCESS);
@@ -601,6 +602,15 @@ namespace lib {
       fileUnits[lun - 1].Open(name, mode, swapEndian, deleteKey,
         xdr, width, f77, compress);
 
+      // READ_AHEAD=block size in bytes, /READ_AHEAD for 1 MB blocks
+      static int readAheadIx = e->KeywordIx("READ_AHEAD");
+      if (e->KeywordPresent(readAheadIx)) {
+        DLong64 blockSize;
+        e->AssureLongScalarKW(readAheadIx, blockSize);
+        if (blockSize == 1) blockSize = 1 << 20;
+        if (blockSize > 0) fileUnits[lun - 1].ReadAhead(blockSize);
+      }
+
       if (getlunIsSet) {
         BaseGDL** retLun = &e->GetPar(0);
         GDLDelete((*retLun));
@@ -967,6 +977,8 @@ namespace lib {
       }
     }
 
+    if (!stdLun && sockNum == -1) fileUnits[lun - 1].Prefetch();
+
     BaseGDL* p = e->GetParDefined(nParam - 1);
     SizeT cc = p->Dim(0);
     BaseGDL** tcKW = NULL;
@@ -1130,6 +1142,8 @@ namespace lib {
         }
       }
 
+    if (!stdLun && sockNum == -1) fileUnits[lun - 1].Prefetch();
+
     BaseGDL* p = e->GetParDefined(nParam - 1);
     SizeT cc = p->Dim(0);
     BaseGDL** tcKW = NULL;
@@ -25,6 +25,7 @@
 #include "dstructgdl.hpp"
 #include "real2int.hpp"
 #include "ofmt.hpp" // OutAuto
+#include "num2str.hpp"
 
 #include "dinterpreter.hpp"
 
@@ -40,17 +41,13 @@ using namespace std;
 // for double -> string
 inline string double2string( const DDouble d)      
 {
-  std::ostringstream os;
-  OutAuto( os, d, 16, 8, 0);
-  return os.str();
+  return Auto2String( d, 16, 8);
 }
 
 // for float -> string
 inline string float2string( const DFloat f)      
 {
-  std::ostringstream os;
-  OutAuto( os, f, 13, 6, 0);
-  return os.str();
+  return Auto2String( f, 13, 6);
 }
 
 // for string -> float/double
@@ -90,6 +87,75 @@ inline real_t string2real(const char* cStart, char** cEnd)
   }
 }
 
+// element-wise numeric conversion
+// ConvertOp holds the per-element rule, the default being a plain cast
+// (IDL does not saturate, see real2int.hpp)
+template <typename DestT, typename SrcT>
+struct ConvertOp
+{
+  static inline DestT Do( const SrcT s) { return static_cast<DestT>( s);}
+};
+// float -> byte goes through LONG (IDL: BYTE(-1.0) is 255b)
+template <>
+struct ConvertOp<DByte, DFloat>
+{
+  static inline DByte Do( const DFloat s) { return Real2DByte<float>( s);}
+};
+template <>
+struct ConvertOp<DByte, DDouble>
+{
+  static inline DByte Do( const DDouble s) { return Real2DByte<double>( s);}
+};
+// complex -> real types: the real part
+template <typename DestT, typename T>
+struct ConvertOp<DestT, std::complex<T> >
+{
+  static inline DestT Do( const std::complex<T>& s)
+  { return ConvertOp<DestT, T>::Do( s.real());}
+};
+template <>
+struct ConvertOp<DComplex, DComplexDbl>
+{
+  static inline DComplex Do( const DComplexDbl& s)
+  { return DComplex( static_cast<float>( s.real()), static_cast<float>( s.imag()));}
+};
+template <>
+struct ConvertOp<DComplexDbl, DComplex>
+{
+  static inline DComplexDbl Do( const DComplex& s)
+  { return DComplexDbl( s.real(), s.imag());}
+};
+
+// the loop runs over raw buffers in chunks, simple enough for the
+// compiler to vectorize each chunk; chunks are spread over the threads
+const SizeT CONVERT_CHUNK = 16384;
+
+template <typename DestT, typename SrcT>
+inline void ConvertChunk( DestT* d, const SrcT* s, const SizeT n)
+{
+  for( SizeT i=0; i < n; ++i)
+    d[i] = ConvertOp<DestT, SrcT>::Do( s[i]);
+}
+
+template <typename DestT, typename SrcT>
+void ConvertArray( DestT* d, const SrcT* s, const SizeT nEl)
+{
+  if( nEl <= CONVERT_CHUNK)
+    {
+      ConvertChunk( d, s, nEl);
+      return;
+    }
+  OMPInt nChunk = (nEl + CONVERT_CHUNK - 1) / CONVERT_CHUNK;
+TRACEOMP( __FILE__, __LINE__)
+#pragma omp parallel for if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+  for( OMPInt c=0; c < nChunk; ++c)
+    {
+      SizeT start = c * CONVERT_CHUNK;
+      SizeT n = (start + CONVERT_CHUNK > nEl) ? nEl - start : CONVERT_CHUNK;
+      ConvertChunk( d + start, s + start, n);
+    }
+}
+
 // every type need this function which defines its conversion to all other types
 // so for every new type each of this functions has to be extended
 // and a new function has to be 'specialized'
@@ -139,12 +205,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDInt>* dest=new Data_<SpDInt>( dim, BaseGDL::NOZERO);
       	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -152,12 +213,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDUInt>* dest=new Data_<SpDUInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -165,12 +221,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDLong>* dest=new Data_<SpDLong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -178,12 +229,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDULong>* dest=new Data_<SpDULong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -191,12 +237,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDLong64>* dest=new Data_<SpDLong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -204,12 +245,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDULong64>* dest=new Data_<SpDULong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -217,12 +253,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -230,12 +261,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -243,12 +269,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -257,12 +278,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -276,7 +292,7 @@ template<> BaseGDL* Data_<SpDByte>::Convert2( DType destTy, BaseGDL::Convert2Mod
 // {
 // #pragma omp for
 	    for( SizeT i=0; i < nEl; ++i)
-	      (*dest)[i]=i2s(static_cast<int>((*this)[i]),4);
+	      (*dest)[i]=Int2String(static_cast<int>((*this)[i]),4);
 // }
 	    if( (mode & BaseGDL::CONVERT) != 0) delete this;
 	    return dest;
@@ -330,12 +346,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDByte>* dest=new Data_<SpDByte>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -344,12 +355,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDUInt>* dest=new Data_<SpDUInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -362,12 +368,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong>* dest=new Data_<SpDLong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast<DLong>((*this)[i]);
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -375,12 +376,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong>* dest=new Data_<SpDULong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -388,13 +384,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong64>* dest=new Data_<SpDLong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-//       	  (*dest)[i]=static_cast<DLong64>((*this)[i]);
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -402,12 +392,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong64>* dest=new Data_<SpDULong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -415,12 +400,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -428,12 +408,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -445,7 +420,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=i2s((*this)[i],8);
+      	  (*dest)[i]=Int2String((*this)[i],8);
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -454,12 +429,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -468,12 +438,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -503,12 +468,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDByte>* dest=new Data_<SpDByte>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -516,12 +476,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDInt>* dest=new Data_<SpDInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -534,12 +489,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong>* dest=new Data_<SpDLong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -547,12 +497,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong>* dest=new Data_<SpDULong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -560,12 +505,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong64>* dest=new Data_<SpDLong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -573,12 +513,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong64>* dest=new Data_<SpDULong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -586,12 +521,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -599,12 +529,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -616,7 +541,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=i2s((*this)[i],8);
+      	  (*dest)[i]=Int2String((*this)[i],8);
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -625,12 +550,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -639,12 +559,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -677,12 +592,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDByte>* dest=new Data_<SpDByte>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -690,12 +600,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDInt>* dest=new Data_<SpDInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -703,12 +608,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDUInt>* dest=new Data_<SpDUInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -717,12 +617,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong>* dest=new Data_<SpDULong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -734,12 +629,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong64>* dest=new Data_<SpDLong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -747,12 +637,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong64>* dest=new Data_<SpDULong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -760,12 +645,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -773,12 +653,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -790,7 +665,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=i2s((*this)[i],12);
+      	  (*dest)[i]=Int2String((*this)[i],12);
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -799,12 +674,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -813,12 +683,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -851,12 +716,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDByte>* dest=new Data_<SpDByte>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -864,12 +724,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDInt>* dest=new Data_<SpDInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -877,12 +732,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDUInt>* dest=new Data_<SpDUInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -890,12 +740,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong>* dest=new Data_<SpDLong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -908,12 +753,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong64>* dest=new Data_<SpDLong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -921,12 +761,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong64>* dest=new Data_<SpDULong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -934,12 +769,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -947,12 +777,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -964,7 +789,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=i2s((*this)[i],12);
+      	  (*dest)[i]=Int2String((*this)[i],12);
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -973,12 +798,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -987,12 +807,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-//   #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-    	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1031,13 +846,7 @@ TRACE_CONVERT2
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-	  (*dest)[i]=Real2DByte<float>((*this)[i]); 
-}	//(*dest)[i]=Real2DByte((*this)[i]); 
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1052,13 +861,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DInt,float>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1073,12 +876,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]= static_cast< DUInt>( ((*this)[i]));//Real2Int<DUInt,float>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1093,13 +891,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong,float>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1115,12 +907,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong>( ((*this)[i]));//Real2Int<DULong,float>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1136,13 +923,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong64,float>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1158,12 +939,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong64>( ((*this)[i]));//Real2Int<DULong64,float>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1172,12 +948,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1198,12 +969,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-    	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1212,12 +978,8 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}	if( (mode & BaseGDL::CONVERT) != 0) delete this;
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
+	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
     case GDL_PTR:
@@ -1257,14 +1019,7 @@ TRACE_CONVERT2
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-	  (*dest)[i]=Real2DByte<double>((*this)[i]); 
-	  //(*dest)[i]=Double2DByte((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1280,13 +1035,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DInt,double>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1302,12 +1051,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DUInt>((*this)[i]);//Real2Int<DUInt,double>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1323,13 +1067,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong,double>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1345,12 +1083,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong>((*this)[i]);//Real2Int<DULong,double>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1366,13 +1099,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong64,double>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1388,12 +1115,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong64>((*this)[i]);//Real2Int<DULong64,double>((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1401,12 +1123,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1428,12 +1145,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1442,12 +1154,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) 
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1846,13 +1553,7 @@ TRACE_CONVERT2
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2DByte<float>(real((*this)[i])); 
-}	//(*dest)[i]=Real2DByte(real((*this)[i])); 
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1868,13 +1569,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-    	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DInt,float>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1890,12 +1585,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DUInt>(real((*this)[i]));//Real2Int<DUInt,float>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1911,13 +1601,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong,float>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1933,12 +1617,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong>(real((*this)[i]));//Real2Int<DULong,float>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1954,13 +1633,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong64,float>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1976,12 +1649,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong64>(real((*this)[i]));//Real2Int<DULong64,float>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -1997,12 +1665,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-	for( SizeT i=0; i < nEl; ++i)
-	  (*dest)[i]=real((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
 	return dest;
       }
@@ -2018,12 +1681,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=real((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2035,7 +1693,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]="("+i2s(real((*this)[i]))+","+i2s(imag((*this)[i]))+")";
+      	  (*dest)[i]="("+Real2String(real((*this)[i]))+","+Real2String(imag((*this)[i]))+")";
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -2046,12 +1704,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=new Data_<SpDComplexDbl>( dim, 
 							     BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2091,13 +1744,7 @@ TRACE_CONVERT2
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2DByte<double>(real((*this)[i])); 
-}      	  //(*dest)[i]=Double2DByte(real((*this)[i])); 
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2113,13 +1760,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DInt,double>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2135,12 +1776,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DUInt>(real((*this)[i]));//Real2Int<DUInt,double>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2156,13 +1792,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong,double>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2178,12 +1808,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong>(real((*this)[i]));//Real2Int<DULong,double>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2199,14 +1824,8 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-TRACEOMP( __FILE__, __LINE__)
-#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-#pragma omp for
-      	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=Real2Int<DLong64,double>(real((*this)[i])); 
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
-}
       	return dest;
       }
     case GDL_ULONG64:
@@ -2221,12 +1840,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=static_cast< DULong64>(real((*this)[i]));//Real2Int<DULong64,double>(real((*this)[i])); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2242,12 +1856,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-	for( SizeT i=0; i < nEl; ++i)
-	  (*dest)[i]=real((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
 	return dest;
       }
@@ -2263,12 +1872,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=real((*this)[i]); 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2280,7 +1884,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]="("+i2s(real((*this)[i]))+","+i2s(imag((*this)[i]))+")";
+      	  (*dest)[i]="("+Real2String(real((*this)[i]))+","+Real2String(imag((*this)[i]))+")";
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -2298,14 +1902,7 @@ TRACEOMP( __FILE__, __LINE__)
 		return dest;
 	}
 #endif
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-//{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-// 	  (*dest)[i] = DComplex( static_cast<float>((*this)[i].real()), 
-// 				 static_cast<float>((*this)[i].imag()) );
-//}      	  
-	(*dest)[i]=(*this)[i];
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2339,12 +1936,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDByte>* dest=new Data_<SpDByte>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2352,12 +1944,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDInt>* dest=new Data_<SpDInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2365,12 +1952,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDUInt>* dest=new Data_<SpDUInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2378,12 +1960,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong>* dest=new Data_<SpDLong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2391,12 +1968,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong>* dest=new Data_<SpDULong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2405,12 +1977,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong64>* dest=new Data_<SpDULong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2422,12 +1989,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2435,12 +1997,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2452,7 +2009,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=i2s((*this)[i],22);
+      	  (*dest)[i]=Int2String((*this)[i],22);
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -2461,12 +2018,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2475,12 +2027,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2512,12 +2059,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDByte>* dest=new Data_<SpDByte>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2525,12 +2067,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDInt>* dest=new Data_<SpDInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2538,12 +2075,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDUInt>* dest=new Data_<SpDUInt>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2551,12 +2083,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong>* dest=new Data_<SpDLong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2564,12 +2091,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDULong>* dest=new Data_<SpDULong>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2577,12 +2099,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDLong64>* dest=new Data_<SpDLong64>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2595,12 +2112,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDFloat>* dest=new Data_<SpDFloat>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2608,12 +2120,7 @@ TRACE_CONVERT2
       {
       	Data_<SpDDouble>* dest=new Data_<SpDDouble>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i]; 
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2625,7 +2132,7 @@ TRACEOMP( __FILE__, __LINE__)
 {
 #pragma omp for
       	for( OMPInt i=0; i < nEl; ++i)
-      	  (*dest)[i]=i2s((*this)[i],22);
+      	  (*dest)[i]=Int2String((*this)[i],22);
 }
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
@@ -2634,12 +2141,7 @@ TRACEOMP( __FILE__, __LINE__)
       {
       	Data_<SpDComplex>* dest=new Data_<SpDComplex>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
@@ -2648,12 +2150,7 @@ TRACEOMP( __FILE__, __LINE__)
       	Data_<SpDComplexDbl>* dest=
 	  new Data_<SpDComplexDbl>( dim, BaseGDL::NOZERO);
 	SINGLE_ELEMENT_OPTIMIZATION
-// #pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-{
-// #pragma omp for
-      	for( SizeT i=0; i < nEl; ++i)
-      	  (*dest)[i]=(*this)[i];
-}
+	ConvertArray( &(*dest)[0], &(*this)[0], nEl);
 	if( (mode & BaseGDL::CONVERT) != 0) delete this;
       	return dest;
       }
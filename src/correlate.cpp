@@ -0,0 +1,250 @@
+/***************************************************************************
+                 correlate.cpp  -  CORRELATE(), C_CORRELATE(), A_CORRELATE()
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+// native versions of the former correlate.pro, and of IDL's cross- and
+// auto-correlation functions. Sums are done in double precision, the
+// result is FLOAT unless DOUBLE is set or an input is DOUBLE.
+
+#include "includefirst.hpp"
+
+#include <vector>
+#include <cmath>
+
+#include "correlate.hpp"
+
+#if defined(USE_FFTW)
+#include "fftw.hpp"
+#endif
+
+namespace lib {
+
+  using namespace std;
+
+  // sum of a[k]*b[k], k < n; four independent partial sums so that the
+  // compiler can vectorize without reordering a single accumulation
+  static inline double DotProduct( const double* a, const double* b, SizeT n)
+  {
+    double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+    SizeT k = 0;
+    for( ; k + 4 <= n; k += 4)
+      {
+	s0 += a[ k] * b[ k];
+	s1 += a[ k+1] * b[ k+1];
+	s2 += a[ k+2] * b[ k+2];
+	s3 += a[ k+3] * b[ k+3];
+      }
+    for( ; k < n; ++k) s0 += a[ k] * b[ k];
+    return (s0 + s1) + (s2 + s3);
+  }
+
+  // x - MEAN(x), on the first n elements
+  static void Deviations( const DDoubleGDL* x, SizeT n, vector<double>& d)
+  {
+    d.resize( n);
+    double mean = 0.;
+    for( SizeT k = 0; k < n; ++k) mean += (*x)[ k];
+    mean /= n;
+    for( SizeT k = 0; k < n; ++k) d[ k] = (*x)[ k] - mean;
+  }
+
+  // res[i] = sum_k a[k]*b[k+lag[i]], a and b of length n, |lag| < n.
+  // One dot product per lag (parallel over the lags), or, for long lag
+  // lists, all the lags at once from one FFT correlation.
+  static void LaggedProducts( const double* a, const double* b, SizeT n,
+			      const DLong64* lag, SizeT nLag, double* res)
+  {
+#if defined(USE_FFTW)
+    // direct: about nLag*n multiply-adds; FFT: three transforms of 2n points
+    double directCost = static_cast<double>( nLag) * n;
+    double fftCost = 30. * n * log2( 2. * n);
+    if( nLag > 16 && directCost > fftCost)
+      {
+	vector<double> full( 2*n - 1);
+	fftw_real_correlation( a, b, n, &full[ 0]);
+	for( SizeT i = 0; i < nLag; ++i) res[ i] = full[ lag[ i] + n - 1];
+	return;
+      }
+#endif
+    SizeT nEl = nLag * n;
+#pragma omp parallel for if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+    for( OMPInt i = 0; i < nLag; ++i)
+      {
+	DLong64 l = lag[ i];
+	res[ i] = (l >= 0) ? DotProduct( a, b + l, n - l) : DotProduct( a - l, b, n + l);
+      }
+  }
+
+  static DLong64GDL* GetLags( EnvT* e, SizeT ix, SizeT n)
+  {
+    DLong64GDL* lag = e->GetParAs<DLong64GDL>( ix);
+    DLong64 maxLag = n - 1;
+    for( SizeT i = 0; i < lag->N_Elements(); ++i)
+      if( (*lag)[ i] > maxLag || (*lag)[ i] < -maxLag)
+	e->Throw( "Lag values must be in the range [-(N-1), N-1]: " + e->GetParString( ix));
+    return lag;
+  }
+
+  static void ComplexWarning( EnvT* e, const BaseGDL* p)
+  {
+    if( ComplexType( p->Type()))
+      Message( e->GetProName() + ": Complex type for input not ready, please contribute.");
+  }
+
+  BaseGDL* c_correlate_fun( EnvT* e)
+  {
+    e->NParam( 3);
+    BaseGDL* p0 = e->GetParDefined( 0);
+    BaseGDL* p1 = e->GetParDefined( 1);
+    ComplexWarning( e, p0);
+    ComplexWarning( e, p1);
+
+    SizeT n = p0->N_Elements();
+    if( p1->N_Elements() != n)
+      e->Throw( "X and Y arrays must have the same number of elements.");
+    if( n < 2)
+      e->Throw( "X and Y arrays must contain 2 or more elements.");
+
+    static int covarianceIx = e->KeywordIx( "COVARIANCE");
+    static int doubleIx = e->KeywordIx( "DOUBLE");
+    bool dbl = e->KeywordSet( doubleIx) ||
+      p0->Type() == GDL_DOUBLE || p1->Type() == GDL_DOUBLE;
+
+    vector<double> xd, yd;
+    Deviations( e->GetParAs<DDoubleGDL>( 0), n, xd);
+    Deviations( e->GetParAs<DDoubleGDL>( 1), n, yd);
+
+    DLong64GDL* lag = GetLags( e, 2, n);
+    SizeT nLag = lag->N_Elements();
+    DDoubleGDL* res = new DDoubleGDL( dimension( nLag), BaseGDL::NOZERO);
+    LaggedProducts( &xd[ 0], &yd[ 0], n, &(*lag)[ 0], nLag, &(*res)[ 0]);
+
+    double norm = e->KeywordSet( covarianceIx) ? static_cast<double>( n) :
+      sqrt( DotProduct( &xd[ 0], &xd[ 0], n) * DotProduct( &yd[ 0], &yd[ 0], n));
+    for( SizeT i = 0; i < nLag; ++i) (*res)[ i] /= norm;
+
+    if( dbl) return res;
+    return res->Convert2( GDL_FLOAT, BaseGDL::CONVERT);
+  }
+
+  BaseGDL* a_correlate_fun( EnvT* e)
+  {
+    e->NParam( 2);
+    BaseGDL* p0 = e->GetParDefined( 0);
+    ComplexWarning( e, p0);
+
+    SizeT n = p0->N_Elements();
+    if( n < 2)
+      e->Throw( "X array must contain 2 or more elements.");
+
+    static int covarianceIx = e->KeywordIx( "COVARIANCE");
+    static int doubleIx = e->KeywordIx( "DOUBLE");
+    bool dbl = e->KeywordSet( doubleIx) || p0->Type() == GDL_DOUBLE;
+
+    vector<double> xd;
+    Deviations( e->GetParAs<DDoubleGDL>( 0), n, xd);
+
+    // the autocorrelation is even in the lag
+    DLong64GDL* lag = GetLags( e, 1, n);
+    SizeT nLag = lag->N_Elements();
+    vector<DLong64> absLag( nLag);
+    for( SizeT i = 0; i < nLag; ++i) absLag[ i] = ((*lag)[ i] < 0) ? -(*lag)[ i] : (*lag)[ i];
+
+    DDoubleGDL* res = new DDoubleGDL( dimension( nLag), BaseGDL::NOZERO);
+    LaggedProducts( &xd[ 0], &xd[ 0], n, &absLag[ 0], nLag, &(*res)[ 0]);
+
+    double norm = e->KeywordSet( covarianceIx) ? static_cast<double>( n) :
+      DotProduct( &xd[ 0], &xd[ 0], n);
+    for( SizeT i = 0; i < nLag; ++i) (*res)[ i] /= norm;
+
+    if( dbl) return res;
+    return res->Convert2( GDL_FLOAT, BaseGDL::CONVERT);
+  }
+
+  BaseGDL* correlate_fun( EnvT* e)
+  {
+    SizeT nParam = e->NParam( 1);
+    BaseGDL* p0 = e->GetParDefined( 0);
+    ComplexWarning( e, p0);
+
+    static int covarianceIx = e->KeywordIx( "COVARIANCE");
+    static int doubleIx = e->KeywordIx( "DOUBLE");
+    bool covariance = e->KeywordSet( covarianceIx);
+    bool dbl = e->KeywordSet( doubleIx) || p0->Type() == GDL_DOUBLE;
+
+    if( nParam == 1)
+      {
+	// correlation (covariance) matrix of the NX variables X[i,*]
+	if( p0->Rank() != 2)
+	  e->Throw( "Expecting two-dimensional array");
+	DDoubleGDL* x = e->GetParAs<DDoubleGDL>( 0);
+	SizeT nx = p0->Dim( 0);
+	SizeT ny = p0->Dim( 1);
+
+	// deviations, one variable per contiguous row
+	vector<double> d( nx * ny);
+#pragma omp parallel for if (nx*ny >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nx*ny))
+	for( OMPInt i = 0; i < nx; ++i)
+	  {
+	    double mean = 0.;
+	    for( SizeT k = 0; k < ny; ++k) mean += (*x)[ i + k * nx];
+	    mean /= ny;
+	    for( SizeT k = 0; k < ny; ++k) d[ i * ny + k] = (*x)[ i + k * nx] - mean;
+	  }
+
+	DDoubleGDL* res = new DDoubleGDL( dimension( nx, nx), BaseGDL::NOZERO);
+	SizeT nEl = nx * nx * ny;
+#pragma omp parallel for schedule(dynamic) if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+	for( OMPInt i = 0; i < nx; ++i)
+	  for( SizeT j = i; j < nx; ++j)
+	    (*res)[ i + j * nx] = (*res)[ j + i * nx] =
+	      DotProduct( &d[ i * ny], &d[ j * ny], ny);
+
+	if( covariance)
+	  {
+	    for( SizeT i = 0; i < nx * nx; ++i) (*res)[ i] /= (ny - 1.);
+	  }
+	else
+	  {
+	    vector<double> s( nx);
+	    for( SizeT i = 0; i < nx; ++i) s[ i] = sqrt( (*res)[ i + i * nx]);
+	    for( SizeT j = 0; j < nx; ++j)
+	      for( SizeT i = 0; i < nx; ++i) (*res)[ i + j * nx] /= s[ i] * s[ j];
+	  }
+	if( dbl) return res;
+	return res->Convert2( GDL_FLOAT, BaseGDL::CONVERT);
+      }
+
+    // two vectors, on the length of the shorter one
+    BaseGDL* p1 = e->GetParDefined( 1);
+    ComplexWarning( e, p1);
+    dbl = dbl || p1->Type() == GDL_DOUBLE;
+    SizeT n = p0->N_Elements();
+    if( p1->N_Elements() < n) n = p1->N_Elements();
+
+    vector<double> xd, yd;
+    Deviations( e->GetParAs<DDoubleGDL>( 0), n, xd);
+    Deviations( e->GetParAs<DDoubleGDL>( 1), n, yd);
+
+    double r = DotProduct( &xd[ 0], &yd[ 0], n);
+    if( covariance)
+      r /= (n - 1.);
+    else
+      r /= sqrt( DotProduct( &xd[ 0], &xd[ 0], n) * DotProduct( &yd[ 0], &yd[ 0], n));
+
+    if( dbl) return new DDoubleGDL( r);
+    return new DFloatGDL( r);
+  }
+
+} // namespace
@@ -0,0 +1,30 @@
+/***************************************************************************
+                 correlate.hpp  -  CORRELATE(), C_CORRELATE(), A_CORRELATE()
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CORRELATE_HPP_
+#define CORRELATE_HPP_
+
+#include "datatypes.hpp"
+#include "envt.hpp"
+
+namespace lib {
+
+  BaseGDL* correlate_fun( EnvT* e);
+  BaseGDL* c_correlate_fun( EnvT* e);
+  BaseGDL* a_correlate_fun( EnvT* e);
+
+} // namespace
+
+#endif
@@ -1340,6 +1340,20 @@ DUInt* InitPermDefault()
     res[ ii] = i;
   return res;
 }
+// Transpose() kernel: dst[ a + b*dstStride] = src[ a*srcStride + b], a < na, b < nb.
+// Called on tiles small enough for the strided side to stay in L1 cache; with na == nb == tile
+// the bounds are constants and the loops unroll/vectorize.
+template<typename Ty>
+static inline void TransposeTile( Ty* dst, SizeT dstStride, const Ty* src, SizeT srcStride, SizeT na, SizeT nb)
+{
+  for( SizeT b = 0; b < nb; ++b)
+    for( SizeT a = 0; a < na; ++a)
+      dst[ a + b * dstStride] = src[ a * srcStride + b];
+}
+// tile side, about two cache lines of elements
+template<typename Ty>
+static inline SizeT TransposeTileSize() { return (sizeof(Ty) >= 16) ? 8 : 128 / sizeof(Ty);}
+
 template<class Sp> 
 BaseGDL* Data_<Sp>::Transpose( DUInt* perm) {
   SizeT rank = this->Rank();
@@ -1358,32 +1372,8 @@ BaseGDL* Data_<Sp>::Transpose( DUInt* perm) {
 
   // 2 - MAXRANK
   static DUInt* permDefault = InitPermDefault();
-  if (perm == NULL) {
-    
-// following 2D code is now slower than multi-dim multicore solution below. 
-//    if (rank == 2) {
-//      SizeT srcDim0 = this->dim[0];
-//      SizeT srcDim1 = this->dim[1];
-//      Data_* res = new Data_(dimension(srcDim1, srcDim0), BaseGDL::NOZERO);
-//
-//      SizeT srcIx = 0;
-//      for (SizeT srcIx1 = 0; srcIx1 < srcDim1; ++srcIx1) // src dim 1
-//      {
-//        SizeT resIx = srcIx1;
-//        SizeT srcLim = srcIx + srcDim0; // src dim 0
-//        for (; srcIx < srcLim; ++srcIx) {
-//          (*res)[ resIx] = (*this)[ srcIx];
-//          resIx += srcDim1;
-//        }
-//      }
-//      return res;
-//    }
+  if (perm == NULL) perm = &permDefault[ MAXRANK - rank];
 
-    // perm == NULL, rank != 2
-    perm = &permDefault[ MAXRANK - rank];
-  }
-
-  //new version, parallell the job on a multithreaded machine. Gain is 3/4 number of threads.  
   SizeT resDim[ MAXRANK]; // permutated!
   for (SizeT d = 0; d < rank; ++d) {
     resDim[ d] = this->dim[ perm[ d]];
@@ -1391,67 +1381,90 @@ BaseGDL* Data_<Sp>::Transpose( DUInt* perm) {
 
   Data_* res = new Data_(dimension(resDim, rank), BaseGDL::NOZERO);
 
-  // src stride
   SizeT srcStride[ MAXRANK+1];
   this->dim.Stride(srcStride, rank);
+  SizeT resStride[ MAXRANK+1];
+  res->dim.Stride(resStride, rank);
+
+  // Any permutation is a set of 2D transposes: result dim 0 (source stride aStride) against
+  // result dim j, which receives the source dim 0 (contiguous). All other dims are 'outer'.
+  // If perm[0] == 0 (j == 0) it is just a set of contiguous row copies.
+  SizeT j = 0;
+  while (perm[ j] != 0) ++j;
+  SizeT na = resDim[ 0];
+  SizeT aStride = srcStride[ perm[ 0]];
+  SizeT nb = (j == 0) ? 1 : resDim[ j];
+  SizeT bStride = (j == 0) ? 0 : resStride[ j];
+
+  SizeT nOut = 0;
+  SizeT outDim[ MAXRANK], outRes[ MAXRANK], outSrc[ MAXRANK];
+  for (SizeT d = 1; d < rank; ++d) {
+    if (d == j) continue;
+    outDim[ nOut] = resDim[ d];
+    outRes[ nOut] = resStride[ d];
+    outSrc[ nOut] = srcStride[ perm[ d]];
+    ++nOut;
+  }
 
   SizeT nElem = dd.size();
-  long chunksize = nElem;
-  long nchunk = 1;
-  if (nElem > CpuTPOOL_MIN_ELTS) { //no use start parallel threading for small numbers.
-    chunksize = nElem / ((CpuTPOOL_NTHREADS > 32) ? 32 : CpuTPOOL_NTHREADS);
-    nchunk = nElem / chunksize;
-    if (chunksize * nchunk < nElem) ++nchunk;
-  } else {
-    nchunk = 1;
-    chunksize = nElem;
-  }
-  //compute start parameter for each multiWalk chunks:
-  // pool of accelerators
-  SizeT srcDimPool[nchunk][MAXRANK];
-  for (SizeT i = 0; i < rank; ++i) for (int iloop = 0; iloop < nchunk; ++iloop) srcDimPool[iloop][i] = 0;
-  //template accelerator
-  SizeT templateDim[MAXRANK];
-  for (SizeT i = 0; i < rank; ++i) templateDim[i] = 0;
-
-  //compute iloop's accelerator with fast direct method
-  for (long iloop = 0; iloop < nchunk; ++iloop) {
-    SizeT e = iloop*chunksize;
-    SizeT sizeleft = e;
-    for (long i = 0; i < rank; ++i) {
-      DUInt pi = perm[i]; //note the transpose effect.
-      sizeleft /= resDim[i];
-      templateDim[pi] = e - sizeleft * resDim[i];
-      e = sizeleft;
+  SizeT nOuter = nElem / (na * nb);
+  const SizeT tile = TransposeTileSize<Ty>();
+  SizeT nTileA = (na + tile - 1) / tile;
+  SizeT nTileB = (nb + tile - 1) / tile;
+  OMPInt nItems = nOuter * nTileB * nTileA;
+
+  Ty* dst = &(*res)[ 0];
+  const Ty* src = &(*this)[ 0];
+#pragma omp parallel for if (nElem >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nElem))
+  for (OMPInt it = 0; it < nItems; ++it) {
+    // tiles along result dim 0 first, so that consecutive items write consecutive memory
+    SizeT o = it / nTileA;
+    SizeT a0 = (it - o * nTileA) * tile;
+    SizeT tb = o % nTileB;
+    o /= nTileB;
+    SizeT b0 = tb * tile;
+    SizeT resOff = a0 + b0 * bStride;
+    SizeT srcOff = a0 * aStride + b0;
+    for (SizeT k = 0; k < nOut; ++k) {
+      SizeT q = o / outDim[ k];
+      SizeT ik = o - q * outDim[ k];
+      resOff += ik * outRes[ k];
+      srcOff += ik * outSrc[ k];
+      o = q;
     }
-    //memorize current state accelerator for chunk iloop:
-    for (long j = 0; j < rank; ++j) srcDimPool[iloop][j] = templateDim[j];
+    SizeT an = (na - a0 < tile) ? na - a0 : tile;
+    SizeT bn = (nb - b0 < tile) ? nb - b0 : tile;
+    if (an == tile && bn == tile)
+      TransposeTile(dst + resOff, bStride, src + srcOff, aStride, tile, tile);
+    else
+      TransposeTile(dst + resOff, bStride, src + srcOff, aStride, an, bn);
   }
+  return res;
+}
 
-#pragma omp parallel num_threads(nchunk) 
-  {
-#pragma omp for 
-    for (long iloop = 0; iloop < nchunk; ++iloop) {
-      // populate src multi dim
-      SizeT srcDim[MAXRANK];
-      for (SizeT i = 0; i < rank; ++i) srcDim[i] = srcDimPool[iloop][i];
-      //inner loop
-      for (SizeT e = iloop * chunksize; (e < (iloop + 1) * chunksize && e < nElem); ++e) {
-        // src multi dim to one dim src offset index
-        SizeT ix = 0;
-        for (SizeT i = 0; i < rank; ++i) ix += srcDim[i] * srcStride[i];
-        (*res)[ e] = (*this)[ ix];
-        // update src multi dim for next dest offset index: here is the transpose effect.
-        for (SizeT i = 0; i < rank; ++i) {
-          DUInt pi = perm[i];
-          srcDim[pi]++;
-          if (srcDim[pi] < resDim[i]) break;
-          srcDim[pi] = 0;
+// in place transpose of a square 2D array, by pairs of tiles on both sides of the diagonal
+template<class Sp>
+void Data_<Sp>::TransposeInPlace() {
+  assert(this->Rank() == 2 && this->dim[0] == this->dim[1]);
+  SizeT n = this->dim[0];
+  SizeT nElem = dd.size();
+  const SizeT tile = TransposeTileSize<Ty>();
+  OMPInt nTile = (n + tile - 1) / tile;
+  Ty* a = &(*this)[ 0];
+#pragma omp parallel for schedule(dynamic) if (nElem >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nElem))
+  for (OMPInt ti = 0; ti < nTile; ++ti) {
+    SizeT i0 = ti * tile;
+    SizeT i1 = (i0 + tile < n) ? i0 + tile : n;
+    for (SizeT j0 = i0; j0 < n; j0 += tile) {
+      SizeT j1 = (j0 + tile < n) ? j0 + tile : n;
+      for (SizeT i = i0; i < i1; ++i)
+        for (SizeT jj = (j0 == i0) ? i + 1 : j0; jj < j1; ++jj) {
+          Ty tmp = a[ i + jj * n];
+          a[ i + jj * n] = a[ jj + i * n];
+          a[ jj + i * n] = tmp;
         }
-      }
     }
   }
-  return res;
 }
 
 // used by reverse
@@ -2109,11 +2122,9 @@ Data_<Sp>* Data_<Sp>::New( const dimension& dim_, BaseGDL::InitType noZero) cons
     {
       Data_* res =  new Data_(dim_, BaseGDL::NOZERO);
       SizeT nEl = res->dd.size();
-      /*#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
-	{
-	#pragma omp for*/
-      for( SizeT i=0; i<nEl; ++i) (*res)[ i] = (*this)[ 0]; // set all to scalar
-      //}
+      const Ty s = (*this)[ 0];
+#pragma omp parallel for if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+      for( OMPInt i=0; i<nEl; ++i) (*res)[ i] = s; // set all to scalar
       return res;
     }
   return new Data_(dim_); // zero data
@@ -4087,289 +4098,129 @@ BaseGDL* Data_<SpDComplexDbl>::Rebin( const dimension& newDim, bool sample)
 }
 
 
-// rebin over dimIx, new value: newDim
-// newDim != srcDim[ dimIx] -> compress or expand
-template< typename T>
-T* Rebin1( T* src, 
-	   const dimension& srcDim, 
-	   SizeT dimIx, SizeT newDim, bool sample)
-{
-  SizeT nEl = src->N_Elements();
-  
-  if( newDim == 0) newDim = 1;
-
-  // get dest dim and number of summations
-  dimension destDim = srcDim;
-
-  destDim.MakeRank( dimIx + 1);
-
-  SizeT srcDimIx = destDim[ dimIx];
-
-  destDim.SetOneDim( dimIx, newDim);
+// REBIN accumulator: integers are summed in 64 bit, floating types in double
+template<typename Ty> struct RebinAcc { typedef DDouble type;};
+template<> struct RebinAcc<DByte> { typedef DULong64 type;};
+template<> struct RebinAcc<DInt> { typedef DLong64 type;};
+template<> struct RebinAcc<DUInt> { typedef DULong64 type;};
+template<> struct RebinAcc<DLong> { typedef DLong64 type;};
+template<> struct RebinAcc<DULong> { typedef DULong64 type;};
+template<> struct RebinAcc<DLong64> { typedef DLong64 type;};
+template<> struct RebinAcc<DULong64> { typedef DULong64 type;};
 
-  SizeT resStride   = destDim.Stride( dimIx); 
-
-  // dimStride is also the number of linear src indexing
-  SizeT dimStride   = srcDim.Stride( dimIx); 
-  SizeT outerStride = srcDim.Stride( dimIx + 1);
-
-  SizeT rebinLimit = srcDimIx * dimStride;
-    
-  if( newDim < srcDimIx) // compress
-    {
-    
-      SizeT ratio = srcDimIx / newDim;
- 
-      if( sample)
-	{
-	  T* res = new T( destDim, BaseGDL::NOZERO);
-    
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride*ratio) // run over dim
-		  {
-		    (*res)[ (s / dimStride / ratio) * dimStride + i] = (*src)[ s];
-		  }
-	      }
-      
-	  return res;
-	}
-      else
-	{
-	  T* res = new T( destDim); // zero fields
-
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride) // run over dim
-		  {
-		    // the way s indexes:
-		    // assume over b (compress index)
-		    // src[ a, b, c]
-		    // [ 0, 0, 0] [ 0, 1, 0] [ 0, 2, 0] ...
-		    // [ 1, 0, 0] [ 1, 1, 0] [ 1, 2, 0] ...
-		    // [ 2, 0, 0] [ 2, 1, 0] [ 2, 2, 0] ...
-
-		    (*res)[ (s / dimStride / ratio) * dimStride + i] += (*src)[ s];
-		  }
-	      }
-      
-	  SizeT resEl = res->N_Elements();
-	  /*#pragma omp parallel if (resEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= resEl))
-	    {
-	    #pragma omp for*/
-	  for( int r=0; r < resEl; ++r)
-	    (*res)[ r] /= ratio;
-	  // }
-	  return res;
-	}
-    }
-  else // expand
-    {
-      T* res = new T( destDim, BaseGDL::NOZERO);
-
-      if( sample)
-	{
-	  SizeT ratio = newDim / srcDimIx;
- 
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride) // run over dim
-		  {
-		    typename T::Ty src_s = (*src)[ s];
-
-		    SizeT s_dimStride_ratio_dimStride_i = 
-		      (s / dimStride) * ratio * dimStride + i;
-
-		    for( SizeT r=0; r<ratio; ++r)
-		      {
-			(*res)[ s_dimStride_ratio_dimStride_i + r * dimStride] = 
-			  src_s;
-		      }
-		  }
-	      }
-	}
-      else
-	{
-	  DLong64 ratio = newDim / srcDimIx; // make sure 32 bit integers are working also
+// /SAMPLE, or compression only: one gather (or block average) from src (dims srcD)
+// into res (dims resD), all dimensions at once. res dim d is either an integer fraction
+// (compress) or an integer multiple (expand, sample only) of src dim d.
+// Block averages sum all the elements of a block first, then divide once.
+template<typename Ty>
+static void RebinGather( const Ty* src, const SizeT* srcD, Ty* res, const SizeT* resD,
+			 SizeT nDim, bool sample)
+{
+  typedef typename RebinAcc<Ty>::type Acc;
+  SizeT srcStride[ MAXRANK + 1], resStride[ MAXRANK + 1];
+  srcStride[ 0] = resStride[ 0] = 1;
+  for( SizeT d = 0; d < nDim; ++d) {
+    srcStride[ d + 1] = srcStride[ d] * srcD[ d];
+    resStride[ d + 1] = resStride[ d] * resD[ d];
+  }
+  // compression factors (1 for expanded or unchanged dims)
+  SizeT ratio[ MAXRANK];
+  SizeT blockRows = 1;
+  for( SizeT d = 0; d < nDim; ++d) {
+    ratio[ d] = (resD[ d] < srcD[ d]) ? srcD[ d] / resD[ d] : 1;
+    if( d > 0) blockRows *= ratio[ d];
+  }
+  const SizeT n0 = resD[ 0];
+  const SizeT r0 = ratio[ 0];
+  const SizeT e0 = (resD[ 0] > srcD[ 0]) ? resD[ 0] / srcD[ 0] : 1; // sample expand on dim 0
+  const Acc div = r0 * blockRows;
+  SizeT nRows = resStride[ nDim] / n0;
+  SizeT nEl = resStride[ nDim];
 
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride) // run over dim
-		  {
-		    typename T::Ty first = (*src)[ s];
-		    typename T::Ty next = 
-		      (*src)[ (s+dimStride)<oiLimit?s+dimStride:s];
-
-		    SizeT s_dimStride_ratio_dimStride_i = 
-		      (s / dimStride) * ratio * dimStride + i;
-		    for( DLong64 r=0; r<ratio; ++r)
-		      {
-			(*res)[ s_dimStride_ratio_dimStride_i + r * dimStride] = 
-			  (first * (ratio - r) + next * r) / ratio; // 64 bit temporary
-		      }
-		  }
-	      }
+#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+  {
+    std::vector<Acc> acc( sample ? 0 : n0);
+#pragma omp for
+    for( OMPInt row = 0; row < nRows; ++row) {
+      // first source row of this result row
+      SizeT srcRow = 0;
+      SizeT rowIx[ MAXRANK];
+      SizeT rest = row;
+      for( SizeT d = 1; d < nDim; ++d) {
+	SizeT q = rest / resD[ d];
+	rowIx[ d] = rest - q * resD[ d];
+	rest = q;
+	SizeT s = (resD[ d] < srcD[ d]) ? rowIx[ d] * ratio[ d] : rowIx[ d] * srcD[ d] / resD[ d];
+	srcRow += s * srcStride[ d];
+      }
+      Ty* out = res + row * n0;
+      if( sample) {
+	const Ty* in = src + srcRow;
+	if( e0 > 1)
+	  for( SizeT i = 0; i < n0; ++i) out[ i] = in[ i / e0];
+	else if( r0 == 1)
+	  for( SizeT i = 0; i < n0; ++i) out[ i] = in[ i];
+	else
+	  for( SizeT i = 0; i < n0; ++i) out[ i] = in[ i * r0];
+	continue;
+      }
+      for( SizeT i = 0; i < n0; ++i) acc[ i] = 0;
+      // run over all source rows of the block (odometer over dims 1..nDim-1)
+      SizeT blk[ MAXRANK];
+      for( SizeT d = 1; d < nDim; ++d) blk[ d] = 0;
+      for( SizeT b = 0; b < blockRows; ++b) {
+	SizeT off = srcRow;
+	for( SizeT d = 1; d < nDim; ++d) off += blk[ d] * srcStride[ d];
+	const Ty* in = src + off;
+	if( r0 == 1)
+	  for( SizeT i = 0; i < n0; ++i) acc[ i] += in[ i];
+	else
+	  for( SizeT i = 0; i < n0; ++i) {
+	    const Ty* p = in + i * r0;
+	    Acc t = 0;
+	    for( SizeT k = 0; k < r0; ++k) t += p[ k];
+	    acc[ i] += t;
+	  }
+	for( SizeT d = 1; d < nDim; ++d) {
+	  if( ++blk[ d] < ratio[ d]) break;
+	  blk[ d] = 0;
 	}
-
-      return res;
+      }
+      for( SizeT i = 0; i < n0; ++i) out[ i] = acc[ i] / div;
     }
+  }
 }
 
-// for integer
-template< typename T, typename TNext>
-T* Rebin1Int( T* src, 
-	      const dimension& srcDim, 
-	      SizeT dimIx, SizeT newDim, bool sample)
-{
-  SizeT nEl = src->N_Elements();
-  
-  if( newDim == 0) newDim = 1;
-
-  // get dest dim and number of summations
-  dimension destDim = srcDim;
-
-  destDim.MakeRank( dimIx + 1);
-
-  SizeT srcDimIx = destDim[ dimIx];
-
-  destDim.SetOneDim( dimIx, newDim);
-
-  SizeT resStride   = destDim.Stride( dimIx); 
-
-  // dimStride is also the number of linear src indexing
-  SizeT dimStride   = srcDim.Stride( dimIx); 
-  SizeT outerStride = srcDim.Stride( dimIx + 1);
-
-  SizeT rebinLimit = srcDimIx * dimStride;
-    
-  if( newDim < srcDimIx) // compress
-    {
-    
-      SizeT ratio = srcDimIx / newDim;
- 
-      if( sample)
-	{
-	  T* res = new T( destDim, BaseGDL::NOZERO);
-    
-	  SizeT ratio = srcDimIx / newDim;
- 
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride*ratio) // run over dim
-		  {
-		    (*res)[ (s / dimStride / ratio) * dimStride + i] = (*src)[ s];
-		  }
-	      }
-      
-	  return res;
-	}
-      else
-	{
-	  T* res = new T( destDim); // zero fields
-
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		TNext tmp = 0;
-		for( SizeT s=oi; s<oiLimit; s += dimStride) // run over dim
-		  {
-		    tmp += (*src)[ s];
-		    
-		    if( (s / dimStride) % ratio == (ratio - 1))
-		      {
-			(*res)[ (s / dimStride / ratio) * dimStride + i] = tmp / ratio;
-			tmp = 0;
-		      }
-		  }
-	      }
-      
-	  return res;
-	}
-    }
-  else // expand
-    {
-      T* res = new T( destDim, BaseGDL::NOZERO);
-
-      if( sample)
-	{
-	  SizeT ratio = newDim / srcDimIx;
- 
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride) // run over dim
-		  {
-		    typename T::Ty src_s = (*src)[ s];
-
-		    SizeT s_dimStride_ratio_dimStride_i = 
-		      (s / dimStride) * ratio * dimStride + i;
-
-		    for( SizeT r=0; r<ratio; ++r)
-		      {
-			(*res)[ s_dimStride_ratio_dimStride_i + r * dimStride] = 
-			  src_s;
-		      }
-		  }
-	      }
-	}
-      else
-	{
-	  DLong64 ratio = newDim / srcDimIx; // make sure 32 bit integers are working also
-
-	  for( SizeT o=0; o < nEl; o += outerStride) // outer dim
-	    for( SizeT i=0; i < dimStride; ++i) // src element offset (lower dim)
-	      {
-		SizeT oi = o+i;
-		SizeT oiLimit = oi + rebinLimit;
-
-		for( SizeT s=oi; s<oiLimit; s += dimStride) // run over dim
-		  {
-		    typename T::Ty first = (*src)[ s];
-		    typename T::Ty next = 
-		      (*src)[ (s+dimStride)<oiLimit?s+dimStride:s];
-
-		    SizeT s_dimStride_ratio_dimStride_i = 
-		      (s / dimStride) * ratio * dimStride + i;
-		    for( DLong64 r=0; r<ratio; ++r)
-		      {
-			(*res)[ s_dimStride_ratio_dimStride_i + r * dimStride] = 
-			  (first * (ratio - r) + next * r) / ratio; // 64 bit temporary
-		      }
-		  }
-	      }
-	}
+// linear interpolation expansion of dimension dimIx by an integer factor
+template<typename Ty>
+static void RebinExpand1( const Ty* src, const SizeT* srcD, Ty* res, SizeT nDim,
+			  SizeT dimIx, SizeT newDim)
+{
+  SizeT inner = 1;
+  for( SizeT d = 0; d < dimIx; ++d) inner *= srcD[ d];
+  SizeT n = srcD[ dimIx];
+  SizeT outer = 1;
+  for( SizeT d = dimIx + 1; d < nDim; ++d) outer *= srcD[ d];
+  DLong64 ratio = newDim / n; // make sure 32 bit integers are working also
+  OMPInt nItems = outer * n;
+  SizeT nEl = nItems * ratio * inner;
 
-      return res;
-    }
+#pragma omp parallel for if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+  for( OMPInt it = 0; it < nItems; ++it) {
+    SizeT o = it / n;
+    SizeT s = it - o * n;
+    const Ty* first = src + (o * n + s) * inner;
+    const Ty* next = (s + 1 < n) ? first + inner : first;
+    Ty* out = res + (o * n * ratio + s * ratio) * inner;
+    for( DLong64 r = 0; r < ratio; ++r, out += inner)
+      for( SizeT i = 0; i < inner; ++i)
+	out[ i] = (first[ i] * (ratio - r) + next[ i] * r) / ratio; // 64 bit temporary
+  }
 }
 
-// for float, double
+// All numeric types. Compression (block average or /SAMPLE) is done in one pass over all
+// dimensions; expansion by linear interpolation then one pass per expanded dimension
+// (as before, compression always comes first).
 template<class Sp>
 BaseGDL* Data_<Sp>::Rebin( const dimension& newDim, bool sample)
 {
@@ -4382,247 +4233,45 @@ BaseGDL* Data_<Sp>::Rebin( const dimension& newDim, bool sample)
   else
     nDim = resRank;
 
-  dimension actDim( this->dim);
-  Data_* actIn = this;
-
-  // 1st compress
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[d] <  this->dim[d])
-      { // compress
-	
-	Data_* act = Rebin1( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-
-  // 2nd expand
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[ d] >  this->dim[d])
-      { // expand
-	
-	Data_* act = Rebin1( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-  
-  if( actIn == this) return actIn->Dup();
-  return actIn;
-}
-
-// integer types
-template<>
-BaseGDL* Data_<SpDByte>::Rebin( const dimension& newDim, bool sample)
-{
-  SizeT resRank = newDim.Rank();
-  SizeT srcRank = Rank();
-
-  SizeT nDim;
-  if( resRank < srcRank) 
-    nDim = srcRank;
-  else
-    nDim = resRank;
-
-  dimension actDim( dim);
-  Data_* actIn = this;
-
-  // 1st compress
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[d] <  dim[d])
-      { // compress
-	
-	Data_* act = Rebin1Int<DByteGDL, DULong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-
-  // 2nd expand
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[ d] >  dim[d])
-      { // expand
-	
-	Data_* act = Rebin1Int<DByteGDL, DULong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-  
-  if( actIn == this) return actIn->Dup();
-  return actIn;
-}
-template<>
-BaseGDL* Data_<SpDInt>::Rebin( const dimension& newDim, bool sample)
-{
-  SizeT resRank = newDim.Rank();
-  SizeT srcRank = Rank();
-
-  SizeT nDim;
-  if( resRank < srcRank) 
-    nDim = srcRank;
-  else
-    nDim = resRank;
-
-  dimension actDim( dim);
-  Data_* actIn = this;
-
-  // 1st compress
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[d] <  dim[d])
-      { // compress
-	
-	Data_* act = Rebin1Int<DIntGDL, DLong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-
-  // 2nd expand
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[ d] >  dim[d])
-      { // expand
-	
-	Data_* act = Rebin1Int<DIntGDL, DLong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-  
-  if( actIn == this) return actIn->Dup();
-  return actIn;
-}
-template<>
-BaseGDL* Data_<SpDUInt>::Rebin( const dimension& newDim, bool sample)
-{
-  SizeT resRank = newDim.Rank();
-  SizeT srcRank = Rank();
-
-  SizeT nDim;
-  if( resRank < srcRank) 
-    nDim = srcRank;
-  else
-    nDim = resRank;
-
-  dimension actDim( dim);
-  Data_* actIn = this;
-
-  // 1st compress
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[d] <  dim[d])
-      { // compress
-	
-	Data_* act = Rebin1Int<DUIntGDL, DULong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-
-  // 2nd expand
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[ d] >  dim[d])
-      { // expand
-	
-	Data_* act = Rebin1Int<DUIntGDL, DULong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-  
-  if( actIn == this) return actIn->Dup();
-  return actIn;
-}
-template<>
-BaseGDL* Data_<SpDLong>::Rebin( const dimension& newDim, bool sample)
-{
-  SizeT resRank = newDim.Rank();
-  SizeT srcRank = Rank();
-
-  SizeT nDim;
-  if( resRank < srcRank) 
-    nDim = srcRank;
-  else
-    nDim = resRank;
-
-  dimension actDim( dim);
-  Data_* actIn = this;
-
-  // 1st compress
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[d] <  dim[d])
-      { // compress
-	
-	Data_* act = Rebin1Int<DLongGDL, DLong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-
-  // 2nd expand
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[ d] >  dim[d])
-      { // expand
-	
-	Data_* act = Rebin1Int<DLongGDL, DLong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-  
-  if( actIn == this) return actIn->Dup();
-  return actIn;
-}
-template<>
-BaseGDL* Data_<SpDULong>::Rebin( const dimension& newDim, bool sample)
-{
-  SizeT resRank = newDim.Rank();
-  SizeT srcRank = Rank();
-
-  SizeT nDim;
-  if( resRank < srcRank) 
-    nDim = srcRank;
-  else
-    nDim = resRank;
-
-  dimension actDim( dim);
-  Data_* actIn = this;
+  SizeT srcD[ MAXRANK], midD[ MAXRANK], resD[ MAXRANK];
+  bool compress = false, expand = false;
+  for( SizeT d = 0; d < nDim; ++d) {
+    srcD[ d] = (d < srcRank) ? this->dim[ d] : 1;
+    resD[ d] = (newDim[ d] == 0) ? 1 : newDim[ d];
+    midD[ d] = (resD[ d] < srcD[ d]) ? resD[ d] : srcD[ d];
+    if( resD[ d] < srcD[ d]) compress = true;
+    if( resD[ d] > srcD[ d]) expand = true;
+  }
+  if( !compress && !expand) return this->Dup();
 
-  // 1st compress
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[d] <  dim[d])
-      { // compress
-	
-	Data_* act = Rebin1Int<DULongGDL, DULong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
+  if( sample) {
+    Data_* res = new Data_( dimension( resD, nDim), BaseGDL::NOZERO);
+    RebinGather( &(*this)[ 0], srcD, &(*res)[ 0], resD, nDim, true);
+    return res;
+  }
 
-  // 2nd expand
-  for( SizeT d=0; d<nDim; ++d)
-    if( newDim[ d] >  dim[d])
-      { // expand
-	
-	Data_* act = Rebin1Int<DULongGDL, DULong64>( actIn, actDim, d, newDim[d], sample);
-	actDim = act->Dim();
-	
-	if( actIn != this) GDLDelete(actIn);
-	actIn = act;
-      }
-  
-  if( actIn == this) return actIn->Dup();
-  return actIn;
+  Data_* act = this;
+  if( compress) {
+    act = new Data_( dimension( midD, nDim), BaseGDL::NOZERO);
+    RebinGather( &(*this)[ 0], srcD, &(*act)[ 0], midD, nDim, false);
+  }
+  Guard<Data_> actGuard;
+  if( act != this) actGuard.Init( act);
+
+  SizeT curD[ MAXRANK];
+  for( SizeT d = 0; d < nDim; ++d) curD[ d] = midD[ d];
+  for( SizeT d = 0; d < nDim; ++d)
+    if( resD[ d] > srcD[ d]) { // expand
+      SizeT nextD[ MAXRANK];
+      for( SizeT k = 0; k < nDim; ++k) nextD[ k] = curD[ k];
+      nextD[ d] = resD[ d];
+      Data_* next = new Data_( dimension( nextD, nDim), BaseGDL::NOZERO);
+      RebinExpand1( &(*act)[ 0], curD, &(*next)[ 0], nDim, d, resD[ d]);
+      actGuard.Reset( next);
+      act = next;
+      curD[ d] = resD[ d];
+    }
+  return actGuard.release();
 }
 
 // plain copy of nEl from src
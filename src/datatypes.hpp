@@ -169,6 +169,7 @@ static	void operator delete( void *ptr);
   BaseGDL* CShift( DLong d[MAXRANK]) const; 
 
   BaseGDL* Transpose( DUInt* perm);
+  void TransposeInPlace();
   BaseGDL* Rotate( DLong dir);
   void Reverse( DLong dim);
   BaseGDL* DupReverse( DLong dim);
@@ -25,6 +25,88 @@
 #include "nullgdl.hpp"
 #include "dstructgdl.hpp"
 
+#include <type_traits>
+
+// MinMax() on contiguous data of non-complex numeric types. Each block of MINMAX_BLOCK
+// elements is first reduced by a branch-free loop (vectorized by the compiler); only a block
+// that improves on the current extreme is read again, to find the first index holding it.
+// This selects the same element as the plain "first strictly smaller/greater" scan, NaNs
+// never comparing true. With omitNaN, non-finite values are skipped (x - x is NaN for them).
+static const SizeT MINMAX_BLOCK = 2048;
+
+template<typename Ty, bool omitNaN>
+static void MinMaxBlocks( const Ty* p, SizeT start, SizeT stop, bool doMin, bool doMax,
+			  DLong& minEl, DLong& maxEl)
+{
+  for( SizeT b = start; b < stop; b += MINMAX_BLOCK) {
+    SizeT e = (stop - b < MINMAX_BLOCK) ? stop : b + MINMAX_BLOCK;
+    if( doMin) {
+      Ty m = p[ minEl];
+      for( SizeT i = b; i < e; ++i) {
+	Ty x = p[ i];
+	bool lt = x < m;
+	if( omitNaN) lt = lt && (x - x == 0);
+	m = lt ? x : m;
+      }
+      if( m < p[ minEl])
+	for( SizeT i = b; i < e; ++i) if( p[ i] == m) { minEl = i; break;}
+    }
+    if( doMax) {
+      Ty m = p[ maxEl];
+      for( SizeT i = b; i < e; ++i) {
+	Ty x = p[ i];
+	bool gt = x > m;
+	if( omitNaN) gt = gt && (x - x == 0);
+	m = gt ? x : m;
+      }
+      if( m > p[ maxEl])
+	for( SizeT i = b; i < e; ++i) if( p[ i] == m) { maxEl = i; break;}
+    }
+  }
+}
+
+// minEl and maxEl hold the (valid) starting element, the search is over ]start, stop[.
+// Chunks are searched in parallel from the same starting element and merged in order.
+template<typename Ty, bool omitNaN>
+static void MinMaxContiguous( const Ty* p, SizeT start, SizeT stop, bool doMin, bool doMax,
+			      DLong& minEl, DLong& maxEl)
+{
+  SizeT nEl = stop - start;
+  int nchunk = (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) ? CpuTPOOL_NTHREADS : 1;
+  if( nchunk <= 1 || nEl < (SizeT) nchunk * MINMAX_BLOCK) {
+    MinMaxBlocks<Ty, omitNaN>( p, start + 1, stop, doMin, doMax, minEl, maxEl);
+    return;
+  }
+  std::vector<DLong> minElChunk( nchunk, minEl), maxElChunk( nchunk, maxEl);
+  SizeT chunksize = nEl / nchunk;
+#pragma omp parallel for num_threads(nchunk)
+  for( int c = 0; c < nchunk; ++c) {
+    SizeT s = start + 1 + c * chunksize;
+    SizeT e = (c == nchunk - 1) ? stop : s + chunksize;
+    MinMaxBlocks<Ty, omitNaN>( p, s, e, doMin, doMax, minElChunk[ c], maxElChunk[ c]);
+  }
+  for( int c = 0; c < nchunk; ++c) {
+    if( p[ minElChunk[ c]] < p[ minEl]) minEl = minElChunk[ c];
+    if( p[ maxElChunk[ c]] > p[ maxEl]) maxEl = maxElChunk[ c];
+  }
+}
+
+// returns false (nothing done) for strings and complex
+template<typename Ty>
+static bool MinMaxContiguous( const Ty* p, SizeT start, SizeT stop, bool omitNaN, bool doMin, bool doMax,
+			      DLong& minEl, DLong& maxEl, std::true_type)
+{
+  if( omitNaN) MinMaxContiguous<Ty, true>( p, start, stop, doMin, doMax, minEl, maxEl);
+  else MinMaxContiguous<Ty, false>( p, start, stop, doMin, doMax, minEl, maxEl);
+  return true;
+}
+template<typename Ty>
+static bool MinMaxContiguous( const Ty* p, SizeT start, SizeT stop, bool omitNaN, bool doMin, bool doMax,
+			      DLong& minEl, DLong& maxEl, std::false_type)
+{
+  return false;
+}
+
 template<>
 void Data_<SpDObj>::MinMax( DLong* minE, DLong* maxE, 
 			 BaseGDL** minVal, BaseGDL** maxVal, bool omitNaN,
@@ -128,6 +128,45 @@ const string ReadElement(istream& is)
 //   return retStr;
 }
 
+// SkipWS() followed by ReadElement() into buf, working on the stream
+// buffer: no sentry and no string per character/element.
+// Streams in an unusual state (or tied to an output like cin, which
+// has to be flushed before reading) take the general path.
+void ReadElement(istream& is, string& buf)
+{
+  if( !is.good() || is.tie() != NULL)
+    {
+      buf = ReadElement( is);
+      return;
+    }
+
+  streambuf* sb = is.rdbuf();
+  buf.clear();
+  int c;
+  do {
+    c = sb->sbumpc();
+    if( c == EOF)
+      {
+	is.setstate( ios::eofbit | ios::failbit);
+	throw GDLIOException( "End of file encountered. "+
+			      StreamInfo( &is));
+      }
+  } while( c == ' ' || c == '\t' || c == '\n');
+
+  for(;;)
+    {
+      buf.push_back( static_cast<char>( c));
+      c = sb->sgetc();
+      if( c == EOF) // ReadElement() clears the state here
+	return;
+      if( c == ' ' || c == '\t')
+	return;
+      sb->sbumpc();
+      if( c == '\n')
+	return;
+    }
+}
+
 // no skip of WS
 const string ReadComplexElement(istream& is)
 {
@@ -219,10 +258,11 @@ istream& operator>>(istream& i, Data_<Sp>& data_)
 {
   long int nTrans =  data_.dd.size();
   SizeT assignIx = 0;
+  string segment;
 
   while( nTrans > 0)
     {
-      const string segment = ReadElement( i);
+      ReadElement( i, segment);
 
       const char* cStart=segment.c_str();
       char* cEnd;
@@ -246,13 +286,14 @@ istream& operator>>(istream& i, Data_<SpDFloat>& data_)
 {
   long int nTrans =  data_.dd.size();
   SizeT assignIx = 0;
+  string segment;
 
   while( nTrans > 0)
     {
-      const string segment = ReadElement( i);
+      ReadElement( i, segment);
       const char* cStart=segment.c_str();
       char* cEnd;
-      data_[ assignIx] = StrToD( cStart, &cEnd);
+      data_[ assignIx] = StrToDFast( cStart, &cEnd);
       if( cEnd == cStart)
 	{
 	  data_[ assignIx]= -1;
@@ -271,13 +312,14 @@ istream& operator>>(istream& i, Data_<SpDDouble>& data_)
 {
   long int nTrans =  data_.dd.size();
   SizeT assignIx = 0;
+  string segment;
 
   while( nTrans > 0)
     {
-      const string segment = ReadElement( i);
+      ReadElement( i, segment);
       const char* cStart=segment.c_str();
       char* cEnd;
-      data_[ assignIx] = StrToD( cStart, &cEnd);
+      data_[ assignIx] = StrToDFast( cStart, &cEnd);
       if( cEnd == cStart)
 	{
 	  data_[ assignIx]= -1;
@@ -1518,6 +1560,42 @@ int xdr_convert(XDR *xdrs, DComplexDbl *buf)
 
 
 // unformatted ***************************************** 
+
+// data is moved in blocks of this size through the swap and XDR buffers
+static const SizeT unformattedChunkBytes = 1 << 16;
+
+// reverses the byte order of n items of S bytes each, in place
+template< SizeT S>
+static void SwapBytesT( char* p, SizeT n)
+{
+  for( SizeT i = 0; i < n; ++i, p += S)
+    for( SizeT k = 0; k < S/2; ++k)
+      {
+        char c = p[ k];
+        p[ k] = p[ S-1-k];
+        p[ S-1-k] = c;
+      }
+}
+
+static void SwapBytes( char* p, SizeT n, SizeT itemSize)
+{
+  switch( itemSize)
+    {
+    case 2: SwapBytesT<2>( p, n); break;
+    case 4: SwapBytesT<4>( p, n); break;
+    case 8: SwapBytesT<8>( p, n); break;
+    default: break;
+    }
+}
+
+// read n bytes, keeping track of the position for gzipped streams
+static void ReadBlock( istream& os, char* buf, SizeT n, bool compress)
+{
+  os.read( buf, n);
+  if( compress)
+    (static_cast<igzstream&> (os)).rdbuf()->incrementPosition( n); //ugly patch to maintain position
+}
+
 template<class Sp>
 ostream& Data_<Sp>::Write( ostream& os, bool swapEndian, bool compress, XDR *xdrs ) {
   if ( os.eof( ) ) os.clear( );
@@ -1525,36 +1603,33 @@ ostream& Data_<Sp>::Write( ostream& os, bool swapEndian, bool compress, XDR *xdr
   SizeT count = dd.size( );
 
   if ( swapEndian && (sizeof (Ty) != 1) ) {
-    char* cData = reinterpret_cast<char*> (&(*this)[0]);
+    // swapped copies of the data, one block at a time
+    const SizeT itemSize = Data_<Sp>::IS_COMPLEX ? sizeof (Ty) / 2 : sizeof (Ty);
+    const char* cData = reinterpret_cast<const char*> (&(*this)[0]);
     SizeT cCount = count * sizeof (Ty);
-    if ( Data_<Sp>::IS_COMPLEX ) {
-      char *swapBuf = (char*) malloc( sizeof (char) * sizeof (Ty) / 2 );
-      for ( SizeT i = 0; i < cCount; i += sizeof (Ty) / 2 ) {
-        SizeT src = i + sizeof (Ty) / 2 - 1;
-        for ( SizeT dst = 0; dst<sizeof (Ty) / 2; dst++ ) swapBuf[dst]=cData[ src--];
-        os.write( swapBuf, sizeof (Ty) / 2 );
-      }
-      free( swapBuf );
-    } else {
-      char swapBuf[ sizeof (Ty)];
-      for ( SizeT i = 0; i < cCount; i += sizeof (Ty) ) {
-        SizeT src = i + sizeof (Ty) - 1;
-        for ( SizeT dst = 0; dst<sizeof (Ty); dst++ ) swapBuf[dst] = cData[ src--];
-        os.write( swapBuf, sizeof (Ty) );
-      }
+    SizeT chunk = (unformattedChunkBytes / sizeof (Ty)) * sizeof (Ty);
+    vector<char> swapBuf( min( chunk, cCount));
+    for ( SizeT i = 0; i < cCount && os.good( ); i += chunk ) {
+      SizeT n = min( chunk, cCount - i);
+      memcpy( &swapBuf[0], cData + i, n);
+      SwapBytes( &swapBuf[0], n / itemSize, itemSize);
+      os.write( &swapBuf[0], n);
     }
   } else if ( xdrs != NULL ) {
+    // one XDR memory stream per block of elements
     long fac = 1;
     if ( sizeof (Ty) == 2 ) fac = 2;
     SizeT bufsize = sizeof (Ty)*fac;
-    char *buf = (char *) calloc( bufsize, sizeof (char) );
-    for ( SizeT i = 0; i < count; i++ ) {
-      xdrmem_create( xdrs, buf, bufsize, XDR_ENCODE );
-      if ( !xdr_convert( xdrs, (&(*this)[i]) ) ) cerr << "Error in XDR write" << endl;
+    SizeT chunk = unformattedChunkBytes / bufsize;
+    vector<char> buf( min( chunk, count) * bufsize);
+    for ( SizeT i = 0; i < count && os.good( ); i += chunk ) {
+      SizeT n = min( chunk, count - i);
+      xdrmem_create( xdrs, &buf[0], n * bufsize, XDR_ENCODE );
+      for ( SizeT k = i; k < i + n; k++ )
+        if ( !xdr_convert( xdrs, (&(*this)[k]) ) ) cerr << "Error in XDR write" << endl;
       xdr_destroy( xdrs );
-      os.write( buf, bufsize );
+      os.write( &buf[0], n * bufsize );
     }
-    free( buf );
   } else if (compress)
   {
     (static_cast<ogzstream&>(os)).write(reinterpret_cast<char*> (&(*this)[0]), count * sizeof (Ty));
@@ -1655,53 +1730,29 @@ bool compress, XDR *xdrs ) {
   SizeT count = dd.size( );
 
   if ( swapEndian && (sizeof (Ty) != 1) ) {
-    char* cData = reinterpret_cast<char*> (&(*this)[0]);
-    SizeT cCount = count * sizeof (Ty);
-
-    if ( Data_<Sp>::IS_COMPLEX ) {
-      char *swapBuf = (char*) malloc( sizeof (char) * sizeof (Ty) / 2 );
-      for ( SizeT i = 0; i < cCount; i += sizeof (Ty) / 2 ) {
-        os.read( swapBuf, sizeof (Ty) / 2 );
-        SizeT src = i + sizeof (Ty) / 2 - 1;
-        for ( SizeT dst = 0; dst<sizeof (Ty) / 2; dst++ ) cData[ src--] = swapBuf[dst];
-      }
-      free( swapBuf );
-    } else {
-      char swapBuf[ sizeof (Ty)];
-      for ( SizeT i = 0; i < cCount; i += sizeof (Ty) ) {
-        os.read( swapBuf, sizeof (Ty) );
-        SizeT src = i + sizeof (Ty) - 1;
-        for ( SizeT dst = 0; dst<sizeof (Ty); dst++ ) cData[ src--] = swapBuf[dst];
-      }
-    }
+    // as Write: swapping takes precedence over XDR.
+    // read everything at once, then swap in place
+    ReadBlock( os, reinterpret_cast<char*> (&(*this)[0]), count * sizeof (Ty), compress);
+    const SizeT itemSize = Data_<Sp>::IS_COMPLEX ? sizeof (Ty) / 2 : sizeof (Ty);
+    SwapBytes( reinterpret_cast<char*> (&(*this)[0]), count * sizeof (Ty) / itemSize, itemSize);
   } else if ( xdrs != NULL ) {
+    // one XDR memory stream per block of elements
     long fac = 1;
     if ( sizeof (Ty) == 2 ) fac = 2;
     SizeT bufsize = sizeof (Ty)*fac;
-    char *buf = (char *) calloc( bufsize, sizeof (char) );
-    for ( SizeT i = 0; i < count; i++ ) {
-      xdrmem_create( xdrs, buf, bufsize, XDR_DECODE );
-      os.read( buf, bufsize );
-      if ( !xdr_convert( xdrs, (&(*this)[i]) ) ) cerr << "Error in XDR read" << endl;
+    SizeT chunk = unformattedChunkBytes / bufsize;
+    vector<char> buf( min( chunk, count) * bufsize);
+    for ( SizeT i = 0; i < count; i += chunk ) {
+      SizeT n = min( chunk, count - i);
+      ReadBlock( os, &buf[0], n * bufsize, compress);
+      if ( !os.good( ) ) break;
+      xdrmem_create( xdrs, &buf[0], n * bufsize, XDR_DECODE );
+      for ( SizeT k = i; k < i + n; k++ )
+        if ( !xdr_convert( xdrs, (&(*this)[k]) ) ) cerr << "Error in XDR read" << endl;
       xdr_destroy( xdrs );
     }
-    free( buf );
-  } else if ( compress )
-    /* GD: minimum (?) hack since we want to keep trace of the position in gzipped stream.*/
-  {
-    int typesize=sizeof(Ty);
-    SizeT totCount = count * typesize;
-    char curVal[typesize];    
-    for (SizeT i = 0; i < count; ++i) 
-    { 
-      for (int k=0; k<typesize; ++k) os.get(curVal[k]);
-      char* cData = reinterpret_cast<char*>(&(*this)[i]);
-      for (int k=0; k<typesize; ++k) cData[k]=curVal[k];
-    }
-    (static_cast<igzstream&> (os)).rdbuf()->incrementPosition(totCount); //ugly patch to maintain position        
-//was:    (static_cast<igzstream&>(os)).read( reinterpret_cast<char*> (&(*this)[0]), count * sizeof (Ty) );
   } else {
-    os.read( reinterpret_cast<char*> (&(*this)[0]), count * sizeof (Ty) );
+    ReadBlock( os, reinterpret_cast<char*> (&(*this)[0]), count * sizeof (Ty), compress);
   }
 
   if ( os.eof( ) )
@@ -1742,14 +1793,8 @@ istream& Data_<SpDByte>::Read( istream& os, bool swapEndian, bool compress, XDR
     if ( bufsize < nChar ) nChar = bufsize; //truncate eventually
     for ( SizeT i = 0; i < nChar; i++ ) ( *this )[i] = buf[i];
     free( buf );
-  } else if ( compress ) {
-    /* GD: minimum (?) hack since we want to keep trace of the position in gzipped stream.*/
-    char* cData = reinterpret_cast<char*> (&(*this)[0]);
-    for (SizeT i = 0; i < count; ++i) (static_cast<igzstream&> (os)).get(cData[ i]);
-    (static_cast<igzstream&> (os)).rdbuf()->incrementPosition(count); //ugly patch to maintain position
-//    (static_cast<igzstream&>(os)).read( reinterpret_cast<char*> (&(*this)[0]), count );
   } else {
-    os.read( reinterpret_cast<char*> (&(*this)[0]), count );
+    ReadBlock( os, reinterpret_cast<char*> (&(*this)[0]), count, compress);
   }
 
   if ( os.eof( ) )
@@ -1785,35 +1830,14 @@ bool compress, XDR *xdrs ) {
         (*this)[i].clear();
       } else {
         int bufsize = 4 + 4 * ((length - 1) / 4 + 1) ;
-        buf = (char *) calloc( length, sizeof (char) );
-        os.read( &buf[0], bufsize );
+        vector<char> sbuf( bufsize );
+        os.read( &sbuf[0], bufsize );
         if ( !os.good( ) ) throw GDLIOException( "Problem reading XDR file." ); //else we are correctly aligned for next read!
-        (*this)[i].assign( &buf[4], length );
-      }
-    } else {
-
-      SizeT maxLen = 1024;
-      vector<char> vbuf( maxLen );
-
-      if ( nChar > 0 ) {
-        if ( nChar > maxLen ) {
-          maxLen = nChar;
-          vbuf.resize( maxLen );
-        }
-        if ( compress ) {
-        /* GD: minimum (?) hack since we want to keep trace of the position in gzipped stream.*/
-          char c;
-          vbuf.clear( );
-          for ( SizeT i = 0; i < nChar; i++ ) {
-            (static_cast<igzstream&>(os)).get( c ); //which does nothing more than os.get(c)...
-            vbuf.push_back( c );
-          }
-          (static_cast<igzstream&>(os)).rdbuf()->incrementPosition(nChar);  //ugly patch to maintain position        
-        } else {
-          os.read( &vbuf[0], nChar );
-        }
-        (*this)[i].assign( &vbuf[0], nChar );
+        (*this)[i].assign( &sbuf[4], length );
       }
+    } else if ( nChar > 0 ) {
+      // the string keeps its length, read straight into it
+      ReadBlock( os, &(*this)[i][0], nChar, compress);
     }
   }
 
@@ -1827,10 +1851,54 @@ bool compress, XDR *xdrs ) {
   return os;
 }
 
+// for structs with numeric tags only: the bytes of each tag of one element
+// in the file (packed, without the memory alignment) and their swap unit
+static bool NumericTagLayout( DStructDesc* desc, vector<SizeT>& tagBytes,
+                              vector<SizeT>& itemSize, SizeT& recBytes)
+{
+  SizeT nTags = desc->NTags( );
+  tagBytes.resize( nTags);
+  itemSize.resize( nTags);
+  recBytes = 0;
+  for ( SizeT t = 0; t < nTags; ++t ) {
+    const BaseGDL* tag = (*desc)[t];
+    if ( !NumericType( tag->Type( ) ) ) return false;
+    tagBytes[t] = tag->NBytes( );
+    itemSize[t] = ComplexType( tag->Type( ) ) ? tag->Sizeof( ) / 2 : tag->Sizeof( );
+    recBytes += tagBytes[t];
+  }
+  return recBytes > 0;
+}
+
 ostream& DStructGDL::Write( ostream& os, bool swapEndian,
 bool compress, XDR *xdrs ) {
   SizeT nEl = N_Elements( );
   SizeT nTags = NTags( );
+
+  vector<SizeT> tagBytes, itemSize;
+  SizeT recBytes;
+  if ( xdrs == NULL && NumericTagLayout( Desc( ), tagBytes, itemSize, recBytes ) ) {
+    // gather whole elements into a block, then a single write
+    if ( os.eof( ) ) os.clear( );
+    SizeT chunk = max( unformattedChunkBytes / recBytes, static_cast<SizeT>( 1));
+    vector<char> buf( min( chunk, nEl) * recBytes);
+    for ( SizeT i = 0; i < nEl && os.good( ); i += chunk ) {
+      SizeT n = min( chunk, nEl - i);
+      char* dst = &buf[0];
+      for ( SizeT k = i; k < i + n; ++k )
+        for ( SizeT t = 0; t < nTags; ++t ) {
+          memcpy( dst, Buf( ) + Desc( )->Offset( t, k), tagBytes[t]);
+          if ( swapEndian ) SwapBytes( dst, tagBytes[t] / itemSize[t], itemSize[t]);
+          dst += tagBytes[t];
+        }
+      os.write( &buf[0], n * recBytes);
+    }
+    if ( !os.good( ) ) {
+      throw GDLIOException( "Error writing data." );
+    }
+    return os;
+  }
+
   for ( SizeT i = 0; i < nEl; ++i )
     for ( SizeT t = 0; t < nTags; ++t )
       GetTag( t, i )->Write( os, swapEndian, compress, xdrs );
@@ -1841,6 +1909,36 @@ istream& DStructGDL::Read( istream& os, bool swapEndian,
 bool compress, XDR *xdrs ) {
   SizeT nEl = N_Elements( );
   SizeT nTags = NTags( );
+
+  vector<SizeT> tagBytes, itemSize;
+  SizeT recBytes;
+  if ( xdrs == NULL && NumericTagLayout( Desc( ), tagBytes, itemSize, recBytes ) ) {
+    // one read per block of elements, then scattered into the tags
+    if ( os.eof( ) )
+      throw GDLIOException( "End of file encountered." );
+    SizeT chunk = max( unformattedChunkBytes / recBytes, static_cast<SizeT>( 1));
+    vector<char> buf( min( chunk, nEl) * recBytes);
+    for ( SizeT i = 0; i < nEl; i += chunk ) {
+      SizeT n = min( chunk, nEl - i);
+      ReadBlock( os, &buf[0], n * recBytes, compress);
+      if ( !os.good( ) ) break;
+      const char* src = &buf[0];
+      for ( SizeT k = i; k < i + n; ++k )
+        for ( SizeT t = 0; t < nTags; ++t ) {
+          char* dst = Buf( ) + Desc( )->Offset( t, k);
+          memcpy( dst, src, tagBytes[t]);
+          if ( swapEndian ) SwapBytes( dst, tagBytes[t] / itemSize[t], itemSize[t]);
+          src += tagBytes[t];
+        }
+    }
+    if ( os.eof( ) )
+      throw GDLIOException( "End of file encountered." );
+    if ( !os.good( ) ) {
+      throw GDLIOException( "Error reading data." );
+    }
+    return os;
+  }
+
   for ( SizeT i = 0; i < nEl; ++i )
     for ( SizeT t = 0; t < nTags; ++t )
       GetTag( t, i )->Read( os, swapEndian, compress, xdrs );
@@ -167,8 +167,6 @@ protected:
 	       DPtrGDL* ptr);
   static void AddObj( DPtrListT& ptrAccessible, DPtrListT& objAccessible, 
 	       DObjGDL* obj);
-  static void Add( DPtrListT& ptrAccessible, DPtrListT& objAccessible, 
-	    BaseGDL* p);
   
   // definition in list.cpp
   static void AddLIST( DPtrListT& ptrAccessible,
@@ -190,6 +188,9 @@ public:
   void PushNewEmptyEnvUD(  DSubUD* newPro, DObjGDL** newObj = NULL);
 //   void PushNewEmptyEnvUDWithExtra(  DSubUD* newPro, BaseGDL** newObj = NULL);
   
+  // heap variables accessible from p (also used by RESTORE)
+  static void Add( DPtrListT& ptrAccessible, DPtrListT& objAccessible, 
+	    BaseGDL* p);
   void AddEnv( DPtrListT& ptrAccessible, DPtrListT& objAccessible);
   void AddToDestroy( DPtrListT& ptrAccessible, DPtrListT& objAccessible);
 
@@ -150,6 +150,52 @@ namespace lib {
   }
 
 
+  // linear cross-correlation of two real sequences of length n:
+  // res[ L+n-1] = sum_k a[k]*b[k+L], L = -(n-1),...,n-1 (2n-1 values).
+  // Zero padded to 2n so that the circular correlation does not wrap.
+  // Planning is not thread safe: call from a serial region.
+  void fftw_real_correlation( const double* a, const double* b, SizeT n, double* res)
+  {
+    SizeT m = 2 * n;
+    SizeT mc = m / 2 + 1;
+    double* buf = static_cast<double*>( fftw_malloc( sizeof( double) * m));
+    fftw_complex* fa = static_cast<fftw_complex*>( fftw_malloc( sizeof( fftw_complex) * mc));
+    fftw_complex* fb = static_cast<fftw_complex*>( fftw_malloc( sizeof( fftw_complex) * mc));
+
+    fftw_plan pa = fftw_plan_dft_r2c_1d( (int) m, buf, fa, FFTW_ESTIMATE);
+    fftw_plan pb = fftw_plan_dft_r2c_1d( (int) m, buf, fb, FFTW_ESTIMATE);
+    fftw_plan pc = fftw_plan_dft_c2r_1d( (int) m, fa, buf, FFTW_ESTIMATE);
+
+    for( SizeT i = 0; i < n; ++i) buf[ i] = a[ i];
+    for( SizeT i = n; i < m; ++i) buf[ i] = 0.;
+    fftw_execute( pa);
+    for( SizeT i = 0; i < n; ++i) buf[ i] = b[ i];
+    for( SizeT i = n; i < m; ++i) buf[ i] = 0.;
+    fftw_execute( pb);
+
+    // conj(A)*B, scaled for the unnormalized inverse transform
+    for( SizeT i = 0; i < mc; ++i)
+      {
+	double re = fa[ i][ 0] * fb[ i][ 0] + fa[ i][ 1] * fb[ i][ 1];
+	double im = fa[ i][ 0] * fb[ i][ 1] - fa[ i][ 1] * fb[ i][ 0];
+	fa[ i][ 0] = re / m;
+	fa[ i][ 1] = im / m;
+      }
+    fftw_execute( pc); // c2r destroys its input, fa is not used anymore
+
+    // lag L is at index L (L >= 0) or m+L (L < 0)
+    for( SizeT i = 0; i < n-1; ++i) res[ i] = buf[ m - (n-1) + i];
+    for( SizeT i = 0; i < n; ++i) res[ n-1 + i] = buf[ i];
+
+    fftw_destroy_plan( pc);
+    fftw_destroy_plan( pb);
+    fftw_destroy_plan( pa);
+    fftw_free( fb);
+    fftw_free( fa);
+    fftw_free( buf);
+  }
+
+
   BaseGDL* fftw_fun( EnvT* e)
   {
     SizeT nParam=e->NParam();
@@ -30,6 +30,9 @@ namespace lib {
 
   BaseGDL* fftw_fun( EnvT* e);
 
+  // used by C_CORRELATE/A_CORRELATE for long lag lists
+  void fftw_real_correlation( const double* a, const double* b, SizeT n, double* res);
+
 } // namespace
 
 
@@ -40,6 +40,14 @@
 
 
 #include <zlib.h>
+#include <vector>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#	include <sys/mman.h>
+#endif
+#if defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
 
 #include <climits> // PATH_MAX
 //patch #90
@@ -1983,6 +1991,126 @@ static void PathSearch( FileListT& fileList,  const DString& pathSpec,
     return res;
   }
 
+  // line ends in a block of text: CR, LF, and CR LF pairs, which end one
+  // line only; prev is the character before the block (0 at the start of
+  // the file), as a pair may straddle two blocks
+  struct LineEnds
+  {
+    SizeT cr, lf, crlf;
+    LineEnds(): cr( 0), lf( 0), crlf( 0) {}
+  };
+
+  static void CountLineEnds( const char* p, SizeT n, char prev, LineEnds& c)
+  {
+    if( n == 0)
+      return;
+    if( p[ 0] == '\n')
+      {
+	c.lf++;
+	if( prev == '\r') c.crlf++;
+      }
+    else if( p[ 0] == '\r')
+      c.cr++;
+    SizeT i = 1;
+#if defined(__SSE2__)
+    // 16 characters at a time, the CR of a pair is found in the same
+    // block loaded one character earlier
+    const __m128i vLF = _mm_set1_epi8( '\n');
+    const __m128i vCR = _mm_set1_epi8( '\r');
+    for( ; i + 16 <= n; i += 16)
+      {
+	__m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p + i));
+	__m128i w = _mm_loadu_si128( reinterpret_cast<const __m128i*>( p + i - 1));
+	unsigned lf = _mm_movemask_epi8( _mm_cmpeq_epi8( v, vLF));
+	unsigned cr = _mm_movemask_epi8( _mm_cmpeq_epi8( v, vCR));
+	unsigned pcr = _mm_movemask_epi8( _mm_cmpeq_epi8( w, vCR));
+	c.lf += __builtin_popcount( lf);
+	c.cr += __builtin_popcount( cr);
+	c.crlf += __builtin_popcount( lf & pcr);
+      }
+#endif
+    for( ; i < n; ++i)
+      {
+	if( p[ i] == '\n')
+	  {
+	    c.lf++;
+	    if( p[ i - 1] == '\r') c.crlf++;
+	  }
+	else if( p[ i] == '\r')
+	  c.cr++;
+      }
+  }
+
+  // FILE_LINES of one file: lines end with CR, LF or CR LF, and a last
+  // line without end counts too. Plain files are memory mapped and counted
+  // in parallel blocks, gzip files (and what cannot be mapped) are read in
+  // large blocks. Returns false if the file cannot be opened.
+  static bool CountFileLines( const string& name, SizeT& lines)
+  {
+    LineEnds c;
+    char last = 0;
+    SizeT size = 0;
+    bool done = false;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    int fd = open( name.c_str(), O_RDONLY);
+    if( fd < 0)
+      return false;
+    struct stat st;
+    unsigned char magic[ 2];
+    if( fstat( fd, &st) == 0 && S_ISREG( st.st_mode) && st.st_size > 0 &&
+	!(pread( fd, magic, 2, 0) == 2 && magic[ 0] == 0x1f && magic[ 1] == 0x8b))
+      {
+	void* addr = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if( addr != MAP_FAILED)
+	  {
+	    const char* p = static_cast<const char*>( addr);
+	    size = st.st_size;
+	    const SizeT block = 1 << 24;
+	    OMPInt nBlocks = (size + block - 1) / block;
+	    SizeT cr = 0, lf = 0, crlf = 0;
+#pragma omp parallel for reduction(+:cr,lf,crlf) if (size >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= size))
+	    for( OMPInt b = 0; b < nBlocks; ++b)
+	      {
+		SizeT start = b * block;
+		LineEnds bc;
+		CountLineEnds( p + start, (size - start < block) ? size - start : block,
+			       (start > 0) ? p[ start - 1] : 0, bc);
+		cr += bc.cr;
+		lf += bc.lf;
+		crlf += bc.crlf;
+	      }
+	    c.cr = cr;
+	    c.lf = lf;
+	    c.crlf = crlf;
+	    last = p[ size - 1];
+	    munmap( addr, size);
+	    done = true;
+	  }
+      }
+    close( fd);
+#endif
+    if( !done)
+      {
+	// zlib reads uncompressed files as well
+	gzFile gfd = gzopen( name.c_str(), "rb");
+	if( gfd == NULL)
+	  return false;
+	vector<char> buf( 1 << 20);
+	int n;
+	while( (n = gzread( gfd, &buf[ 0], buf.size())) > 0)
+	  {
+	    CountLineEnds( &buf[ 0], n, last, c);
+	    last = buf[ n - 1];
+	    size += n;
+	  }
+	gzclose( gfd);
+      }
+    lines = c.cr + c.lf - c.crlf;
+    if( size > 0 && last != '\n' && last != '\r')
+      lines++;
+    return true;
+  }
+
   BaseGDL* file_lines( EnvT* e) {
     SizeT nParam = e->NParam(1); //, "FILE_LINES");
     DStringGDL* p0S = e->GetParAs<DStringGDL>(0); //, "FILE_LINES");
@@ -1995,37 +2123,37 @@ static void PathSearch( FileListT& fileList,  const DString& pathSpec,
     bool compressed = e->KeywordSet(compressIx); // we actually don't use it. zlib does it all for us!
     static int noExpIx = e->KeywordIx("NOEXPAND_PATH");
     bool noExp = e->KeywordSet(noExpIx);
-    
-    DLongGDL* res = new DLongGDL( p0S->Dim(), BaseGDL::NOZERO);
 
-    gzFile gfd = NULL;
-    char newinput, lastchar = 0;
-    SizeT lines;
+    // the total size decides whether the files are counted in parallel
+    vector<string> fname( nEl);
+    SizeT totalSize = 0;
+    for( SizeT i=0; i<nEl; ++i)
+    {
+      fname[ i] = (*p0S)[i];
+      if (!noExp) WordExp(fname[ i]);
+      struct stat64 statStruct;
+      if( stat64( fname[ i].c_str(), &statStruct) == 0)
+        totalSize += statStruct.st_size;
+    }
 
-      for( SizeT i=0; i<nEl; ++i)
+    // the files in parallel (a single one is counted in parallel blocks)
+    DLongGDL* res = new DLongGDL( p0S->Dim(), BaseGDL::NOZERO);
+    Guard<DLongGDL> res_guard( res);
+    vector<char> failed( nEl, 0);
+#pragma omp parallel for schedule(dynamic) if (nEl > 1 && CpuTPOOL_NTHREADS > 1 && totalSize >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= totalSize))
+    for( OMPInt i=0; i<nEl; ++i)
     {
-          std::string fname = (*p0S)[i];
-
-          if (!noExp) WordExp(fname);
-
-          if ((gfd = gzopen(fname.c_str(), "rb")) == NULL) {
-              e->Throw("Could not open file for reading ");// + p0[i]);
-          }
-          lines = 0;
-          while (gzread(gfd, &newinput, 1) == 1) {
-              if (newinput == '\r') lines++;
-              if (newinput == '\n') lines++;
-//                  if (newinput == '\r' && lastchar == '\n') length--;
-              if (newinput == '\n' && lastchar == '\r') lines--;
-              lastchar = newinput;
-          }
-          gzclose(gfd);
-      if (lastchar != '\n' && lastchar != '\r') lines++;
-
-      (*res)[ i] = lines;
+      SizeT lines;
+      if( CountFileLines( fname[ i], lines))
+        (*res)[ i] = lines;
+      else
+        failed[ i] = 1;
     }
+    for( SizeT i=0; i<nEl; ++i)
+      if( failed[ i])
+        e->Throw("Could not open file for reading: " + fname[ i]);
 
-    return res;
+    return res_guard.release();
   }
 
 
@@ -23,6 +23,7 @@
 // #include "dstructgdl.hpp"
 // #include "real2int.hpp"
 #include "ofmt.hpp" // OutAuto
+#include "num2str.hpp"
 // 
 // #include "dinterpreter.hpp"
 
@@ -31,17 +32,13 @@ using namespace std;
 // for double -> string
 inline string double2string( DDouble d)      
 {
-  std::ostringstream os;
-  OutAuto( os, d, 16, 8, ' ');
-  return os.str();
+  return Auto2String( d, 16, 8);
 }
 
 // for float -> string
 inline string float2string( DFloat f)      
 {
-  std::ostringstream os;
-  OutAuto( os, f, 13, 6, ' ');
-  return os.str();
+  return Auto2String( f, 13, 6);
 }
 
 
@@ -115,42 +112,42 @@ template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDInt>::GetAs<SpDString>( SizeT i)
   {
-    return i2s<>(this->dd[ i],8);
+    return Int2String(this->dd[ i],8);
   }
 // DUIntGDL full specializations  
 template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDUInt>::GetAs<SpDString>( SizeT i)
   {
-    return i2s<>(this->dd[ i],8);
+    return Int2String(this->dd[ i],8);
   }
 // DLongGDL full specializations  
 template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDLong>::GetAs<SpDString>( SizeT i)
   {
-    return i2s<>(this->dd[ i],12);
+    return Int2String(this->dd[ i],12);
   }
 // DULongGDL full specializations  
 template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDULong>::GetAs<SpDString>( SizeT i)
   {
-    return i2s<>(this->dd[ i],12);
+    return Int2String(this->dd[ i],12);
   }
 // DLong64GDL full specializations  
 template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDLong64>::GetAs<SpDString>( SizeT i)
   {
-    return i2s<>(this->dd[ i],22);
+    return Int2String(this->dd[ i],22);
   }
 // DULong64GDL full specializations  
 template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDULong64>::GetAs<SpDString>( SizeT i)
   {
-    return i2s<>(this->dd[ i],22);
+    return Int2String(this->dd[ i],22);
   }
 
   
@@ -483,7 +480,7 @@ template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDComplex>::GetAs<SpDString>( SizeT i)
   {
-    return "("+i2s(real((*this)[i]))+","+i2s(imag((*this)[i]))+")";
+    return "("+Real2String(real((*this)[i]))+","+Real2String(imag((*this)[i]))+")";
   }
   
 
@@ -547,7 +544,7 @@ template<>
 template<> 
 /*typename*/ Data_<SpDString>::Ty Data_<SpDComplexDbl>::GetAs<SpDString>( SizeT i)
   {
-    return "("+i2s(real((*this)[i]))+","+i2s(imag((*this)[i]))+")";
+    return "("+Real2String(real((*this)[i]))+","+Real2String(imag((*this)[i]))+")";
   }
 
 #endif
@@ -29,11 +29,14 @@
 
 #include <antlr/ASTFactory.hpp>
 
+#include <list>
+#include <map>
+
 using namespace std;
 
 antlr::ASTFactory FMTNodeFactory("FMTNode",FMTNode::factory);
 
-RefFMTNode GetFMTAST( DString fmtString)
+static RefFMTNode ParseFMT( const DString& fmtString)
 {
   istringstream istr(fmtString); //+"\n");
 
@@ -87,3 +90,32 @@ RefFMTNode GetFMTAST( DString fmtString)
 
   return fmtAST;
 }
+
+// the trees are never modified by FMTOut/FMTIn: formats used again (in
+// a loop, for every row of a table) are parsed only once.
+// Least recently used entries are dropped first.
+static const SizeT fmtCacheSize = 128;
+typedef list< pair< DString, RefFMTNode> > FMTCacheList;
+static FMTCacheList fmtCacheList; // most recently used first
+static map< DString, FMTCacheList::iterator> fmtCacheMap;
+
+RefFMTNode GetFMTAST( DString fmtString)
+{
+  map< DString, FMTCacheList::iterator>::iterator it = fmtCacheMap.find( fmtString);
+  if( it != fmtCacheMap.end())
+    {
+      fmtCacheList.splice( fmtCacheList.begin(), fmtCacheList, it->second);
+      return it->second->second;
+    }
+
+  RefFMTNode fmtAST = ParseFMT( fmtString); // throws on syntax errors
+
+  fmtCacheList.push_front( make_pair( fmtString, fmtAST));
+  fmtCacheMap[ fmtString] = fmtCacheList.begin();
+  if( fmtCacheList.size() > fmtCacheSize)
+    {
+      fmtCacheMap.erase( fmtCacheList.back().first);
+      fmtCacheList.pop_back();
+    }
+  return fmtAST;
+}
@@ -19,6 +19,8 @@
 
 #include <map>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 //fx_root
 #include <stdio.h>
@@ -49,7 +51,6 @@
 #include <gsl/gsl_fft_complex_float.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
-#include <gsl/gsl_histogram.h>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_spline.h>
 #include <gsl/gsl_multimin.h>
@@ -1273,20 +1274,310 @@ namespace lib {
   // http://sourceforge.net/tracker/?func=detail&aid=3602623&group_id=97659&atid=618683
   // GSL bug report thread 
   // http://lists.gnu.org/archive/html/bug-gsl/2013-02/msg00006.html
+  //
+  // The gsl_histogram object is not used anymore, but the bin ranges are still
+  // computed as in gdl_make_uniform(), and HistoRange::Find() returns the same
+  // bin as gsl_histogram_find() would (range[i] <= x < range[i+1]). The bin is
+  // computed directly from x and only corrected against the ranges.
+  class HistoRange
+  {
+    std::vector<double> range;
+    SizeT nbins;
+    double width;
+    double maxVal;
+
+  public:
+    HistoRange( SizeT n, double xmin, double xmax, double maxV)
+      : range( n + 1), nbins( n), width( (xmax - xmin) / n), maxVal( maxV)
+    {
+      for( SizeT i = 0; i <= n; ++i)
+	range[i] = xmin + (double) i * (xmax - xmin) / ((double) n);
+    }
+
+    SizeT NBins() const { return nbins;}
+
+    // false for values out of [range[0],range[nbins]) or above MAX (and NaN)
+    inline bool Find( double x, SizeT& bin) const
+    {
+      if( !(x >= range[0] && x < range[nbins] && x <= maxVal))
+	return false;
+      SizeT i = static_cast<SizeT>( (x - range[0]) / width);
+      if( i >= nbins) i = nbins - 1;
+      while( i > 0 && x < range[i]) --i;
+      while( x >= range[i + 1]) ++i;
+      bin = i;
+      return true;
+    }
+  };
+
+  // generic binner: direct computation on the value (no converted copy of
+  // the input is made)
+  template< typename Ty, bool smallInt = (sizeof( Ty) <= 2)>
+  class HistoBinner
+  {
+    const HistoRange& r;
+
+  public:
+    explicit HistoBinner( const HistoRange& r_): r( r_) {}
+
+    inline bool operator()( Ty v, SizeT& bin) const
+    {
+      return r.Find( static_cast<double>( v), bin);
+    }
+  };
+
+  // BYTE, INT and UINT: the bin of every possible value is tabulated once
+  template< typename Ty>
+  class HistoBinner< Ty, true>
+  {
+    std::vector<DLong> lut;
+
+  public:
+    explicit HistoBinner( const HistoRange& r)
+      : lut( static_cast<SizeT>( 1) << (8 * sizeof( Ty)))
+    {
+      for( SizeT v = 0; v < lut.size(); ++v)
+	{
+	  Ty x = static_cast<Ty>( static_cast<DLong>( v) + 
+				  std::numeric_limits<Ty>::min());
+	  SizeT bin;
+	  lut[v] = r.Find( static_cast<double>( x), bin) ? static_cast<DLong>( bin) : -1;
+	}
+    }
+
+    inline bool operator()( Ty v, SizeT& bin) const
+    {
+      DLong b = lut[ static_cast<SizeT>( static_cast<DLong>( v) - 
+					 std::numeric_limits<Ty>::min())];
+      if( b < 0)
+	return false;
+      bin = b;
+      return true;
+    }
+  };
+
+  // HISTOGRAM element binner
+  template< typename Ty>
+  class HistoElementBinner
+  {
+    const Ty* dd;
+    HistoBinner<Ty> binner;
+
+  public:
+    HistoElementBinner( const Ty* dd_, const HistoRange& r): dd( dd_), binner( r) {}
+
+    inline bool operator()( SizeT j, SizeT& bin) const { return binner( dd[j], bin);}
+  };
 
-  static void gdl_make_uniform (gsl_histogram * h, size_t n, double xmin, double xmax)
+  // number of chunks the input is split into for counting: private bin
+  // arrays only pay off when they are smaller than the input
+  static SizeT histogram_nchunk( SizeT nEl, SizeT nbins)
   {
-    size_t i;
-    for (i = 0; i <= n; i++)
-      h->range[i] = xmin +  (double) i * (xmax-xmin)/((double) n);
+    if( nEl < CpuTPOOL_MIN_ELTS || (CpuTPOOL_MAX_ELTS != 0 && CpuTPOOL_MAX_ELTS > nEl))
+      return 1;
+    SizeT nChunk = CpuTPOOL_NTHREADS;
+    if( nChunk > nEl / nbins) nChunk = nEl / nbins;
+    return (nChunk < 1) ? 1 : nChunk;
+  }
+
+  // Counts the elements j (0 <= j < nEl) into the bins given by
+  // binner( j, bin) (which returns false for elements to skip), shared by
+  // HISTOGRAM, HIST_ND and HIST_2D.
+  // Each chunk of the input counts into its own private bin array. The
+  // private arrays are summed into res (which holds INPUT or zero) and, if
+  // REVERSE_INDICES is requested, turned into per-chunk write offsets for a
+  // counting sort: a second pass over each chunk then scatters the indices
+  // in parallel, in ascending order within each bin.
+  // When there are too many bins for private arrays, the counts go to res
+  // with atomic updates.
+  template< typename Binner, typename ResGDL>
+  static void histogram_chunks( SizeT nEl, SizeT nbins, const Binner& binner,
+				ResGDL* res, ResGDL** revind)
+  {
+    typedef typename ResGDL::Ty ResTy;
+
+    SizeT nChunk = histogram_nchunk( nEl, nbins);
+
+    if( nChunk == 1 && revind == NULL && CpuTPOOL_NTHREADS > 1 &&
+	(nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)))
+      {
+	ResTy* r = &(*res)[0];
+#pragma omp parallel for
+	for( OMPInt j = 0; j < nEl; ++j)
+	  {
+	    SizeT bin;
+	    if( binner( j, bin))
+	      {
+#pragma omp atomic
+		++r[bin];
+	      }
+	  }
+	return;
+      }
+
+    SizeT chunkSize = nEl / nChunk;
+
+    std::vector<SizeT> counts( nChunk * nbins, 0);
+
+#pragma omp parallel for num_threads( nChunk) if( nChunk > 1)
+    for( OMPInt c = 0; c < nChunk; ++c)
+      {
+	SizeT* cnt = &counts[ c * nbins];
+	SizeT lo = c * chunkSize;
+	SizeT hi = (c == nChunk - 1) ? nEl : lo + chunkSize;
+	SizeT bin;
+	for( SizeT j = lo; j < hi; ++j)
+	  if( binner( j, bin)) ++cnt[bin];
+      }
+
+    SizeT k = 0;
+    for( SizeT i = 0; i < nbins; ++i)
+      {
+	SizeT n = 0;
+	for( SizeT c = 0; c < nChunk; ++c) n += counts[ c * nbins + i];
+	(*res)[i] += static_cast<ResTy>( n);
+	k += n;
+      }
+
+    if( revind == NULL)
+      return;
+
+    SizeT nri = nbins + k + 1;
+    ResGDL* ri = new ResGDL( dimension( nri), BaseGDL::NOZERO);
+
+    SizeT pos = nbins + 1;
+    for( SizeT i = 0; i < nbins; ++i)
+      {
+	(*ri)[i] = static_cast<ResTy>( pos);
+	for( SizeT c = 0; c < nChunk; ++c)
+	  {
+	    SizeT n = counts[ c * nbins + i];
+	    counts[ c * nbins + i] = pos;
+	    pos += n;
+	  }
+      }
+    (*ri)[nbins] = static_cast<ResTy>( pos);
+
+#pragma omp parallel for num_threads( nChunk) if( nChunk > 1)
+    for( OMPInt c = 0; c < nChunk; ++c)
+      {
+	SizeT* off = &counts[ c * nbins];
+	SizeT lo = c * chunkSize;
+	SizeT hi = (c == nChunk - 1) ? nEl : lo + chunkSize;
+	SizeT bin;
+	for( SizeT j = lo; j < hi; ++j)
+	  if( binner( j, bin)) (*ri)[ off[bin]++] = static_cast<ResTy>( j);
+      }
+
+    *revind = ri;
   }
 
+  // same as histogram_chunks() (without REVERSE_INDICES) summing weights[j]
+  // instead of counting
+  template< typename Binner>
+  static void histogram_weighted( SizeT nEl, SizeT nbins, const Binner& binner,
+				  const DDouble* weights, DDoubleGDL* res)
+  {
+    SizeT nChunk = histogram_nchunk( nEl, nbins);
+    DDouble* r = &(*res)[0];
+
+    if( nChunk == 1 && CpuTPOOL_NTHREADS > 1 &&
+	(nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)))
+      {
+#pragma omp parallel for
+	for( OMPInt j = 0; j < nEl; ++j)
+	  {
+	    SizeT bin;
+	    if( binner( j, bin))
+	      {
+#pragma omp atomic
+		r[bin] += weights[j];
+	      }
+	  }
+	return;
+      }
+
+    SizeT chunkSize = nEl / nChunk;
+
+    std::vector<DDouble> sums( nChunk * nbins, 0.0);
+
+#pragma omp parallel for num_threads( nChunk) if( nChunk > 1)
+    for( OMPInt c = 0; c < nChunk; ++c)
+      {
+	DDouble* sum = &sums[ c * nbins];
+	SizeT lo = c * chunkSize;
+	SizeT hi = (c == nChunk - 1) ? nEl : lo + chunkSize;
+	SizeT bin;
+	for( SizeT j = lo; j < hi; ++j)
+	  if( binner( j, bin)) sum[bin] += weights[j];
+      }
+
+    for( SizeT i = 0; i < nbins; ++i)
+      for( SizeT c = 0; c < nChunk; ++c) r[i] += sums[ c * nbins + i];
+  }
+
+  template< typename ResGDL>
+  static void histogram_dispatch( BaseGDL* p0, const HistoRange& range,
+				  ResGDL* res, ResGDL** revind)
+  {
+    SizeT nEl = p0->N_Elements();
+    SizeT nbins = range.NBins();
+    switch( p0->Type())
+      {
+      case GDL_BYTE:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DByte>
+			  ( static_cast<DByte*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_INT:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DInt>
+			  ( static_cast<DInt*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_UINT:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DUInt>
+			  ( static_cast<DUInt*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_LONG:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DLong>
+			  ( static_cast<DLong*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_ULONG:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DULong>
+			  ( static_cast<DULong*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_LONG64:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DLong64>
+			  ( static_cast<DLong64*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_ULONG64:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DULong64>
+			  ( static_cast<DULong64*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_FLOAT:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DFloat>
+			  ( static_cast<DFloat*>( p0->DataAddr()), range), res, revind);
+	break;
+      case GDL_DOUBLE:
+	histogram_chunks( nEl, nbins, HistoElementBinner<DDouble>
+			  ( static_cast<DDouble*>( p0->DataAddr()), range), res, revind);
+	break;
+      default:
+	assert( false);
+      }
+  }
+
+  static DDouble histogram_element( BaseGDL* p0, DLong ix)
+  {
+    DDoubleGDL* v = static_cast<DDoubleGDL*>
+      ( p0->NewIx( ix)->Convert2( GDL_DOUBLE, BaseGDL::CONVERT));
+    DDouble ret = (*v)[0];
+    GDLDelete( v);
+    return ret;
+  }
 
   BaseGDL* histogram_fun( EnvT* e)
   {
     double a;
     double b;
-    DULong nri;
 
     SizeT nParam=e->NParam(1);
 
@@ -1295,11 +1586,20 @@ namespace lib {
     if (p0->Rank() == 0) 
       e->Throw( "Expression must be an array in this context: " + e->GetParString(0));
 
-    SizeT nEl = p0->N_Elements();
-
     if( p0->Type() == GDL_COMPLEX || p0->Type() == GDL_COMPLEXDBL)
       e->Throw( "Complex expression not allowed in this context: "
 		+e->GetParString(0));
+
+    // the binning is done on the integer and float types, a STRING is
+    // converted to DOUBLE (OMAX, OMIN and LOCATIONS keep its type)
+    DType p0Type = p0->Type();
+    Guard<BaseGDL> p0Guard;
+    if( p0Type == GDL_STRING)
+      {
+	p0 = p0->Convert2( GDL_DOUBLE, BaseGDL::COPY);
+	p0Guard.Reset( p0);
+      }
+
     static int binsizeIx=e->KeywordIx("BINSIZE");
     BaseGDL* binsizeKW = e->GetKW(binsizeIx);
     DDouble bsize = 1.0;
@@ -1329,42 +1629,21 @@ namespace lib {
     if( binsizeKW != NULL && nbinsKW != NULL && maxKW != NULL)
       e->Throw( "Conflicting keywords.");
 
-    DDoubleGDL *p0D;
-    Guard<BaseGDL> guard;
-    if( p0->Type() != GDL_DOUBLE)
-      {
-	p0D = static_cast<DDoubleGDL*>(p0->Convert2( GDL_DOUBLE, BaseGDL::COPY));
-	guard.Init( p0D);
-      }
-    else
-      {
-	p0D = static_cast<DDoubleGDL*>(p0);
-      }
-    // get min max
-    // use MinMax here when NAN will be supported
-
+    // get min max (on the input type, no converted copy is made)
     DDouble minVal, maxVal;
+    DLong minEl, maxEl;
 
     static int nanIx=e->KeywordIx("NAN");
     if( e->KeywordSet(nanIx)) {
-      DLong minEl, maxEl;
-      p0D->MinMax( &minEl, &maxEl, NULL, NULL, true);
-      minVal=(*p0D)[minEl];
-      maxVal=(*p0D)[maxEl];
+      p0->MinMax( &minEl, &maxEl, NULL, NULL, true);
+      minVal=histogram_element( p0, minEl);
+      maxVal=histogram_element( p0, maxEl);
     } else {
-      minVal = (*p0D)[0];
-      maxVal = minVal;
-      for( SizeT i=1; i<nEl; ++i) {
-	if (!isfinite((*p0D)[i])) {
-	  if (!isnan((*p0D)[i])) {
-	    e->Throw("Array has too many elements (Infinite value encoutered).");
-	  };
-	}
-	if ((*p0D)[i] < minVal) 
-	  minVal = (*p0D)[i];
-	else if ((*p0D)[i] > maxVal) 
-	  maxVal = (*p0D)[i];
-      }
+      p0->MinMax( &minEl, &maxEl, NULL, NULL, false);
+      minVal=histogram_element( p0, minEl);
+      maxVal=histogram_element( p0, maxEl);
+      if ((!isfinite(minVal) && !isnan(minVal)) || (!isfinite(maxVal) && !isnan(maxVal)))
+	e->Throw("Array has too many elements (Infinite value encoutered).");
     }
 
     int debug=0;
@@ -1409,7 +1688,7 @@ namespace lib {
     if( bsize < 0 || a > b || !isfinite(a) || !isfinite(b))
       e->Throw( "Illegal binsize or max/min.");
 
-    // gsl histogram needs this adjustment
+    // the bin ranges need this adjustment
     double aOri = a, bOri = b;
     a = nexttoward(a, -DBL_MAX);
     b = nexttoward(b, DBL_MAX);
@@ -1418,142 +1697,80 @@ namespace lib {
     if( nbinsKW == NULL)
       nbins = static_cast< DLong>( floor( (b - a) / bsize) + 1);
 
+    // L64: LONG64 result and REVERSE_INDICES. An INPUT of 64 bit integer
+    // type implies it, so that accumulating (e.g. over chunks of a file read
+    // one after the other) does not overflow.
+    static int l64Ix = e->KeywordIx("L64");
+    bool l64 = e->KeywordSet(l64Ix);
+
     // INPUT keyword
     static int inputIx = e->KeywordIx("INPUT"); 
-    DLongGDL* input = e->IfDefGetKWAs<DLongGDL>( inputIx);
-    if (input != NULL) {
-      if (input->N_Elements() < nbins)
+    BaseGDL* inputKW = e->GetKW( inputIx);
+    if (inputKW != NULL) {
+      if (inputKW->Type() == GDL_LONG64 || inputKW->Type() == GDL_ULONG64)
+	l64 = true;
+      if (inputKW->N_Elements() < nbins)
 	e->Throw("Expression " +e->GetString(inputIx) + 
 		 " does not have enough elements.");
-      else if (input->N_Elements() > nbins)
-	nbins = input->N_Elements();
+      else if (inputKW->N_Elements() > nbins)
+	nbins = inputKW->N_Elements();
     }
-    // Adjust "b" if binsize specified otherwise gsl_histogram_set_ranges_uniform
-    // will change bsize to (b-a)/nbins
+    // Adjust "b" if binsize specified otherwise the ranges
+    // would change bsize to (b-a)/nbins
     // SA: another case when it's needed: !MAX && !BINSIZE && NBINS
     if ( 
 	binsizeKW != NULL 
 	|| (binsizeKW == NULL && maxKW == NULL && nbinsKW != NULL)
 	 ) b = a + nbins * bsize;
  
-    // GSL error handling
-    SetTemporaryGSLErrorHandlerT setTemporaryGSLErrorHandler( GDLGenericGSLErrorHandler);
-
-    gsl_histogram* hh = gsl_histogram_alloc( nbins);
-    GDLGuard<gsl_histogram> hhGuard( hh, gsl_histogram_free);
-    gsl_histogram_set_ranges_uniform( hh, a, b);
-
-    // temporary revisited computation of bin values ...
-    gdl_make_uniform (hh, hh->n, a, b);
-
     // Set maxVal from keyword if present
     if (maxKW != NULL) e->AssureDoubleScalarKW(maxIx, maxVal);
 
-    // Generate histogram
-    for( SizeT i=0; i<nEl; ++i) {
-      if ((*p0D)[i] <= maxVal)
-	gsl_histogram_increment(hh, (*p0D)[i]);
-    }
+    HistoRange range( nbins, a, b, maxVal);
 
-    dimension dim( nbins);
-    DLongGDL* res = new DLongGDL(dim, BaseGDL::NOZERO);
+    // REVERSE_INDICES
+    static int reverse_indicesIx=e->KeywordIx("REVERSE_INDICES");
+    bool doRevind = e->KeywordPresent(reverse_indicesIx);
+    if( doRevind && inputKW != NULL)
+      e->Throw("Conflicting keywords.");
 
-    for( SizeT i=0; i<nbins; ++i) {
-      (*res)[i] = static_cast<DLong>( gsl_histogram_get(hh, i));
+    // Generate histogram (the result starts as a copy of INPUT if present)
+    dimension dim( nbins);
+    BaseGDL* res;
+    if( l64) {
+      DLong64GDL* res64;
+      if( inputKW != NULL)
+	res64 = static_cast<DLong64GDL*>( inputKW->Convert2( GDL_LONG64, BaseGDL::COPY));
+      else
+	res64 = new DLong64GDL( dim);
+      res = res64;
+      DLong64GDL* revind = NULL;
+      histogram_dispatch( p0, range, res64, doRevind ? &revind : NULL);
+      if( doRevind) e->SetKW(reverse_indicesIx, revind);
+    } else {
+      DLongGDL* res32;
+      if( inputKW != NULL)
+	res32 = static_cast<DLongGDL*>( inputKW->Convert2( GDL_LONG, BaseGDL::COPY));
+      else
+	res32 = new DLongGDL( dim);
+      res = res32;
+      DLongGDL* revind = NULL;
+      histogram_dispatch( p0, range, res32, doRevind ? &revind : NULL);
+      if( doRevind) e->SetKW(reverse_indicesIx, revind);
     }
+    res->SetDim( dim);
 
-    // Add input to output if present
-    if (input != NULL)
-      for( SizeT i=0; i<nbins; ++i) (*res)[i] += (*input)[i];
-
-    // SA: using aOri/bOri instead of gsl_histogram_min(hh) (as in calculation of LOCATIONS) 
+    // SA: using aOri/bOri instead of the adjusted range (as in calculation of LOCATIONS) 
     //     otherwise, when converting e.g. to GDL_INT the conversion might give bad results
     // OMAX
     static int omaxIx=e->KeywordIx("OMAX");
     if( e->KeywordPresent(omaxIx)) {
-      // e->SetKW( 5, (new DDoubleGDL( gsl_histogram_max(hh)))->Convert2(p0->Type(), BaseGDL::CONVERT));
-      e->SetKW(omaxIx, (new DDoubleGDL( bOri))->Convert2(p0->Type(), BaseGDL::CONVERT));
+      e->SetKW(omaxIx, (new DDoubleGDL( bOri))->Convert2(p0Type, BaseGDL::CONVERT));
     }
     // OMIN
     static int ominIx=e->KeywordIx("OMIN");
     if( e->KeywordPresent(ominIx)) {
-      // e->SetKW( 6, (new DDoubleGDL( gsl_histogram_min(hh)))->Convert2(p0->Type(), BaseGDL::CONVERT));
-      e->SetKW(ominIx, (new DDoubleGDL( aOri))->Convert2(p0->Type(), BaseGDL::CONVERT));
-    }
-
-    // REVERSE_INDICES
-    static int reverse_indicesIx=e->KeywordIx("REVERSE_INDICES");
-    if( e->KeywordPresent(reverse_indicesIx)) {
-
-      if (input != NULL)
-	e->Throw("Conflicting keywords.");
-
-      DULong k = 0;
-      multimap< size_t, SizeT> bin_j;
-      for( SizeT j=0; j<nEl; ++j) {
-	if( (*p0D)[j] >= a && (*p0D)[j] <= b) 
-	  {
-	    ++k;
-
-	    size_t bin;
-	    gsl_histogram_find (hh, (*p0D)[j], &bin);
-
-	    bin_j.insert( make_pair( bin, j));
-	  }
-      }
-
-      nri = nbins + k + 1;
-      DLongGDL* revindKW = new DLongGDL( dimension( nri), BaseGDL::NOZERO);
-
-      k = 0;
-      for( SizeT i=0; i<nbins; ++i) 
-	{
-	  typedef multimap< size_t, SizeT>::const_iterator mmI;
-	  
-	  pair< mmI, mmI> b = bin_j.equal_range( i);
-	  
-	  for( mmI j = b.first; j != b.second; ++j)
-	    {
-	      (*revindKW)[nbins+1+k] = j->second;
-	      k++;
-	    }	    
-	}
-
-      //       for( SizeT i=nbins+1; i<nri; ++i)
-      // 	cout << (*revindKW)[i] << " ";
-      //       cout << endl;
-
-
-      //       k = 0;
-      //       for( SizeT i=0; i<nbins; ++i) {
-      // 	for( SizeT j=0; j<nEl; ++j) {
-
-      // 	  if( (*p0D)[j] >= a && (*p0D)[j] <= b) 
-      // 	    {
-      // 	      size_t bin;
-      // 	      gsl_histogram_find (hh, (*p0D)[j], &bin);
-	      
-      // 	      if( bin == i) 
-      // 		{
-      // 		  (*revindKW)[nbins+1+k] = j;
-      // 		  k++;
-      // 		}
-      // 	    }
-      // 	}
-      //       }
-
-      //       for( SizeT i=nbins+1; i<nri; ++i)
-      // 	cout << (*revindKW)[i] << " ";
-      //       cout << endl;
-
-      (*revindKW)[0] = nbins + 1;
-      k = 0;
-      for( SizeT i=1; i<=nbins; ++i) {
-	k += (*res)[i-1];
-	(*revindKW)[i] = k + nbins + 1;
-      }
-
-      e->SetKW(reverse_indicesIx, revindKW);
+      e->SetKW(ominIx, (new DDoubleGDL( aOri))->Convert2(p0Type, BaseGDL::CONVERT));
     }
     
     // LOCATIONS
@@ -1563,63 +1780,63 @@ namespace lib {
       GDLDelete((*locationsKW));
 
       dimension dim( nbins);
-      if( p0->Type() == GDL_DOUBLE) {
+      if( p0Type == GDL_DOUBLE) {
 
 	*locationsKW = new DDoubleGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DDoubleGDL*>( *locationsKW))[i] = 
 	    static_cast<DDouble>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_FLOAT) {
+      } else if (p0Type == GDL_FLOAT) {
 
 	*locationsKW = new DFloatGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DFloatGDL*>( *locationsKW))[i] = 
 	    static_cast<DFloat>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_LONG) {
+      } else if (p0Type == GDL_LONG) {
 
 	*locationsKW = new DLongGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DLongGDL*>( *locationsKW))[i] = 
 	    static_cast<DLong>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_ULONG) {
+      } else if (p0Type == GDL_ULONG) {
 
 	*locationsKW = new DULongGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DULongGDL*>( *locationsKW))[i] = 
 	    static_cast<DULong>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_LONG64) {
+      } else if (p0Type == GDL_LONG64) {
 
 	*locationsKW = new DLong64GDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DLong64GDL*>( *locationsKW))[i] = 
 	    static_cast<DLong64>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_ULONG64) {
+      } else if (p0Type == GDL_ULONG64) {
 
 	*locationsKW = new DULong64GDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DULong64GDL*>( *locationsKW))[i] = 
 	    static_cast<DULong64>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_INT) {
+      } else if (p0Type == GDL_INT) {
 
 	*locationsKW = new DIntGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DIntGDL*>( *locationsKW))[i] = 
 	    static_cast<DInt>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_UINT) {
+      } else if (p0Type == GDL_UINT) {
 
 	*locationsKW = new DUIntGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
 	  (*static_cast<DUIntGDL*>( *locationsKW))[i] = 
 	    static_cast<DUInt>(aOri + bsize * i);
 
-      } else if (p0->Type() == GDL_BYTE) {
+      } else if (p0Type == GDL_BYTE) {
 
 	*locationsKW = new DByteGDL( dim, BaseGDL::NOZERO);
 	for( SizeT i=0; i<nbins; ++i)
@@ -1628,11 +1845,594 @@ namespace lib {
       }
 
     }
-    //gsl_histogram_free (hh);
 
     return(res);
   }
 
+  // HIST_ND and HIST_2D (formerly hist_nd.pro by J.D. Smith and
+  // hist_2d.pro): the points are binned in one pass, without the index
+  // temporaries, using histogram_chunks().
+  struct HistNDPar
+  {
+    SizeT nDim;
+    SizeT nP;
+    SizeT stride;                  // distance between two points
+    const void* ptr[MAXRANK];      // first coordinate of each dimension
+    DDouble mn[MAXRANK];
+    DDouble mx[MAXRANK];
+    DDouble bs[MAXRANK];           // used if haveBs
+    DLong nbins[MAXRANK];          // used if !haveBs
+    bool haveBs;
+  };
+
+  // (V-MIN)/BINSIZE is computed in the type IDL promotes it to:
+  // 2: DOUBLE, 1: FLOAT, 0: 64 bit integer
+  static int histnd_type_rank( BaseGDL* p)
+  {
+    if( p == NULL) return 0;
+    if( p->Type() == GDL_DOUBLE) return 2;
+    if( p->Type() == GDL_FLOAT) return 1;
+    return 0;
+  }
+
+  template< typename Ty, typename W>
+  class HistNDBinner
+  {
+    SizeT nDim;
+    SizeT stride;
+    const Ty* ptr[MAXRANK];
+    W mn[MAXRANK];
+    W mx[MAXRANK];
+    W bs[MAXRANK];
+    SizeT nb[MAXRANK];
+    SizeT total;
+
+  public:
+    HistNDBinner( const HistNDPar& par, SizeT* nbOut)
+      : nDim( par.nDim), stride( par.stride), total( 1)
+    {
+      for( SizeT d = 0; d < nDim; ++d)
+	{
+	  ptr[d] = static_cast<const Ty*>( par.ptr[d]);
+	  mn[d] = static_cast<W>( par.mn[d]);
+	  mx[d] = static_cast<W>( par.mx[d]);
+	  if( par.haveBs)
+	    {
+	      bs[d] = static_cast<W>( par.bs[d]);
+	      nb[d] = static_cast<DLong>( (mx[d] - mn[d]) / bs[d] + 1);
+	    }
+	  else
+	    {
+	      nb[d] = par.nbins[d];
+	      bs[d] = static_cast<W>( static_cast<DFloat>( mx[d] - mn[d]) / nb[d]);
+	      if( bs[d] == 0) bs[d] = 1; // MIN == MAX: everything in bin 0
+	    }
+	  nbOut[d] = nb[d];
+	  total *= nb[d];
+	}
+    }
+
+    inline bool operator()( SizeT j, SizeT& bin) const
+    {
+      SizeT ix = 0;
+      for( SizeT d = nDim; d-- > 0;)
+	{
+	  W x = static_cast<W>( ptr[d][ j * stride]);
+	  if( !(x >= mn[d] && x <= mx[d])) // also NaN
+	    return false;
+	  // with NBINS, x == MAX gives k == nb[d]: as in hist_nd.pro it is
+	  // not clamped, it goes to the next bin of the following dimension,
+	  // or out of the histogram for the last one
+	  SizeT k = static_cast<SizeT>( (x - mn[d]) / bs[d]);
+	  ix = ix * nb[d] + k;
+	}
+      if( ix >= total)
+	return false;
+      bin = ix;
+      return true;
+    }
+  };
+
+  template< typename Ty, typename W>
+  static BaseGDL* histnd_template( EnvT* e, const HistNDPar& par, DDoubleGDL* weights,
+				   DLongGDL** revind, bool purge)
+  {
+    SizeT nb[MAXRANK];
+    HistNDBinner<Ty, W> binner( par, nb);
+
+    SizeT nbins = 1;
+    for( SizeT d = 0; d < par.nDim; ++d)
+      {
+	if( nb[d] < 1 || nb[d] > std::numeric_limits<DLong>::max() / nbins)
+	  e->Throw( "Illegal binsize or max/min.");
+	nbins *= nb[d];
+      }
+
+    dimension dim( nb, par.nDim);
+    if( purge) dim.Purge();
+
+    if( weights == NULL)
+      {
+	DLongGDL* res = new DLongGDL( dim);
+	histogram_chunks( par.nP, nbins, binner, res, revind);
+	return res;
+      }
+
+    DDoubleGDL* res = new DDoubleGDL( dim);
+    histogram_weighted( par.nP, nbins, binner, &(*weights)[0], res);
+    if( revind != NULL)
+      {
+	DLongGDL* counts = new DLongGDL( dimension( nbins));
+	Guard<DLongGDL> countsGuard( counts);
+	histogram_chunks( par.nP, nbins, binner, counts, revind);
+      }
+    return res;
+  }
+
+  template< typename Ty>
+  static BaseGDL* histnd_w_dispatch( EnvT* e, int wRank, const HistNDPar& par,
+				     DDoubleGDL* weights, DLongGDL** revind, bool purge)
+  {
+    if( wRank == 2)
+      return histnd_template<Ty, DDouble>( e, par, weights, revind, purge);
+    if( wRank == 1)
+      return histnd_template<Ty, DFloat>( e, par, weights, revind, purge);
+    return histnd_template<Ty, DLong64>( e, par, weights, revind, purge);
+  }
+
+  static BaseGDL* histnd_dispatch( EnvT* e, DType t, int wRank, const HistNDPar& par,
+				   DDoubleGDL* weights, DLongGDL** revind, bool purge)
+  {
+    switch( t)
+      {
+      case GDL_BYTE: return histnd_w_dispatch<DByte>( e, wRank, par, weights, revind, purge);
+      case GDL_INT: return histnd_w_dispatch<DInt>( e, wRank, par, weights, revind, purge);
+      case GDL_UINT: return histnd_w_dispatch<DUInt>( e, wRank, par, weights, revind, purge);
+      case GDL_LONG: return histnd_w_dispatch<DLong>( e, wRank, par, weights, revind, purge);
+      case GDL_ULONG: return histnd_w_dispatch<DULong>( e, wRank, par, weights, revind, purge);
+      case GDL_LONG64: return histnd_w_dispatch<DLong64>( e, wRank, par, weights, revind, purge);
+      case GDL_ULONG64: return histnd_w_dispatch<DULong64>( e, wRank, par, weights, revind, purge);
+      case GDL_FLOAT: return histnd_w_dispatch<DFloat>( e, wRank, par, weights, revind, purge);
+      case GDL_DOUBLE: return histnd_w_dispatch<DDouble>( e, wRank, par, weights, revind, purge);
+      default: assert( false);
+      }
+    return NULL;
+  }
+
+  // minimum and maximum (NaN omitted) of each dimension of the points
+  template< typename Ty>
+  static void histnd_minmax( const HistNDPar& par, DDouble* mn, DDouble* mx)
+  {
+    for( SizeT d = 0; d < par.nDim; ++d)
+      {
+	const Ty* p = static_cast<const Ty*>( par.ptr[d]);
+	DDouble lo = std::numeric_limits<DDouble>::quiet_NaN();
+	DDouble hi = lo;
+	for( SizeT j = 0; j < par.nP; ++j)
+	  {
+	    DDouble x = static_cast<DDouble>( p[ j * par.stride]);
+	    if( isnan( x)) continue;
+	    if( !(x >= lo)) lo = x;
+	    if( !(x <= hi)) hi = x;
+	  }
+	mn[d] = lo;
+	mx[d] = hi;
+      }
+  }
+
+  static void histnd_minmax( DType t, const HistNDPar& par, DDouble* mn, DDouble* mx)
+  {
+    switch( t)
+      {
+      case GDL_BYTE: histnd_minmax<DByte>( par, mn, mx); break;
+      case GDL_INT: histnd_minmax<DInt>( par, mn, mx); break;
+      case GDL_UINT: histnd_minmax<DUInt>( par, mn, mx); break;
+      case GDL_LONG: histnd_minmax<DLong>( par, mn, mx); break;
+      case GDL_ULONG: histnd_minmax<DULong>( par, mn, mx); break;
+      case GDL_LONG64: histnd_minmax<DLong64>( par, mn, mx); break;
+      case GDL_ULONG64: histnd_minmax<DULong64>( par, mn, mx); break;
+      case GDL_FLOAT: histnd_minmax<DFloat>( par, mn, mx); break;
+      case GDL_DOUBLE: histnd_minmax<DDouble>( par, mn, mx); break;
+      default: assert( false);
+      }
+  }
+
+  // scalar or one value per dimension
+  static void histnd_get( EnvT* e, BaseGDL* p, SizeT nDim, DDouble* val, const string& name)
+  {
+    DDoubleGDL* pD = static_cast<DDoubleGDL*>( p->Convert2( GDL_DOUBLE, BaseGDL::COPY));
+    Guard<DDoubleGDL> pDGuard( pD);
+    if( pD->N_Elements() == 1)
+      for( SizeT d = 0; d < nDim; ++d) val[d] = (*pD)[0];
+    else if( pD->N_Elements() >= nDim)
+      for( SizeT d = 0; d < nDim; ++d) val[d] = (*pD)[d];
+    else
+      e->Throw( name + " must have one element per dimension.");
+  }
+
+  static DDoubleGDL* histnd_weights( EnvT* e, SizeT nP)
+  {
+    static int weightsIx = e->KeywordIx( "WEIGHTS");
+    if( e->GetKW( weightsIx) == NULL)
+      return NULL;
+    DDoubleGDL* weights = e->GetKWAs<DDoubleGDL>( weightsIx);
+    if( weights->N_Elements() < nP)
+      e->Throw( "WEIGHTS must have one element per point.");
+    return weights;
+  }
+
+  BaseGDL* hist_nd_fun( EnvT* e)
+  {
+    e->NParam( 1);
+
+    BaseGDL* p0 = e->GetNumericArrayParDefined( 0);
+    if( p0->Type() == GDL_COMPLEX || p0->Type() == GDL_COMPLEXDBL)
+      e->Throw( "Complex expression not allowed in this context: "
+		+ e->GetParString( 0));
+    if( p0->Rank() != 2)
+      e->Throw( "Input must be N (dimensions) x P (points)");
+
+    HistNDPar par;
+    par.nDim = p0->Dim( 0);
+    par.nP = p0->Dim( 1);
+    if( par.nDim > MAXRANK)
+      e->Throw( "Only up to " + MAXRANK_STR + " dimensions allowed");
+    par.stride = par.nDim;
+    SizeT sz = p0->Sizeof();
+    for( SizeT d = 0; d < par.nDim; ++d)
+      par.ptr[d] = static_cast<char*>( p0->DataAddr()) + d * sz;
+
+    static int minIx = e->KeywordIx( "MIN");
+    static int maxIx = e->KeywordIx( "MAX");
+    static int nbinsIx = e->KeywordIx( "NBINS");
+    static int reverse_indicesIx = e->KeywordIx( "REVERSE_INDICES");
+    BaseGDL* minKW = e->GetKW( minIx);
+    BaseGDL* maxKW = e->GetKW( maxIx);
+    BaseGDL* nbinsKW = e->GetKW( nbinsIx);
+    BaseGDL* p1 = (e->NParam() > 1) ? e->GetParDefined( 1) : NULL;
+
+    DDouble imn[MAXRANK], imx[MAXRANK];
+    if( minKW == NULL || maxKW == NULL)
+      histnd_minmax( p0->Type(), par, imn, imx);
+    if( minKW == NULL)
+      for( SizeT d = 0; d < par.nDim; ++d) par.mn[d] = imn[d];
+    else
+      histnd_get( e, minKW, par.nDim, par.mn, "MIN");
+    if( maxKW == NULL)
+      for( SizeT d = 0; d < par.nDim; ++d) par.mx[d] = imx[d];
+    else
+      histnd_get( e, maxKW, par.nDim, par.mx, "MAX");
+
+    for( SizeT d = 0; d < par.nDim; ++d)
+      if( !(par.mn[d] <= par.mx[d]))
+	e->Throw( "Min must be less than or equal to max.");
+
+    par.haveBs = (p1 != NULL);
+    int wRank = histnd_type_rank( p0);
+    wRank = max( wRank, histnd_type_rank( minKW));
+    wRank = max( wRank, histnd_type_rank( maxKW));
+    if( par.haveBs)
+      {
+	histnd_get( e, p1, par.nDim, par.bs, "Binsize");
+	for( SizeT d = 0; d < par.nDim; ++d)
+	  if( !(par.bs[d] > 0))
+	    e->Throw( "Illegal BINSIZE.");
+	wRank = max( wRank, histnd_type_rank( p1));
+      }
+    else if( nbinsKW != NULL)
+      {
+	DDouble nb[MAXRANK];
+	histnd_get( e, nbinsKW, par.nDim, nb, "NBINS");
+	for( SizeT d = 0; d < par.nDim; ++d)
+	  {
+	    par.nbins[d] = static_cast<DLong>( nb[d]); // no fractional bins
+	    if( par.nbins[d] < 1)
+	      e->Throw( "Illegal NBINS.");
+	  }
+	wRank = max( wRank, 1); // BINSIZE is FLOAT then
+      }
+    else
+      e->Throw( "Must pass either binsize or NBINS");
+
+    DDoubleGDL* weights = histnd_weights( e, par.nP);
+
+    bool doRevind = e->KeywordPresent( reverse_indicesIx);
+    DLongGDL* revind = NULL;
+    BaseGDL* res = histnd_dispatch( e, p0->Type(), wRank, par, weights,
+				    doRevind ? &revind : NULL, true);
+    if( doRevind)
+      e->SetKW( reverse_indicesIx, revind);
+    return res;
+  }
+
+  BaseGDL* hist_2d_fun( EnvT* e)
+  {
+    e->NParam( 2);
+
+    BaseGDL* v1 = e->GetNumericParDefined( 0);
+    BaseGDL* v2 = e->GetNumericParDefined( 1);
+    if( v1->Type() == GDL_COMPLEX || v1->Type() == GDL_COMPLEXDBL ||
+	v2->Type() == GDL_COMPLEX || v2->Type() == GDL_COMPLEXDBL)
+      e->Throw( "Complex expression not allowed in this context.");
+    if( v1->Rank() == 0 && v2->Rank() == 0)
+      e->Throw( "one of the 2 Expressions must be an array in this context");
+
+    static int bin1Ix = e->KeywordIx( "BIN1");
+    static int bin2Ix = e->KeywordIx( "BIN2");
+    static int min1Ix = e->KeywordIx( "MIN1");
+    static int min2Ix = e->KeywordIx( "MIN2");
+    static int max1Ix = e->KeywordIx( "MAX1");
+    static int max2Ix = e->KeywordIx( "MAX2");
+    BaseGDL* binKW[2] = { e->GetKW( bin1Ix), e->GetKW( bin2Ix)};
+    BaseGDL* minKW[2] = { e->GetKW( min1Ix), e->GetKW( min2Ix)};
+    BaseGDL* maxKW[2] = { e->GetKW( max1Ix), e->GetKW( max2Ix)};
+
+    // both coordinates must be of the same type for the binner
+    Guard<BaseGDL> v1Guard, v2Guard;
+    if( v1->Type() != v2->Type())
+      {
+	DType t = (max( histnd_type_rank( v1), histnd_type_rank( v2)) == 2) ? GDL_DOUBLE :
+	  (max( histnd_type_rank( v1), histnd_type_rank( v2)) == 1) ? GDL_FLOAT : GDL_LONG64;
+	if( v1->Type() != t)
+	  v1Guard.Reset( v1 = v1->Convert2( t, BaseGDL::COPY));
+	if( v2->Type() != t)
+	  v2Guard.Reset( v2 = v2->Convert2( t, BaseGDL::COPY));
+      }
+
+    // the shorter array determines how many elements are taken into account
+    HistNDPar par;
+    par.nDim = 2;
+    par.nP = min( v1->N_Elements(), v2->N_Elements());
+    par.stride = 1;
+    par.ptr[0] = v1->DataAddr();
+    par.ptr[1] = v2->DataAddr();
+    par.haveBs = true;
+
+    BaseGDL* v[2] = { v1, v2};
+    int wRank = max( histnd_type_rank( v1), histnd_type_rank( v2));
+    for( SizeT d = 0; d < 2; ++d)
+      {
+	string n = i2s( d + 1);
+
+	// bin-widths default to 1
+	par.bs[d] = 1;
+	if( binKW[d] != NULL)
+	  {
+	    histnd_get( e, binKW[d], 1, &par.bs[d], "BIN" + n);
+	    wRank = max( wRank, histnd_type_rank( binKW[d]));
+	  }
+	if( !(par.bs[d] > 0))
+	  e->Throw( "bin" + n + " must be > 0");
+
+	// min and max default to minimum and maximum values
+	// (min is never above 0)
+	if( minKW[d] == NULL || maxKW[d] == NULL)
+	  {
+	    DLong minEl, maxEl;
+	    v[d]->MinMax( &minEl, &maxEl, NULL, NULL, true);
+	    par.mn[d] = min( 0.0, histogram_element( v[d], minEl));
+	    par.mx[d] = histogram_element( v[d], maxEl);
+	  }
+	if( minKW[d] != NULL)
+	  {
+	    histnd_get( e, minKW[d], 1, &par.mn[d], "MIN" + n);
+	    wRank = max( wRank, histnd_type_rank( minKW[d]));
+	  }
+	if( maxKW[d] != NULL)
+	  {
+	    histnd_get( e, maxKW[d], 1, &par.mx[d], "MAX" + n);
+	    wRank = max( wRank, histnd_type_rank( maxKW[d]));
+	  }
+
+	if( !isfinite( par.mn[d]) || !isfinite( par.mx[d]))
+	  e->Throw( "min1, min2, max1 and max2 must all be finite");
+	if( par.mn[d] == par.mx[d])
+	  e->Throw( "min" + n + " must not be equal to max" + n);
+	if( par.mn[d] > par.mx[d])
+	  e->Throw( "Min must be less than or equal to max.");
+      }
+
+    // result is always a 2D LONG array
+    return histnd_dispatch( e, v1->Type(), wRank, par, NULL, NULL, false);
+  }
+
+  // Stencils of the uniform-grid interpolants of interp_multid.h. For one
+  // coordinate x on the grid 0..n-1 they hold the neighbours and the
+  // coefficients linear_eval/bilinear_eval/trilinear_eval (NW=2) and
+  // bicubic_eval (NW=4) use, in the order of their floating point
+  // operations, so that the results are unchanged. As interpolation is
+  // separable they are computed once per coordinate (once per column and
+  // per row with /GRID) and applied to all the leading-dimension slices of
+  // the array (e.g. a stack of frames with identical geometry passed as
+  // [nFrames,nx,ny]) without the former per-slice copy and search.
+  struct InterpStencil
+  {
+    SizeT ix[4];
+    double w[4];
+    bool out; // out of range: MISSING is used
+  };
+
+  template< int NW>
+  static inline void interp_stencil( double x, SizeT n, bool useMissing, InterpStencil& s)
+  {
+    double xmax = n - 1;
+    s.out = false;
+    if( useMissing)
+      {
+	if( x < 0 || x > xmax)
+	  {
+	    s.out = true;
+	    return;
+	  }
+      }
+    else
+      {
+	if( x < 0) x = 0;
+	if( x > xmax) x = xmax;
+      }
+    // same as gsl_interp_bsearch() on 0..n-1 (NaN gives NaN coefficients)
+    SizeT xi = 0;
+    if( x >= 1) 
+      {
+	xi = static_cast<SizeT>( x);
+	if( xi > n - 2) xi = n - 2;
+      }
+    SizeT xp = (xi + 1 < n) ? xi + 1 : xi;
+    double u = (xp > xi) ? (x - xi) : 0.0;
+    if( NW == 2)
+      {
+	// linConv(u, t[xi], t[xp])
+	s.ix[0] = xi;       s.w[0] = 1. - u;
+	s.ix[1] = xp;       s.w[1] = u;
+      }
+    else
+      {
+	// cubConv(u, t[xm], t[xi], t[xp], t[xp2]), same operation order
+	double g = gdl_cubic_gamma;
+	double d = u;
+	s.ix[0] = xi;
+	s.w[0] = ((g + 2) * d*d*d - (g + 3) * d*d + 1);
+	s.ix[1] = xp;
+	s.w[1] = ((g + 2) * (1 - d)*(1-d)*(1-d) - (g + 3) * (1 - d)*(1-d) + 1);
+	s.ix[2] = (xi > 0) ? xi - 1 : xi;
+	s.w[2] = (g * (1 + d)*(1+d)*(1+d) -5 * g * (1 + d)*(1+d) + 8 * g * (1 + d) - 4 * g);
+	s.ix[3] = (xp + 1 < n) ? xp + 1 : xp;
+	s.w[3] = (g * (2 - d)*(2-d)*(2-d) -5 * g * (2 - d)*(2-d) + 8 * g * (2 - d) - 4 * g);
+      }
+  }
+
+  // 2D: out[0..ninterp-1] for the point with stencils sx, sy
+  template< int NW>
+  static inline void interp_apply_2d( const DDouble* a, SizeT nxa, SizeT ninterp,
+				      const InterpStencil& sx, const InterpStencil& sy,
+				      DDouble missing, DDouble* out)
+  {
+    if( sx.out || sy.out)
+      {
+	for( SizeT it = 0; it < ninterp; ++it) out[it] = missing;
+	return;
+      }
+    for( SizeT it = 0; it < ninterp; ++it)
+      {
+	double t = 0;
+	for( int k = 0; k < NW; ++k)
+	  {
+	    const DDouble* row = a + sy.ix[k] * nxa * ninterp + it;
+	    double r = sx.w[0] * row[ sx.ix[0] * ninterp];
+	    for( int l = 1; l < NW; ++l) r += sx.w[l] * row[ sx.ix[l] * ninterp];
+	    t = (k == 0) ? sy.w[0] * r : t + sy.w[k] * r;
+	  }
+	out[it] = t;
+      }
+  }
+
+  template< int NW>
+  static void interpolate_2dim_stencil( DDoubleGDL* array, SizeT ninterp, SizeT nxa, SizeT nya,
+					DDoubleGDL* x, DDoubleGDL* y, bool grid,
+					bool use_missing, DDouble missing, DDoubleGDL* res)
+  {
+    const DDouble* a = &(*array)[0];
+    DDouble* r = &(*res)[0];
+    if( grid)
+      {
+	SizeT nx = x->N_Elements();
+	SizeT ny = y->N_Elements();
+	std::vector<InterpStencil> sx( nx), sy( ny);
+	for( SizeT i = 0; i < nx; ++i) interp_stencil<NW>( (*x)[i], nxa, use_missing, sx[i]);
+	for( SizeT j = 0; j < ny; ++j) interp_stencil<NW>( (*y)[j], nya, use_missing, sy[j]);
+	SizeT chunksize = nx * ny;
+#pragma omp parallel for if (chunksize >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= chunksize))
+	for( OMPInt j = 0; j < ny; ++j)
+	  for( SizeT i = 0; i < nx; ++i)
+	    interp_apply_2d<NW>( a, nxa, ninterp, sx[i], sy[j], missing,
+				 r + (INDEX_2D( i, j, nx, ny)) * ninterp);
+      }
+    else
+      {
+	SizeT chunksize = x->N_Elements();
+#pragma omp parallel for if (chunksize >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= chunksize))
+	for( OMPInt i = 0; i < chunksize; ++i)
+	  {
+	    InterpStencil sx, sy;
+	    interp_stencil<NW>( (*x)[i], nxa, use_missing, sx);
+	    interp_stencil<NW>( (*y)[i], nya, use_missing, sy);
+	    interp_apply_2d<NW>( a, nxa, ninterp, sx, sy, missing, r + i * ninterp);
+	  }
+      }
+  }
+
+  // 3D (trilinear only)
+  static inline void interp_apply_3d( const DDouble* a, SizeT nxa, SizeT nya, SizeT ninterp,
+				      const InterpStencil& sx, const InterpStencil& sy,
+				      const InterpStencil& sz, DDouble missing, DDouble* out)
+  {
+    if( sx.out || sy.out || sz.out)
+      {
+	for( SizeT it = 0; it < ninterp; ++it) out[it] = missing;
+	return;
+      }
+    SizeT planeStride = nxa * nya * ninterp;
+    SizeT rowStride = nxa * ninterp;
+    for( SizeT it = 0; it < ninterp; ++it)
+      {
+	double tz[2];
+	for( int m = 0; m < 2; ++m)
+	  {
+	    double ty[2];
+	    for( int k = 0; k < 2; ++k)
+	      {
+		const DDouble* row = a + sz.ix[m] * planeStride + sy.ix[k] * rowStride + it;
+		ty[k] = sx.w[0] * row[ sx.ix[0] * ninterp] + sx.w[1] * row[ sx.ix[1] * ninterp];
+	      }
+	    tz[m] = sy.w[0] * ty[0] + sy.w[1] * ty[1];
+	  }
+	out[it] = sz.w[0] * tz[0] + sz.w[1] * tz[1];
+      }
+  }
+
+  static void interpolate_3dim_stencil( DDoubleGDL* array, SizeT ninterp,
+					SizeT nxa, SizeT nya, SizeT nza,
+					DDoubleGDL* x, DDoubleGDL* y, DDoubleGDL* z, bool grid,
+					bool use_missing, DDouble missing, DDoubleGDL* res)
+  {
+    const DDouble* a = &(*array)[0];
+    DDouble* r = &(*res)[0];
+    if( grid)
+      {
+	SizeT nx = x->N_Elements();
+	SizeT ny = y->N_Elements();
+	SizeT nz = z->N_Elements();
+	std::vector<InterpStencil> sx( nx), sy( ny), sz( nz);
+	for( SizeT i = 0; i < nx; ++i) interp_stencil<2>( (*x)[i], nxa, use_missing, sx[i]);
+	for( SizeT j = 0; j < ny; ++j) interp_stencil<2>( (*y)[j], nya, use_missing, sy[j]);
+	for( SizeT k = 0; k < nz; ++k) interp_stencil<2>( (*z)[k], nza, use_missing, sz[k]);
+	SizeT chunksize = nx * ny * nz;
+	OMPInt nyz = ny * nz;
+#pragma omp parallel for if (chunksize >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= chunksize))
+	for( OMPInt jk = 0; jk < nyz; ++jk)
+	  {
+	    SizeT j = jk % ny;
+	    SizeT k = jk / ny;
+	    for( SizeT i = 0; i < nx; ++i)
+	      interp_apply_3d( a, nxa, nya, ninterp, sx[i], sy[j], sz[k], missing,
+			       r + (INDEX_3D( i, j, k, nx, ny, nz)) * ninterp);
+	  }
+      }
+    else
+      {
+	SizeT chunksize = x->N_Elements();
+#pragma omp parallel for if (chunksize >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= chunksize))
+	for( OMPInt i = 0; i < chunksize; ++i)
+	  {
+	    InterpStencil sx, sy, sz;
+	    interp_stencil<2>( (*x)[i], nxa, use_missing, sx);
+	    interp_stencil<2>( (*y)[i], nya, use_missing, sy);
+	    interp_stencil<2>( (*z)[i], nza, use_missing, sz);
+	    interp_apply_3d( a, nxa, nya, ninterp, sx, sy, sz, missing, r + i * ninterp);
+	  }
+      }
+  }
+
   DDoubleGDL* interpolate_1dim(EnvT* e, const gdl_interp1d_type* interp_type, 
 			       DDoubleGDL* array, DDoubleGDL* x, bool use_missing,
 			       DDouble missing, DDouble gamma)
@@ -1678,9 +2478,8 @@ namespace lib {
     ArrayGuard<double> xaGuard(xa);
     for (SizeT i = 0; i < nxa; ++i) xa[i] = (double)i;
 
-    // Setup interpolation arrays
-    gsl_interp_accel *accx = gsl_interp_accel_alloc();
-    GDLGuard<gsl_interp_accel> g1( accx, gsl_interp_accel_free);
+    // Setup interpolation arrays (no gsl_interp_accel: it would be shared
+    // by the threads below)
     gdl_interp1d* interpolant = gdl_interp1d_alloc(interp_type, nxa);
     GDLGuard<gdl_interp1d> g2( interpolant, gdl_interp1d_free);
     
@@ -1709,12 +2508,10 @@ namespace lib {
 	for (OMPInt i = 0; i < chunksize; ++i)
 	  {
 	    double x = xval[i];
-	    (*res)[i*ninterp+iterate] = gdl_interp1d_eval(interpolant, xa, temp, x, accx);
+	    (*res)[i*ninterp+iterate] = gdl_interp1d_eval(interpolant, xa, temp, x, NULL);
 	  }
       }
 
-    //     gsl_interp_accel_free(accx);
-    //     gdl_interp1d_free(interpolant);
     return res;
   }
 
@@ -1780,10 +2577,22 @@ namespace lib {
     for (SizeT i = 0; i < rankLeft; ++i) ninterp *= array->Dim(i);
 
     SizeT nxa = array->Dim(rankLeft);
+    SizeT nya = array->Dim(rankLeft+1);
+
+    // bilinear and bicubic: separable stencils, in parallel
+    if (interp_type == gdl_interp2d_bilinear || interp_type == gdl_interp2d_bicubic)
+      {
+	gdl_update_cubic_interpolation_coeff(gamma);
+	if (interp_type == gdl_interp2d_bicubic)
+	  interpolate_2dim_stencil<4>(array, ninterp, nxa, nya, x, y, grid, use_missing, missing, res);
+	else
+	  interpolate_2dim_stencil<2>(array, ninterp, nxa, nya, x, y, grid, use_missing, missing, res);
+	return res;
+      }
+
     double *xa = new double[nxa];
     ArrayGuard<double> xaGuard( xa);
     for (SizeT i = 0; i < nxa; ++i) xa[i] = (double)i;
-    SizeT nya = array->Dim(rankLeft+1);
     double *ya = new double[nya];
     ArrayGuard<double> yaGuard( ya);
     for (SizeT i = 0; i < nya; ++i) ya[i] = (double)i;
@@ -1908,91 +2717,16 @@ namespace lib {
     for (SizeT i = 0; i < rankLeft; ++i) ninterp *= array->Dim(i);
 
     SizeT nxa = array->Dim(rankLeft);
-    double *xa = new double[nxa];
-    ArrayGuard<double> xaGuard( xa);
-    for (SizeT i = 0; i < nxa; ++i) xa[i] = (double)i;
-
     SizeT nya = array->Dim(rankLeft+1);
-    double *ya = new double[nya];
-    ArrayGuard<double> yaGuard( ya);
-    for (SizeT i = 0; i < nya; ++i) ya[i] = (double)i;
-
     SizeT nza = array->Dim(rankLeft+2);
-    double *za = new double[nza];
-    ArrayGuard<double> zaGuard( za);
-    for (SizeT i = 0; i < nza; ++i) za[i] = (double)i;
 
     // test if interp_type kernel trace is statisfied by nxa,nya,nza:
     if (nxa<gdl_interp3d_type_min_size(interp_type)||nya<gdl_interp3d_type_min_size(interp_type)||nza<gdl_interp3d_type_min_size(interp_type)) 
       e->Throw("Array(s) dimensions too small for this interpolation type.");
-    // Setup interpolation arrays
-    gsl_interp_accel *accx = gsl_interp_accel_alloc();
-    GDLGuard<gsl_interp_accel> g1( accx, gsl_interp_accel_free);
-    gsl_interp_accel *accy = gsl_interp_accel_alloc();
-    GDLGuard<gsl_interp_accel> g2( accy, gsl_interp_accel_free);
-    gsl_interp_accel *accz = gsl_interp_accel_alloc();
-    GDLGuard<gsl_interp_accel> g3( accz, gsl_interp_accel_free);
-    gdl_interp3d* interpolant = gdl_interp3d_alloc(interp_type, nxa, nya, nza);
-    GDLGuard<gdl_interp3d> g4( interpolant, gdl_interp3d_free);
 
-    // output locations tables:
-    double *xval = new double[chunksize];
-    ArrayGuard<double> xvalGuard( xval);
-    double *yval = new double[chunksize];
-    ArrayGuard<double> yvalGuard( yval);
-    double *zval = new double[chunksize];
-    ArrayGuard<double> zvalGuard( zval);
-    if (grid)
-      {
-	for (SizeT k = 0, count = 0; k < nz; ++k)
-	  {
-	    for (SizeT j = 0; j < ny; ++j)
-	      {
-		for (SizeT i = 0; i < nx; ++i)
-		  {
-		    count = INDEX_3D(i, j, k, nx, ny, nz);
-		    xval[count] = (*x)[i];
-		    yval[count] = (*y)[j];
-		    zval[count] = (*z)[k];
-		  }
-	      }
-	  }
-      } else
-      {
-	for (SizeT count = 0; count < chunksize; ++count)
-	  {
-	    xval[count] = (*x)[count];
-	    yval[count] = (*y)[count];
-	    zval[count] = (*z)[count];
-	  }
-      }
-    //construct 3d intermediate array, subset of array with stride ninterp
-    double *temp = new double[nxa*nya*nza];
-    ArrayGuard<double> tempGuard( temp);
+    // trilinear (the only 3D type): separable stencils, in parallel
+    interpolate_3dim_stencil(array, ninterp, nxa, nya, nza, x, y, z, grid, use_missing, missing, res);
 
-    // Interpolate iteratively ninterp times:
-    // this outer loop could be multihreaded easily
-    for (SizeT iterate = 0; iterate < ninterp; ++iterate)
-      {
-	for (SizeT k = 0; k < nxa*nya*nza; ++k) temp[k]=(*array)[k*ninterp+iterate];
-	gdl_interp3d_init(interpolant, xa, ya, za, temp, nxa, nya, nza, use_missing?missing_GIVEN:missing_NEAREST, missing);
-#ifndef __PATHCC__
-#pragma omp parallel if (chunksize >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= chunksize))
-#pragma omp for
-#endif
-	for (OMPInt i = 0; i < chunksize; ++i)
-	  {
-	    double x = xval[i];
-	    double y = yval[i];
-	    double z = zval[i];
-	    (*res)[i*ninterp+iterate] = gdl_interp3d_eval(interpolant, xa, ya, za, temp, x, y, z, accx, accy, accz);
-	  }
-      }
-
-    //     gsl_interp_accel_free(accx);
-    //     gsl_interp_accel_free(accy);
-    //     gsl_interp_accel_free(accz);
-    //     gdl_interp3d_free(interpolant);
     return res;
   }
 
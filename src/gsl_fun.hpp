@@ -33,6 +33,8 @@ namespace lib {
   BaseGDL* fft_fun( EnvT* e);
   BaseGDL* random_fun( EnvT* e);
   BaseGDL* histogram_fun( EnvT* e);
+  BaseGDL* hist_nd_fun( EnvT* e);
+  BaseGDL* hist_2d_fun( EnvT* e);
   BaseGDL* interpolate_fun( EnvT* e);
 
   void la_trired_pro( EnvT* e);
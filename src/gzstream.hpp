@@ -32,6 +32,8 @@
 // standard C++ with new header file names and std:: namespace
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <thread>
 #include <zlib.h>
 
 #ifdef GZSTREAM_NAMESPACE
@@ -54,9 +56,22 @@ private:
     char             opened;             // open/close state of stream
     int              mode;               // I/O mode
     std::streampos   position;
+    // read ahead: a second thread inflates the next block while the
+    // current one is consumed ([0] holds the get area, [1] is filled)
+    std::vector<char> aheadBuf[2];
+    std::thread      aheadThread;
+    unsigned         aheadSize;          // block size, 0: off
+    int              aheadNum;           // result of the pending gzread
+    bool             aheadPending;
+    void aheadStart();
+    int  aheadWait();
+    z_off_t aheadDrop();
+    z_off_t aheadTell();
     int flush_buffer();
+    std::streampos doSeekPos( std::streampos sp, std::ios_base::openmode which);
+    std::streampos doSeekOff( std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which);
 public:
-    gzstreambuf() : opened(0) {
+    gzstreambuf() : opened(0), aheadSize(0), aheadNum(0), aheadPending(false) {
         setp( buffer, buffer + (bufferSize-1));
         setg( buffer + buf4,     // beginning of putback area
               buffer + buf4,     // read position
@@ -70,10 +85,15 @@ public:
     
     virtual int     overflow( int c = EOF);
     virtual int     underflow();
+    // bulk transfers bypass the small buffer
+    virtual std::streamsize xsgetn( char* s, std::streamsize n);
+    virtual std::streamsize xsputn( const char* s, std::streamsize n);
     virtual int     sync();
     std::streampos pubseekpos(std::streampos sp, std::ios_base::openmode which=std::ios_base::in|std::ios_base::out);
     std::streampos pubseekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which=std::ios_base::in|std::ios_base::out);
     //hacks for not being lost with input gzipped streams
+    // inflate blocks of blockSize bytes in the background (0: stop)
+    void setReadAhead( std::streamsize blockSize);
     std::streampos getPosition(){return position;}
     void setPosition(long pos){position=pos;} 
     void incrementPosition(long pos=1){position+=pos;}
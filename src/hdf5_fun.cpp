@@ -31,10 +31,23 @@
 
 #include "hdf5_fun.hpp"
 
+#include <vector>
+#include <cstring>
+#include <zlib.h>
+
 #if defined(H5_USE_16_API) && defined(H5_NO_DEPRECATED_SYMBOLS)
 #error "Can't choose old API versions when deprecated APIs are disabled"
 #endif /* defined(H5_USE_16_API) && defined(H5_NO_DEPRECATED_SYMBOLS) */
 
+// per-dataset chunk cache (H5Pset_chunk_cache) since 1.8.3, reading raw
+// chunks (H5Dread_chunk, H5Dget_chunk_info_by_coord) since 1.10.5
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>8))||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR==8)&&(H5_VERS_RELEASE>=3))
+#define GDL_H5_CHUNK_CACHE 1
+#endif
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>10))||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR==10)&&(H5_VERS_RELEASE>=5))
+#define GDL_H5_DIRECT_CHUNK 1
+#endif
+
 namespace lib {
 
   using namespace std;
@@ -97,6 +110,15 @@ namespace lib {
     hdf5_type_guard(hid_t type_) { type = type_; }
     ~hdf5_type_guard() { H5Tclose(type); }
   };
+
+  // auto_ptr-like class for guarding HDF5 property lists
+  class hdf5_plist_guard 
+  {
+    hid_t plist;
+  public: 
+    hdf5_plist_guard(hid_t plist_) { plist = plist_; }
+    ~hdf5_plist_guard() { H5Pclose(plist); }
+  };
   
   // --------------------------------------------------------------------
 
@@ -286,6 +308,52 @@ hid_t
     
   }
 
+  // same as hdf5_input_conversion(), for an identifier given as keyword
+  hid_t hdf5_input_conversion_kw( EnvT* e, int ix)
+  {
+    hid_t hdf5_id;
+
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=10))
+    e->AssureLongScalarKW(ix, (DLong64&)hdf5_id);
+#else
+    e->AssureLongScalarKW(ix, hdf5_id);
+#endif
+    return hdf5_id;
+  }
+
+  // a vector of rank dimensions or indices given in GDL (column major)
+  // order, reversed to the HDF5 order; negative values are refused, or
+  // mean H5S_UNLIMITED if unlimited is set
+  void hdf5_dims_conversion( EnvT* e, DLong64GDL* v, int rank, const string& name,
+                             hsize_t* out, bool unlimited=false)
+  {
+    if (rank > MAXRANK) e->Throw("Only up to " + i2s(MAXRANK) + " dimensions are supported.");
+    if (v->N_Elements() != rank)
+      e->Throw("Number of elements in " + name + " must be equal to the rank (" + i2s(rank) + ").");
+    for (int i = 0; i < rank; i++) {
+      DLong64 d = (*v)[i];
+      if (d < 0 && !unlimited) e->Throw(name + " must not contain negative values.");
+      out[rank - 1 - i] = (d < 0) ? H5S_UNLIMITED : static_cast<hsize_t>(d);
+    }
+  }
+
+  // the HDF5 native type of the elements of a GDL numeric type, -1 if there is none
+  hid_t hdf5_native_type( DType t)
+  {
+    switch (t) {
+      case GDL_BYTE: return H5T_NATIVE_UINT8;
+      case GDL_INT: return H5T_NATIVE_INT16;
+      case GDL_UINT: return H5T_NATIVE_UINT16;
+      case GDL_LONG: return H5T_NATIVE_INT32;
+      case GDL_ULONG: return H5T_NATIVE_UINT32;
+      case GDL_LONG64: return H5T_NATIVE_INT64;
+      case GDL_ULONG64: return H5T_NATIVE_UINT64;
+      case GDL_FLOAT: return H5T_NATIVE_FLOAT;
+      case GDL_DOUBLE: return H5T_NATIVE_DOUBLE;
+      default: return -1;
+    }
+  }
+
   BaseGDL* h5f_is_hdf5_fun( EnvT* e)
   {
     DString h5fFilename;
@@ -323,8 +391,11 @@ hid_t
     e->AssureScalarPar<DStringGDL>( 0, h5fFilename);
     WordExp( h5fFilename);
 
+    static int writeIx = e->KeywordIx("WRITE");
+    unsigned flags = e->KeywordSet(writeIx) ? H5F_ACC_RDWR : H5F_ACC_RDONLY;
+
     hid_t h5f_id;
-    h5f_id = H5Fopen(h5fFilename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    h5f_id = H5Fopen(h5fFilename.c_str(), flags, H5P_DEFAULT);
 
     if (h5f_id < 0) 
       { 
@@ -361,7 +432,47 @@ hid_t
     DString h5dDatasetname;
     e->AssureScalarPar<DStringGDL>( 1, h5dDatasetname);
 
-    hid_t h5d_id= H5Dopen((long)h5f_id, h5dDatasetname.c_str());
+    static int chunk_cache_preemptionIx = e->KeywordIx("CHUNK_CACHE_PREEMPTION");
+    static int chunk_cache_sizeIx = e->KeywordIx("CHUNK_CACHE_SIZE");
+    static int chunk_cache_slotsIx = e->KeywordIx("CHUNK_CACHE_SLOTS");
+
+    hid_t h5d_id;
+    if (e->KeywordPresent(chunk_cache_preemptionIx) || e->KeywordPresent(chunk_cache_sizeIx) ||
+        e->KeywordPresent(chunk_cache_slotsIx)) {
+#ifdef GDL_H5_CHUNK_CACHE
+      // raw data chunk cache of this dataset (the default, 1 MB, is too
+      // small for the chunks of large images or cubes); what is not given
+      // keeps the value of the file
+      size_t nbytes = H5D_CHUNK_CACHE_NBYTES_DEFAULT;
+      size_t nslots = H5D_CHUNK_CACHE_NSLOTS_DEFAULT;
+      double w0 = H5D_CHUNK_CACHE_W0_DEFAULT;
+      if (e->KeywordPresent(chunk_cache_sizeIx)) {
+        DLong64 size;
+        e->AssureLongScalarKW(chunk_cache_sizeIx, size);
+        if (size < 0) e->Throw("CHUNK_CACHE_SIZE must not be negative.");
+        nbytes = size;
+      }
+      if (e->KeywordPresent(chunk_cache_slotsIx)) {
+        DLong64 slots;
+        e->AssureLongScalarKW(chunk_cache_slotsIx, slots);
+        if (slots < 0) e->Throw("CHUNK_CACHE_SLOTS must not be negative.");
+        nslots = slots;
+      }
+      if (e->KeywordPresent(chunk_cache_preemptionIx)) {
+        e->AssureDoubleScalarKW(chunk_cache_preemptionIx, w0);
+        if (w0 < 0 || w0 > 1) e->Throw("CHUNK_CACHE_PREEMPTION must be between 0 and 1.");
+      }
+      hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+      if (dapl < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+      hdf5_plist_guard dapl_guard = hdf5_plist_guard(dapl);
+      if (H5Pset_chunk_cache(dapl, nslots, nbytes, w0) < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+      h5d_id = H5Dopen2(h5f_id, h5dDatasetname.c_str(), dapl);
+#else
+      e->Throw("CHUNK_CACHE_* keywords need HDF5 1.8.3 or later.");
+#endif
+    } else {
+      h5d_id = H5Dopen((long)h5f_id, h5dDatasetname.c_str());
+    }
 
     if (h5d_id < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
 
@@ -585,7 +696,7 @@ hid_t
     } else if (ourType == GDL_LONG64) {
       res = new DLong64GDL(dim);
       type = H5T_NATIVE_INT64;
-    } else if (ourType == GDL_LONG64) {
+    } else if (ourType == GDL_ULONG64) {
       res = new DULong64GDL(dim);
       type = H5T_NATIVE_UINT64;
     } else if (ourType == GDL_FLOAT) {
@@ -642,10 +753,142 @@ hid_t
   }
   
 
+#ifdef GDL_H5_DIRECT_CHUNK
+  /**
+   * reads a whole chunked dataset stored with the deflate filter only,
+   * without going through the filter pipeline: the raw chunks are read
+   * one after the other (the library is not thread-safe), then inflated
+   * and copied to their place in res in parallel, a batch of chunks at
+   * a time. Returns false if the dataset does not qualify (layout,
+   * filters, user fill value, type conversion needed) or if anything
+   * fails: the caller then reads it with H5Dread().
+   */
+  static bool hdf5_read_chunks_direct(hid_t h5d_id, hid_t filetype, hid_t memtype,
+                                      int rank, const hsize_t* dims, BaseGDL* res)
+  {
+    if (rank < 1 || rank > MAXRANK || H5Tequal(filetype, memtype) <= 0) return false;
+
+    hid_t dcpl = H5Dget_create_plist(h5d_id);
+    if (dcpl < 0) return false;
+    hdf5_plist_guard dcpl_guard = hdf5_plist_guard(dcpl);
+
+    if (H5Pget_layout(dcpl) != H5D_CHUNKED || H5Pget_nfilters(dcpl) != 1) return false;
+    unsigned int flags;
+    size_t cd_nelmts = 0;
+    if (H5Pget_filter2(dcpl, 0, &flags, &cd_nelmts, NULL, 0, NULL, NULL) != H5Z_FILTER_DEFLATE) return false;
+    // the fill value is zero, as res, unless user-defined
+    H5D_fill_value_t fill;
+    if (H5Pfill_value_defined(dcpl, &fill) < 0 || fill == H5D_FILL_VALUE_USER_DEFINED) return false;
+    hsize_t cdims[MAXRANK];
+    if (H5Pget_chunk(dcpl, rank, cdims) != rank) return false;
+
+    size_t elSize = H5Tget_size(memtype);
+    SizeT chunkElts = 1;
+    SizeT nChunks = 1;
+    hsize_t grid[MAXRANK];
+    for (int i = 0; i < rank; i++) {
+      chunkElts *= cdims[i];
+      grid[i] = (dims[i] + cdims[i] - 1) / cdims[i];
+      nChunks *= grid[i];
+    }
+    if (nChunks < 2) return false;
+    SizeT chunkBytes = chunkElts * elSize;
+
+    // row major strides, in elements, of a chunk and of the dataset
+    SizeT cstride[MAXRANK], dstride[MAXRANK];
+    cstride[rank - 1] = dstride[rank - 1] = 1;
+    for (int i = rank - 2; i >= 0; i--) {
+      cstride[i] = cstride[i + 1] * cdims[i + 1];
+      dstride[i] = dstride[i + 1] * dims[i + 1];
+    }
+
+    char* dest = static_cast<char*>(res->DataAddr());
+    const SizeT batchBytes = 64 << 20;
+    SizeT batch = (chunkBytes < batchBytes) ? batchBytes / chunkBytes : 1;
+    if (batch > nChunks) batch = nChunks;
+    vector< vector<char> > raw(batch);
+    vector<uint32_t> mask(batch);
+    vector<hsize_t> origin(batch * rank);
+
+    for (SizeT c0 = 0; c0 < nChunks; c0 += batch) {
+      SizeT nB = (nChunks - c0 < batch) ? nChunks - c0 : batch;
+      for (SizeT k = 0; k < nB; ++k) {
+        hsize_t* o = &origin[k * rank];
+        SizeT c = c0 + k;
+        for (int i = rank - 1; i >= 0; i--) {
+          o[i] = (c % grid[i]) * cdims[i];
+          c /= grid[i];
+        }
+        // a chunk never written has no address and holds the fill value
+        unsigned filter_mask;
+        haddr_t addr;
+        hsize_t size;
+        if (H5Dget_chunk_info_by_coord(h5d_id, o, &filter_mask, &addr, &size) < 0) return false;
+        if (addr == HADDR_UNDEF) size = 0;
+        raw[k].resize(size);
+        if (size > 0 && H5Dread_chunk(h5d_id, H5P_DEFAULT, o, &mask[k], &raw[k][0]) < 0) return false;
+      }
+
+      bool failed = false;
+      SizeT nEl = nB * chunkElts;
+#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+      {
+        vector<char> inflated(chunkBytes);
+#pragma omp for
+        for (OMPInt k = 0; k < nB; ++k) {
+          if (raw[k].empty()) continue;
+          const char* chunk = &raw[k][0];
+          if (mask[k] & 1) {
+            // the filter was skipped for this chunk
+            if (raw[k].size() != chunkBytes) { failed = true; continue; }
+          } else {
+            uLongf len = chunkBytes;
+            if (uncompress(reinterpret_cast<Bytef*>(&inflated[0]), &len,
+                           reinterpret_cast<const Bytef*>(chunk), raw[k].size()) != Z_OK || len != chunkBytes) {
+              failed = true;
+              continue;
+            }
+            chunk = &inflated[0];
+          }
+          // copy the part inside the dataset, row by row
+          const hsize_t* o = &origin[k * rank];
+          hsize_t ext[MAXRANK];
+          SizeT nRows = 1;
+          for (int i = 0; i < rank; i++) {
+            ext[i] = (dims[i] - o[i] < cdims[i]) ? dims[i] - o[i] : cdims[i];
+            if (i < rank - 1) nRows *= ext[i];
+          }
+          SizeT rowBytes = ext[rank - 1] * elSize;
+          hsize_t idx[MAXRANK];
+          for (int i = 0; i < rank; i++) idx[i] = 0;
+          for (SizeT r = 0; r < nRows; ++r) {
+            SizeT src = 0;
+            SizeT dst = o[rank - 1];
+            for (int i = 0; i < rank - 1; i++) {
+              src += idx[i] * cstride[i];
+              dst += (o[i] + idx[i]) * dstride[i];
+            }
+            memcpy(dest + dst * elSize, chunk + src * elSize, rowBytes);
+            for (int i = rank - 2; i >= 0; i--) {
+              if (++idx[i] < ext[i]) break;
+              idx[i] = 0;
+            }
+          }
+        }
+      }
+      if (failed) return false;
+    }
+    return true;
+  }
+#endif
+
   /**
    * h5d_read_fun
    * CAUTION: compatibility only fractional
-   * - Does not allow to select hyperslabs
+   * - FILE_SPACE (a selection, e.g. from H5S_SELECT_HYPERSLAB) and
+   *   MEMORY_SPACE are not supported for strings
+   * - whole chunked datasets compressed with deflate are inflated in
+   *   parallel (hdf5_read_chunks_direct)
    */
   BaseGDL* h5d_read_fun(EnvT* e) {
 
@@ -685,43 +928,70 @@ hid_t
       e->Throw(hdf5_error_message(msg));
     }
 
-    // define hyperslab in dataset
-#if (H5_VERS_MAJOR < 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR < 6)) ||  ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR == 6) && (H5_VERS_RELEASE <= 3))
-    hssize_t offset[MAXRANK];
-#else
-    hsize_t offset[MAXRANK];
-#endif
-    hsize_t count[MAXRANK];
+    static int file_spaceIx = e->KeywordIx("FILE_SPACE");
+    static int memory_spaceIx = e->KeywordIx("MEMORY_SPACE");
+    bool fileSpacePresent = e->KeywordPresent(file_spaceIx);
+    bool memorySpacePresent = e->KeywordPresent(memory_spaceIx);
 
-    for (int i = 0; i < rank; i++) offset[i] = 0;
-    for (int i = 0; i < rank; i++) count[i] = dims_out[i];
+    // the elements read: the whole dataset, or the selection of FILE_SPACE
+    hid_t file_space = h5s_id;
+    if (fileSpacePresent) file_space = hdf5_input_conversion_kw(e, file_spaceIx);
 
-    if (H5Sselect_hyperslab(h5s_id, H5S_SELECT_SET, offset, NULL, count, NULL) < 0) {
-      string msg;
-      e->Throw(hdf5_error_message(msg));
+    // the memory dataspace gives the dimensions of the result: those of
+    // MEMORY_SPACE if given, else those of the dataset, of a regular
+    // hyperslab selection (count * block), or a vector of the elements
+    // of any other selection
+    int rank_out = rank;
+    hsize_t count_out[MAXRANK];
+    for (int i = 0; i < rank; i++) count_out[i] = dims_out[i];
+
+    if (fileSpacePresent && !memorySpacePresent) {
+      H5S_sel_type sel = H5Sget_select_type(file_space);
+      if (sel < 0) {
+        string msg;
+        e->Throw(hdf5_error_message(msg));
+      }
+      if (sel == H5S_SEL_NONE) e->Throw("No elements selected in FILE_SPACE.");
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=10))
+      if (sel == H5S_SEL_HYPERSLABS && H5Sis_regular_hyperslab(file_space) > 0) {
+        hsize_t start[MAXRANK], stride[MAXRANK], count[MAXRANK], block[MAXRANK];
+        if (H5Sget_regular_hyperslab(file_space, start, stride, count, block) < 0) {
+          string msg;
+          e->Throw(hdf5_error_message(msg));
+        }
+        for (int i = 0; i < rank; i++) count_out[i] = count[i] * block[i];
+      } else
+#endif
+      if (sel != H5S_SEL_ALL) {
+        hssize_t npoints = H5Sget_select_npoints(file_space);
+        if (npoints < 0) {
+          string msg;
+          e->Throw(hdf5_error_message(msg));
+        }
+        rank_out = 1;
+        count_out[0] = npoints;
+      }
     }
-    if (debug) cout << "here 2" <<endl;
 
     // define memory dataspace
-    hid_t memspace = H5Screate_simple(rank, count, NULL);
+    hid_t memspace;
+    if (memorySpacePresent)
+      memspace = H5Scopy(hdf5_input_conversion_kw(e, memory_spaceIx));
+    else
+      memspace = H5Screate_simple(rank_out, count_out, NULL);
     if (memspace < 0) {
       string msg;
       e->Throw(hdf5_error_message(msg));
     }
     hdf5_space_guard memspace_guard = hdf5_space_guard(memspace);
 
-    // define memory hyperslab
-#if (H5_VERS_MAJOR < 1) || ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR < 6)) ||  ((H5_VERS_MAJOR == 1) && (H5_VERS_MINOR == 6) && (H5_VERS_RELEASE <= 3))
-    hssize_t offset_out[MAXRANK];
-#else
-    hsize_t offset_out[MAXRANK];
-#endif
-    hsize_t count_out[MAXRANK];
-    for (int i = 0; i < rank; i++) offset_out[i] = 0;
-    for (int i = 0; i < rank; i++) count_out[i] = dims_out[i];
-    if (H5Sselect_hyperslab(memspace, H5S_SELECT_SET, offset_out, NULL, count_out, NULL) < 0) {
-      string msg;
-      e->Throw(hdf5_error_message(msg));
+    if (memorySpacePresent) {
+      rank_out = H5Sget_simple_extent_ndims(memspace);
+      if (rank_out > MAXRANK) e->Throw("Only up to " + i2s(MAXRANK) + " dimensions are supported.");
+      if (rank_out < 0 || H5Sget_simple_extent_dims(memspace, count_out, NULL) < 0) {
+        string msg;
+        e->Throw(hdf5_error_message(msg));
+      }
     }
 
     if (debug) cout << "here 3" <<endl;
@@ -729,10 +999,10 @@ hid_t
     SizeT count_s[MAXRANK];
     SizeT rank_s;
 
-    rank_s = (SizeT) rank;
+    rank_s = (SizeT) rank_out;
     // need to reverse indices for column major format
-    for (int i = 0; i < rank; i++)
-      count_s[i] = (SizeT) count_out[rank - 1 - i ];
+    for (int i = 0; i < rank_out; i++)
+      count_s[i] = (SizeT) count_out[rank_out - 1 - i ];
 
     // create the IDL datatypes
     dimension dim(count_s, rank_s);
@@ -766,7 +1036,7 @@ hid_t
     } else if (ourType == GDL_LONG64) {
       res = new DLong64GDL(dim);
       type = H5T_NATIVE_INT64;
-    } else if (ourType == GDL_LONG64) {
+    } else if (ourType == GDL_ULONG64) {
       res = new DULong64GDL(dim);
       type = H5T_NATIVE_UINT64;
     } else if (ourType == GDL_FLOAT) {
@@ -785,19 +1055,21 @@ hid_t
       hid_t filetype = H5Dget_type(h5d_id);
       SizeT sdim = H5Tget_size(filetype);
       sdim++; /* Make room for null terminator */
+      // one row per element of the memory dataspace (the selection)
+      SizeT nStr = res->N_Elements();
       char **rdata;
       /*
        * Allocate array of pointers to rows.
        */
-      rdata = (char **) malloc(count_s[0] * sizeof (char *));
+      rdata = (char **) malloc(nStr * sizeof (char *));
       /*
        * Allocate space for integer data.
        */
-      rdata[0] = (char *) malloc(count_s[0] * sdim * sizeof (char));
+      rdata[0] = (char *) malloc(nStr * sdim * sizeof (char));
       /*
        * Set the rest of the pointers to rows to the correct addresses.
        */
-      for (int i = 1; i < count_s[0]; i++)
+      for (SizeT i = 1; i < nStr; i++)
         rdata[i] = rdata[0] + i * sdim;
       /*
        * Create the memory datatype.
@@ -807,7 +1079,7 @@ hid_t
 
       if (debug) cout << "here 4b" <<endl;
 
-      status = H5Dread(h5d_id, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, rdata[0]);
+      status = H5Dread(h5d_id, memtype, memspace, file_space, H5P_DEFAULT, rdata[0]);
 
       if (debug) cout << "here 4c" <<endl;
 
@@ -817,7 +1089,7 @@ hid_t
       }
       if (debug) cout << "here 4d" <<endl;
       
-      for (int i = 0; i < count_s[0]; i++)
+      for (SizeT i = 0; i < nStr; i++)
         (*(static_cast<DStringGDL*> (res)))[i] = rdata[i];
       free (rdata); //but not rdata[0]
       status = H5Tclose (filetype);
@@ -828,8 +1100,14 @@ hid_t
     }
 
     if (debug) cout << "here 5" <<endl;
+
+#ifdef GDL_H5_DIRECT_CHUNK
+    if (!fileSpacePresent && !memorySpacePresent &&
+        hdf5_read_chunks_direct(h5d_id, datatype, type, rank, dims_out, res))
+      return res;
+#endif
  
-    if (H5Dread(h5d_id, type, memspace, h5s_id, H5P_DEFAULT, res->DataAddr()) < 0) {
+    if (H5Dread(h5d_id, type, memspace, file_space, H5P_DEFAULT, res->DataAddr()) < 0) {
       string msg;
       e->Throw(hdf5_error_message(msg));
     }
@@ -838,6 +1116,151 @@ hid_t
   }
 
   
+  void h5s_select_hyperslab_pro( EnvT* e)
+  {
+    SizeT nParam=e->NParam(3);
+
+    hid_t h5s_id = hdf5_input_conversion(e,0);
+
+    int rank = H5Sget_simple_extent_ndims(h5s_id);
+    if (rank < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+
+    static int blockIx = e->KeywordIx("BLOCK");
+    static int resetIx = e->KeywordIx("RESET");
+    static int strideIx = e->KeywordIx("STRIDE");
+
+    hsize_t start[MAXRANK], count[MAXRANK], stride[MAXRANK], block[MAXRANK];
+    hdf5_dims_conversion(e, e->GetParAs<DLong64GDL>(1), rank, "Start", start);
+    hdf5_dims_conversion(e, e->GetParAs<DLong64GDL>(2), rank, "Count", count);
+    bool hasStride = e->KeywordPresent(strideIx);
+    if (hasStride) hdf5_dims_conversion(e, e->GetKWAs<DLong64GDL>(strideIx), rank, "STRIDE", stride);
+    bool hasBlock = e->KeywordPresent(blockIx);
+    if (hasBlock) hdf5_dims_conversion(e, e->GetKWAs<DLong64GDL>(blockIx), rank, "BLOCK", block);
+
+    // as IDL: added to the current selection unless /RESET
+    H5S_seloper_t op = e->KeywordSet(resetIx) ? H5S_SELECT_SET : H5S_SELECT_OR;
+    if (H5Sselect_hyperslab(h5s_id, op, start, hasStride ? stride : NULL,
+                            count, hasBlock ? block : NULL) < 0)
+      { string msg; e->Throw(hdf5_error_message(msg)); }
+  }
+
+
+  BaseGDL* h5s_create_simple_fun( EnvT* e)
+  {
+    SizeT nParam=e->NParam(1);
+
+    static int max_dimensionsIx = e->KeywordIx("MAX_DIMENSIONS");
+
+    DLong64GDL* p0 = e->GetParAs<DLong64GDL>(0);
+    int rank = p0->N_Elements();
+    hsize_t dims[MAXRANK], maxdims[MAXRANK];
+    hdf5_dims_conversion(e, p0, rank, "Dimensions", dims);
+    bool hasMax = e->KeywordPresent(max_dimensionsIx);
+    if (hasMax) hdf5_dims_conversion(e, e->GetKWAs<DLong64GDL>(max_dimensionsIx), rank, "MAX_DIMENSIONS", maxdims, true);
+
+    hid_t h5s_id = H5Screate_simple(rank, dims, hasMax ? maxdims : NULL);
+    if (h5s_id < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+
+    return hdf5_output_conversion( h5s_id );
+  }
+
+
+  BaseGDL* h5t_idl_create_fun( EnvT* e)
+  {
+    SizeT nParam=e->NParam(1);
+
+    BaseGDL* p0 = e->GetParDefined(0);
+    hid_t native = hdf5_native_type(p0->Type());
+    if (native < 0) e->Throw("Unsupported data type: " + p0->TypeStr());
+
+    hid_t h5t_id = H5Tcopy(native);
+    if (h5t_id < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+
+    return hdf5_output_conversion( h5t_id );
+  }
+
+
+  BaseGDL* h5d_create_fun( EnvT* e)
+  {
+    SizeT nParam=e->NParam(4);
+
+    hid_t loc_id = hdf5_input_conversion(e,0);
+    DString h5dDatasetname;
+    e->AssureScalarPar<DStringGDL>( 1, h5dDatasetname);
+    hid_t h5t_id = hdf5_input_conversion(e,2);
+    hid_t h5s_id = hdf5_input_conversion(e,3);
+
+    static int chunk_dimensionsIx = e->KeywordIx("CHUNK_DIMENSIONS");
+    static int gzipIx = e->KeywordIx("GZIP");
+    static int shuffleIx = e->KeywordIx("SHUFFLE");
+
+    hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    if (dcpl < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+    hdf5_plist_guard dcpl_guard = hdf5_plist_guard(dcpl);
+
+    bool chunked = e->KeywordPresent(chunk_dimensionsIx);
+    if (chunked) {
+      int rank = H5Sget_simple_extent_ndims(h5s_id);
+      if (rank < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+      hsize_t chunk[MAXRANK];
+      hdf5_dims_conversion(e, e->GetKWAs<DLong64GDL>(chunk_dimensionsIx), rank, "CHUNK_DIMENSIONS", chunk);
+      if (H5Pset_chunk(dcpl, rank, chunk) < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+    }
+    // filters apply to chunks only; shuffling goes before compression
+    if (e->KeywordSet(shuffleIx)) {
+      if (!chunked) e->Throw("SHUFFLE requires CHUNK_DIMENSIONS.");
+      if (H5Pset_shuffle(dcpl) < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+    }
+    if (e->KeywordPresent(gzipIx)) {
+      DLong level;
+      e->AssureLongScalarKW(gzipIx, level);
+      if (level < 0 || level > 9) e->Throw("GZIP must be between 0 and 9.");
+      if (!chunked) e->Throw("GZIP requires CHUNK_DIMENSIONS.");
+      if (H5Pset_deflate(dcpl, level) < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+    }
+
+    hid_t h5d_id = H5Dcreate2(loc_id, h5dDatasetname.c_str(), h5t_id, h5s_id,
+                              H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    if (h5d_id < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+
+    return hdf5_output_conversion( h5d_id );
+  }
+
+
+  void h5d_write_pro( EnvT* e)
+  {
+    SizeT nParam=e->NParam(2);
+
+    hid_t h5d_id = hdf5_input_conversion(e,0);
+    BaseGDL* data = e->GetParDefined(1);
+    hid_t memtype = hdf5_native_type(data->Type());
+    if (memtype < 0) e->Throw("Unsupported data type: " + data->TypeStr());
+
+    static int file_spaceIx = e->KeywordIx("FILE_SPACE");
+    static int memory_spaceIx = e->KeywordIx("MEMORY_SPACE");
+
+    hid_t file_space = H5S_ALL;
+    if (e->KeywordPresent(file_spaceIx)) file_space = hdf5_input_conversion_kw(e, file_spaceIx);
+
+    // by default the memory dataspace is the data, which must have as many
+    // elements as the dataset (or the FILE_SPACE selection)
+    hid_t memspace;
+    if (e->KeywordPresent(memory_spaceIx))
+      memspace = H5Scopy(hdf5_input_conversion_kw(e, memory_spaceIx));
+    else {
+      int rank = (data->Rank() > 0) ? data->Rank() : 1;
+      hsize_t dims[MAXRANK];
+      for (int i = 0; i < rank; i++) dims[rank - 1 - i] = (data->Rank() > 0) ? data->Dim(i) : 1;
+      memspace = H5Screate_simple(rank, dims, NULL);
+    }
+    if (memspace < 0) { string msg; e->Throw(hdf5_error_message(msg)); }
+    hdf5_space_guard memspace_guard = hdf5_space_guard(memspace);
+
+    if (H5Dwrite(h5d_id, memtype, memspace, file_space, H5P_DEFAULT, data->DataAddr()) < 0)
+      { string msg; e->Throw(hdf5_error_message(msg)); }
+  }
+
+
   void h5s_close_pro( EnvT* e)
   {
     SizeT nParam=e->NParam(1);
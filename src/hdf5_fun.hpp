@@ -70,6 +70,12 @@ namespace lib {
   void h5t_close_pro( EnvT* e );
   void h5g_close_pro( EnvT* e );
 
+  BaseGDL* h5s_create_simple_fun( EnvT* e);
+  void h5s_select_hyperslab_pro( EnvT* e);
+  BaseGDL* h5t_idl_create_fun( EnvT* e);
+  BaseGDL* h5d_create_fun( EnvT* e);
+  void h5d_write_pro( EnvT* e);
+
 } // namespace
 
 #endif
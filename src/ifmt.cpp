@@ -34,6 +34,28 @@ using namespace std;
 
 void ReadNext( istream& is, string& buf)
 {
+  if( is.good() && is.tie() == NULL)
+    {
+      // the same on the stream buffer, without a sentry per character
+      streambuf* sb = is.rdbuf();
+      for( bool trail = false;; trail = true)
+	{
+	  int c = sb->sbumpc();
+	  if( c == EOF)
+	    {
+	      is.setstate( ios::eofbit | ios::failbit);
+	      return;
+	    }
+	  if( c == '\n') return;
+	  if( trail && (c == ' ' || c == '\t'))
+	    {
+	      sb->sungetc();
+	      return;
+	    }
+	  buf.push_back( static_cast<char>( c));
+	}
+    }
+
   bool trail = false;
   char c;
   for(;;)
@@ -61,8 +83,9 @@ inline double ReadD( istream* is, int w)
 {
   if( w > 0)
     {
-      char *buf = new char[ w+1];
-      ArrayGuard<char> guard( buf);
+      char sBuf[ 64]; // fields are usually short
+      char *buf = (w < 64) ? sBuf : new char[ w+1];
+      ArrayGuard<char> guard( (w < 64) ? NULL : buf);
       is->get( buf, w+1); 
       return Str2D( buf);
    }
@@ -84,8 +107,9 @@ inline long int ReadL( istream* is, int w, int base=10)
 {
   if( w > 0)
     {
-      char *buf = new char[ w+1];
-      ArrayGuard<char> guard( buf);
+      char sBuf[ 64]; // fields are usually short
+      char *buf = (w < 64) ? sBuf : new char[ w+1];
+      ArrayGuard<char> guard( (w < 64) ? NULL : buf);
       is->get( buf, w+1); 
       return Str2L( buf, base);
    }
@@ -107,8 +131,9 @@ inline unsigned long int ReadUL( istream* is, int w, int base=10)
 {
   if( w > 0)
     {
-      char *buf = new char[ w+1];
-      ArrayGuard<char> guard( buf);
+      char sBuf[ 64]; // fields are usually short
+      char *buf = (w < 64) ? sBuf : new char[ w+1];
+      ArrayGuard<char> guard( (w < 64) ? NULL : buf);
       is->get( buf, w+1); 
       return Str2UL( buf, base);
    }
@@ -0,0 +1,507 @@
+/***************************************************************************
+                          interpol.cpp  -  UNIQ(), VALUE_LOCATE() and INTERPOL()
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+// native versions of the former uniq.pro, value_locate.pro and
+// interpol.pro, same calling sequences and results.
+
+#include "includefirst.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "interpol.hpp"
+#include "math_fun_ac.hpp" // spline kernels
+
+namespace lib {
+
+  using namespace std;
+
+  // ---------------------------------------------------------------------
+  // VALUE_LOCATE: j such that x[j] <= u < x[j+1] (x increasing),
+  // x[j] > u >= x[j+1] (x decreasing); -1 and n-1 outside.
+  // Branchless binary search: the number of leading elements satisfying
+  // the (monotonic) predicate, minus one. n must be > 0.
+
+  template<typename T>
+  inline OMPInt LocateIncreasing( const T* x, SizeT n, const T& u)
+  {
+    const T* base = x;
+    while( n > 1)
+      {
+	SizeT half = n / 2;
+	base = (base[ half] <= u) ? base + half : base;
+	n -= half;
+      }
+    return (base - x) + ((*base <= u) ? 1 : 0) - 1;
+  }
+
+  template<typename T>
+  inline OMPInt LocateDecreasing( const T* x, SizeT n, const T& u)
+  {
+    const T* base = x;
+    while( n > 1)
+      {
+	SizeT half = n / 2;
+	base = (base[ half] > u) ? base + half : base;
+	n -= half;
+      }
+    return (base - x) + ((*base > u) ? 1 : 0) - 1;
+  }
+
+  template<typename T, typename IxT>
+  static void value_locate_kernel( const T* x, SizeT n, const T* u, SizeT nU,
+				   bool decreasing, IxT* res)
+  {
+    if( decreasing)
+      {
+#pragma omp parallel for if (nU >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nU))
+	for( OMPInt i = 0; i < nU; ++i)
+	  res[ i] = LocateDecreasing( x, n, u[ i]);
+      }
+    else
+      {
+#pragma omp parallel for if (nU >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nU))
+	for( OMPInt i = 0; i < nU; ++i)
+	  res[ i] = LocateIncreasing( x, n, u[ i]);
+      }
+  }
+
+  template<typename GDLT>
+  static BaseGDL* value_locate_typed( EnvT* e, bool l64)
+  {
+    GDLT* x = e->GetParAs<GDLT>( 0);
+    GDLT* u = e->GetParAs<GDLT>( 1);
+    SizeT n = x->N_Elements();
+    SizeT nU = u->N_Elements();
+
+    // only a warning, as IDL
+    bool up = false, down = false;
+    for( SizeT i = 1; i < n && !(up && down); ++i)
+      {
+	if( (*x)[ i] > (*x)[ i-1]) up = true;
+	else if( (*x)[ i] < (*x)[ i-1]) down = true;
+      }
+    if( up && down)
+      Message( e->GetProName() + ": Warning : input array is NOT monotonically increasing or decreasing");
+
+    bool decreasing = (*x)[ n-1] < (*x)[ 0];
+
+    if( l64)
+      {
+	DLong64GDL* res = new DLong64GDL( u->Dim(), BaseGDL::NOZERO);
+	value_locate_kernel( &(*x)[ 0], n, &(*u)[ 0], nU, decreasing, &(*res)[ 0]);
+	return res;
+      }
+    DLongGDL* res = new DLongGDL( u->Dim(), BaseGDL::NOZERO);
+    value_locate_kernel( &(*x)[ 0], n, &(*u)[ 0], nU, decreasing, &(*res)[ 0]);
+    return res;
+  }
+
+  BaseGDL* value_locate_fun( EnvT* e)
+  {
+    e->NParam( 2);
+    BaseGDL* xP = e->GetParDefined( 0);
+    BaseGDL* uP = e->GetParDefined( 1);
+    DType xT = xP->Type();
+    DType uT = uP->Type();
+
+    if( ComplexType( xT) || !ConvertableType( xT))
+      e->Throw( "First variable : " + xP->TypeStr() + " not allowed in this context.");
+    if( !ConvertableType( uT))
+      e->Throw( "Second variable : " + uP->TypeStr() + " not allowed in this context.");
+
+    static int l64Ix = e->KeywordIx( "L64");
+    bool l64 = e->KeywordSet( l64Ix) || xP->N_Elements() > 2147483647;
+
+    // integers are compared exactly, everything else as double
+    if( xT == GDL_STRING)
+      return value_locate_typed<DStringGDL>( e, l64);
+    if( IntType( xT) && IntType( uT))
+      {
+	if( xT == GDL_ULONG64 || uT == GDL_ULONG64)
+	  return value_locate_typed<DULong64GDL>( e, l64);
+	return value_locate_typed<DLong64GDL>( e, l64);
+      }
+    return value_locate_typed<DDoubleGDL>( e, l64);
+  }
+
+  // ---------------------------------------------------------------------
+  // UNIQ: subscripts of the last element of each run of equal values,
+  // no sort involved (the input is expected to be sorted, or sorted
+  // through the index).
+
+  template<typename Ty>
+  inline const Ty& UniqElement( const Ty* a, SizeT nEl, const DLong64* ix, SizeT k)
+  {
+    if( ix == NULL) return a[ k];
+    DLong64 i = ix[ k];
+    return a[ (i < 0) ? 0 : ((static_cast<SizeT>( i) >= nEl) ? nEl-1 : i)];
+  }
+
+  // k such that element k differs from element k+1 (the last one is
+  // compared to the first one, as with SHIFT(arr,-1))
+  template<typename Ty>
+  static void uniq_positions( const Ty* a, SizeT nEl, const DLong64* ix, SizeT n,
+			      vector<SizeT>& pos)
+  {
+    int nchunk = (n >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= n)) ? CpuTPOOL_NTHREADS : 1;
+    if( nchunk < 1) nchunk = 1;
+    SizeT chunksize = n / nchunk;
+    vector<SizeT> partialCount( nchunk + 1, 0);
+
+    // first pass counts, second pass fills
+#pragma omp parallel for num_threads(nchunk)
+    for( int iloop = 0; iloop < nchunk; ++iloop)
+      {
+	SizeT start = iloop * chunksize;
+	SizeT stop = (iloop == nchunk-1) ? n : start + chunksize;
+	SizeT count = 0;
+	for( SizeT k = start; k < stop; ++k)
+	  if( UniqElement( a, nEl, ix, k) != UniqElement( a, nEl, ix, (k+1 == n) ? 0 : k+1)) ++count;
+	partialCount[ iloop+1] = count;
+      }
+    for( int iloop = 0; iloop < nchunk; ++iloop)
+      partialCount[ iloop+1] += partialCount[ iloop];
+
+    pos.resize( partialCount[ nchunk]);
+    if( pos.empty()) return;
+
+#pragma omp parallel for num_threads(nchunk)
+    for( int iloop = 0; iloop < nchunk; ++iloop)
+      {
+	SizeT start = iloop * chunksize;
+	SizeT stop = (iloop == nchunk-1) ? n : start + chunksize;
+	SizeT* out = &pos[ 0] + partialCount[ iloop];
+	for( SizeT k = start; k < stop; ++k)
+	  if( UniqElement( a, nEl, ix, k) != UniqElement( a, nEl, ix, (k+1 == n) ? 0 : k+1)) *out++ = k;
+      }
+  }
+
+  template<typename GDLT>
+  static void uniq_positions_typed( BaseGDL* arr, const DLong64* ix, SizeT n, vector<SizeT>& pos)
+  {
+    GDLT* a = static_cast<GDLT*>( arr);
+    uniq_positions( &(*a)[ 0], a->N_Elements(), ix, n, pos);
+  }
+
+  BaseGDL* uniq_fun( EnvT* e)
+  {
+    SizeT nParam = e->NParam( 1);
+    BaseGDL* arr = e->GetParDefined( 0);
+    SizeT nEl = arr->N_Elements();
+    if( nEl <= 1) return new DIntGDL( 0);
+
+    DLong64GDL* index = NULL;
+    SizeT n = nEl;
+    if( nParam > 1)
+      {
+	index = e->GetParAs<DLong64GDL>( 1);
+	n = index->N_Elements();
+      }
+    const DLong64* ix = (index != NULL) ? &(*index)[ 0] : NULL;
+
+    vector<SizeT> pos;
+    switch( arr->Type())
+      {
+      case GDL_BYTE: uniq_positions_typed<DByteGDL>( arr, ix, n, pos); break;
+      case GDL_INT: uniq_positions_typed<DIntGDL>( arr, ix, n, pos); break;
+      case GDL_UINT: uniq_positions_typed<DUIntGDL>( arr, ix, n, pos); break;
+      case GDL_LONG: uniq_positions_typed<DLongGDL>( arr, ix, n, pos); break;
+      case GDL_ULONG: uniq_positions_typed<DULongGDL>( arr, ix, n, pos); break;
+      case GDL_LONG64: uniq_positions_typed<DLong64GDL>( arr, ix, n, pos); break;
+      case GDL_ULONG64: uniq_positions_typed<DULong64GDL>( arr, ix, n, pos); break;
+      case GDL_FLOAT: uniq_positions_typed<DFloatGDL>( arr, ix, n, pos); break;
+      case GDL_DOUBLE: uniq_positions_typed<DDoubleGDL>( arr, ix, n, pos); break;
+      case GDL_COMPLEX: uniq_positions_typed<DComplexGDL>( arr, ix, n, pos); break;
+      case GDL_COMPLEXDBL: uniq_positions_typed<DComplexDblGDL>( arr, ix, n, pos); break;
+      case GDL_STRING: uniq_positions_typed<DStringGDL>( arr, ix, n, pos); break;
+      case GDL_PTR: uniq_positions_typed<DPtrGDL>( arr, ix, n, pos); break;
+      case GDL_OBJ: uniq_positions_typed<DObjGDL>( arr, ix, n, pos); break;
+      default:
+	e->Throw( "Struct expression not allowed in this context: " + e->GetParString( 0));
+      }
+
+    bool l64 = nEl > 2147483647 || n > 2147483647;
+
+    // all equal: N_ELEMENTS(arr)-1
+    if( pos.empty())
+      {
+	if( l64) return new DLong64GDL( nEl-1);
+	return new DLongGDL( nEl-1);
+      }
+
+    SizeT nRes = pos.size();
+    if( index == NULL)
+      {
+	if( l64)
+	  {
+	    DLong64GDL* res = new DLong64GDL( dimension( nRes), BaseGDL::NOZERO);
+	    for( SizeT i = 0; i < nRes; ++i) (*res)[ i] = pos[ i];
+	    return res;
+	  }
+	DLongGDL* res = new DLongGDL( dimension( nRes), BaseGDL::NOZERO);
+	for( SizeT i = 0; i < nRes; ++i) (*res)[ i] = pos[ i];
+	return res;
+      }
+
+    // INDEX[ix], in the type of INDEX
+    DLong64GDL* res = new DLong64GDL( dimension( nRes), BaseGDL::NOZERO);
+    for( SizeT i = 0; i < nRes; ++i) (*res)[ i] = (*index)[ pos[ i]];
+    DType ixT = e->GetParDefined( 1)->Type();
+    if( ixT == GDL_LONG64) return res;
+    return res->Convert2( ixT, BaseGDL::CONVERT);
+  }
+
+  // ---------------------------------------------------------------------
+  // INTERPOL: linear, quadratic and spline interpolation on an irregular
+  // (3 parameters) or regular (2 parameters) grid, one pass over the
+  // output points.
+
+  // abscissae x[0..n-1], monotonic
+  struct IrregularGrid
+  {
+    const DDouble* x;
+    SizeT n;
+    bool decreasing;
+    IrregularGrid( const DDouble* x_, SizeT n_): x( x_), n( n_), decreasing( x_[ n_-1] < x_[ 0]) {}
+    DDouble X( SizeT i) const { return x[ i]; }
+    OMPInt Locate( DDouble u) const
+    {
+      return decreasing ? LocateDecreasing( x, n, u) : LocateIncreasing( x, n, u);
+    }
+  };
+
+  // abscissae 0,1,...,n-1
+  struct RegularGrid
+  {
+    SizeT n;
+    RegularGrid( SizeT n_): n( n_) {}
+    DDouble X( SizeT i) const { return static_cast<DDouble>( i); }
+    OMPInt Locate( DDouble u) const
+    {
+      if( u < 0) return -1;
+      if( u >= n) return n-1;
+      return static_cast<OMPInt>( u);
+    }
+  };
+
+  // IDL's formulas: the end intervals are extrapolated, non finite
+  // abscissae are copied to the result.
+  template<typename VT, typename Grid>
+  static void interpol_linear( const VT* v, const Grid& g, const DDouble* u, SizeT nOut, VT* res)
+  {
+    OMPInt last = g.n - 2;
+#pragma omp parallel for if (nOut >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nOut))
+    for( OMPInt i = 0; i < nOut; ++i)
+      {
+	DDouble ui = u[ i];
+	if( !isfinite( ui)) { res[ i] = ui; continue;}
+	OMPInt s = g.Locate( ui);
+	if( s < 0) s = 0; else if( s > last) s = last;
+	DDouble x0 = g.X( s);
+	res[ i] = (ui - x0) * (v[ s+1] - v[ s]) / (g.X( s+1) - x0) + v[ s];
+      }
+  }
+
+  template<typename VT, typename Grid>
+  static void interpol_quadratic( const VT* v, const Grid& g, const DDouble* u, SizeT nOut, VT* res)
+  {
+    OMPInt last = g.n - 2;
+#pragma omp parallel for if (nOut >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nOut))
+    for( OMPInt i = 0; i < nOut; ++i)
+      {
+	DDouble ui = u[ i];
+	if( !isfinite( ui)) { res[ i] = ui; continue;}
+	OMPInt s = g.Locate( ui);
+	if( s < 1) s = 1; else if( s > last) s = last;
+	// Lagrange polynomial through s-1, s, s+1
+	DDouble x0 = g.X( s-1), x1 = g.X( s), x2 = g.X( s+1);
+	DDouble d0 = ui - x0, d1 = ui - x1, d2 = ui - x2;
+	res[ i] = v[ s-1] * (d1 * d2 / ((x0 - x1) * (x0 - x2)))
+	  + v[ s] * (d0 * d2 / ((x1 - x0) * (x1 - x2)))
+	  + v[ s+1] * (d0 * d1 / ((x2 - x0) * (x2 - x1)));
+      }
+  }
+
+  // natural cubic spline (as SPL_INTERP(x,v,SPL_INIT(x,v),u)), x increasing.
+  // With singlePrec the second derivatives are rounded to float as
+  // SPL_INIT() returns them, so that the results are the same.
+  static void interpol_spline( const DDouble* x, const DDouble* v, SizeT n,
+			       const DDouble* u, SizeT nOut, bool singlePrec, DDouble* res)
+  {
+    vector<DDouble> y2( n), work( n);
+    spl_init_kernel( x, v, n, false, 0., false, 0., &y2[ 0], &work[ 0]);
+    if( singlePrec)
+      for( SizeT i = 0; i < n; ++i) y2[ i] = static_cast<DFloat>( y2[ i]);
+
+#pragma omp parallel for if (nOut >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nOut))
+    for( OMPInt i = 0; i < nOut; ++i)
+      {
+	spl_interp_kernel( x, v, &y2[ 0], n, u[ i], res[ i]);
+	if( singlePrec) res[ i] = static_cast<DFloat>( res[ i]);
+      }
+  }
+
+  template<typename VT, typename Grid>
+  static void interpol_piecewise( const VT* v, const Grid& g, const DDouble* u, SizeT nOut,
+				  bool quadratic, VT* res)
+  {
+    if( quadratic) interpol_quadratic( v, g, u, nOut, res);
+    else interpol_linear( v, g, u, nOut, res);
+  }
+
+  BaseGDL* interpol_fun( EnvT* e)
+  {
+    SizeT nParam = e->NParam( 2);
+    BaseGDL* p0 = e->GetParDefined( 0);
+    BaseGDL* p1 = e->GetParDefined( 1);
+
+    DType vT = p0->Type();
+    if( vT == GDL_STRING || !ConvertableType( vT))
+      e->Throw( "Expression TYPE not allowed in this context: " + e->GetParString( 0));
+    if( p1->Type() == GDL_STRING || !ConvertableType( p1->Type()))
+      e->Throw( "Expression TYPE not allowed in this context: " + e->GetParString( 1));
+
+    static int lsquadraticIx = e->KeywordIx( "LSQUADRATIC");
+    static int quadraticIx = e->KeywordIx( "QUADRATIC");
+    static int splineIx = e->KeywordIx( "SPLINE");
+    if( e->KeywordSet( lsquadraticIx))
+      e->Throw( "LSQUADRATIC keyword not supported yet.");
+    bool quadratic = e->KeywordSet( quadraticIx);
+    bool spline = e->KeywordSet( splineIx);
+
+    SizeT nV = p0->N_Elements();
+    bool isComplex = ComplexType( vT);
+    bool isDouble = (vT == GDL_DOUBLE || vT == GDL_COMPLEXDBL);
+
+    // abscissae of the output points
+    DDoubleGDL* x = NULL;
+    DDoubleGDL* u = NULL;
+    Guard<DDoubleGDL> uGuard;
+    dimension resDim;
+    if( nParam == 2)
+      {
+	if( p1->Rank() != 0)
+	  e->Throw( "In the two-parameter case the second parameter must be a scalar.");
+	DLong64 nOut;
+	e->AssureLongScalarPar( 1, nOut);
+	if( nOut < 1)
+	  e->Throw( "Array dimensions must be greater than 0.");
+	resDim = dimension( nOut);
+	u = new DDoubleGDL( resDim, BaseGDL::NOZERO);
+	uGuard.Reset( u);
+	// FINDGEN(N)/(N-1)*(NV-1), in single precision
+	DFloat den = (nOut == 1) ? 1 : nOut - 1;
+	DFloat span = nV - 1;
+	for( SizeT i = 0; i < nOut; ++i)
+	  (*u)[ i] = static_cast<DFloat>( static_cast<DFloat>( i) / den * span);
+      }
+    else
+      {
+	if( p1->N_Elements() != nV)
+	  e->Throw( "In the three-parameter case the first and second argument must be of equal length.");
+	x = e->GetParAs<DDoubleGDL>( 1);
+	BaseGDL* p2 = e->GetParDefined( 2);
+	if( !NumericType( p2->Type()) && p2->Type() != GDL_STRING)
+	  e->Throw( "Expression TYPE not allowed in this context: " + e->GetParString( 2));
+	u = e->GetParAs<DDoubleGDL>( 2);
+	resDim = p2->Dim();
+
+	for( SizeT i = 1; i < nV; ++i)
+	  if( (*x)[ i] == (*x)[ i-1])
+	    {
+	      Message( e->GetProName() + ": In the three-parameter case, the second argument must be strictly increasing or strictly decreasing.");
+	      break;
+	    }
+      }
+    SizeT nOut = u->N_Elements();
+
+    if( spline)
+      {
+	if( nV < 4)
+	  e->Throw( "At least 4 input points are needed for /SPLINE.");
+	// increasing abscissae
+	vector<DDouble> xs( nV);
+	if( x == NULL)
+	  for( SizeT i = 0; i < nV; ++i) xs[ i] = static_cast<DDouble>( i);
+	else
+	  for( SizeT i = 0; i < nV; ++i) xs[ i] = (*x)[ i];
+	bool reversed = xs[ nV-1] < xs[ 0];
+	if( reversed) reverse( xs.begin(), xs.end());
+	for( SizeT i = 1; i < nV; ++i)
+	  if( xs[ i] == xs[ i-1])
+	    e->Throw( "Bad X input (zero step in X).");
+
+	vector<DDouble> vs( nV);
+	if( isComplex)
+	  {
+	    DComplexDblGDL* v = e->GetParAs<DComplexDblGDL>( 0);
+	    DComplexDblGDL* res = new DComplexDblGDL( resDim, BaseGDL::NOZERO);
+	    Guard<DComplexDblGDL> resGuard( res);
+	    vector<DDouble> re( nOut), im( nOut);
+	    for( SizeT i = 0; i < nV; ++i) vs[ reversed ? nV-1-i : i] = (*v)[ i].real();
+	    interpol_spline( &xs[ 0], &vs[ 0], nV, &(*u)[ 0], nOut, !isDouble, &re[ 0]);
+	    for( SizeT i = 0; i < nV; ++i) vs[ reversed ? nV-1-i : i] = (*v)[ i].imag();
+	    interpol_spline( &xs[ 0], &vs[ 0], nV, &(*u)[ 0], nOut, !isDouble, &im[ 0]);
+	    for( SizeT i = 0; i < nOut; ++i) (*res)[ i] = DComplexDbl( re[ i], im[ i]);
+	    if( vT == GDL_COMPLEXDBL) return resGuard.release();
+	    return resGuard.release()->Convert2( vT, BaseGDL::CONVERT);
+	  }
+	DDoubleGDL* v = e->GetParAs<DDoubleGDL>( 0);
+	for( SizeT i = 0; i < nV; ++i) vs[ reversed ? nV-1-i : i] = (*v)[ i];
+	DDoubleGDL* res = new DDoubleGDL( resDim, BaseGDL::NOZERO);
+	Guard<DDoubleGDL> resGuard( res);
+	interpol_spline( &xs[ 0], &vs[ 0], nV, &(*u)[ 0], nOut, !isDouble, &(*res)[ 0]);
+	// result in the type of V, as FIX(..., TYPE=SIZE(V,/TYPE))
+	if( vT == GDL_DOUBLE) return resGuard.release();
+	return resGuard.release()->Convert2( vT, BaseGDL::CONVERT);
+      }
+
+    if( quadratic && nV < 3)
+      e->Throw( "At least 3 input points are needed for /QUADRATIC.");
+
+    // linear and quadratic: float result for integer input
+    DType resT = (FloatType( vT) || isComplex) ? vT : GDL_FLOAT;
+
+    if( isComplex)
+      {
+	DComplexDblGDL* v = e->GetParAs<DComplexDblGDL>( 0);
+	DComplexDblGDL* res = new DComplexDblGDL( resDim, BaseGDL::NOZERO);
+	Guard<DComplexDblGDL> resGuard( res);
+	if( nV == 1)
+	  for( SizeT i = 0; i < nOut; ++i) (*res)[ i] = (*v)[ 0];
+	else if( x == NULL)
+	  interpol_piecewise( &(*v)[ 0], RegularGrid( nV), &(*u)[ 0], nOut, quadratic, &(*res)[ 0]);
+	else
+	  interpol_piecewise( &(*v)[ 0], IrregularGrid( &(*x)[ 0], nV), &(*u)[ 0], nOut, quadratic, &(*res)[ 0]);
+	if( resT == GDL_COMPLEXDBL) return resGuard.release();
+	return resGuard.release()->Convert2( resT, BaseGDL::CONVERT);
+      }
+
+    DDoubleGDL* v = e->GetParAs<DDoubleGDL>( 0);
+    DDoubleGDL* res = new DDoubleGDL( resDim, BaseGDL::NOZERO);
+    Guard<DDoubleGDL> resGuard( res);
+    if( nV == 1)
+      for( SizeT i = 0; i < nOut; ++i) (*res)[ i] = (*v)[ 0];
+    else if( x == NULL)
+      interpol_piecewise( &(*v)[ 0], RegularGrid( nV), &(*u)[ 0], nOut, quadratic, &(*res)[ 0]);
+    else
+      interpol_piecewise( &(*v)[ 0], IrregularGrid( &(*x)[ 0], nV), &(*u)[ 0], nOut, quadratic, &(*res)[ 0]);
+    if( resT == GDL_DOUBLE) return resGuard.release();
+    return resGuard.release()->Convert2( resT, BaseGDL::CONVERT);
+  }
+
+} // namespace
@@ -0,0 +1,30 @@
+/***************************************************************************
+                          interpol.hpp  -  UNIQ(), VALUE_LOCATE() and INTERPOL()
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef INTERPOL_HPP_
+#define INTERPOL_HPP_
+
+#include "datatypes.hpp"
+#include "envt.hpp"
+
+namespace lib {
+
+  BaseGDL* uniq_fun( EnvT* e);
+  BaseGDL* value_locate_fun( EnvT* e);
+  BaseGDL* interpol_fun( EnvT* e);
+
+} // namespace
+
+#endif
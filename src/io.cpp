@@ -18,12 +18,19 @@
 #include "includefirst.hpp"
 
 #include <cstdio> // std::remove(...)
+#include <climits> // INT_MAX
+#include <system_error>
 
 #include "objects.hpp"
 #include "io.hpp"
 #ifdef __MINGW32__
 #include <unistd.h> // for close()
 #endif
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#include <sys/mman.h> // for mmap()
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
 
 #if defined(_WIN32) && !defined(__CYGWIN__)
 #define NS_INT16SZ       2
@@ -320,6 +327,16 @@ void GDLStream::Open( const string& name_,
   compress = compress_;
 
   anyStream->Open(expName,mode_,compress_);
+
+  openPath.clear();
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  char* absPath = realpath( expName.c_str(), NULL);
+  if( absPath != NULL)
+    {
+      openPath = absPath;
+      free( absPath);
+    }
+#endif
   
   swapEndian = swapEndian_;
   deleteOnClose = dOC;
@@ -401,8 +418,110 @@ void GDLStream::Flush()
     }
 }
 
+void GDLStream::Unmap()
+{
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  if( mapAddr != NULL)
+    munmap( mapAddr, mapLength);
+#endif
+  mapAddr = NULL;
+  mapLength = 0;
+}
+
+const char* GDLStream::MappedRange( SizeT offset, SizeT nBytes)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return NULL;
+#else
+  if( !IsReadable() || IsWriteable() || compress || swapEndian ||
+      xdrs != NULL || f77 || sockNum != -1)
+    return NULL;
+
+  if( offset + nBytes > mapLength)
+    {
+      // (re)map the whole file, it might have grown meanwhile
+      Unmap();
+      if( openPath.empty())
+	return NULL;
+      int fd = open( openPath.c_str(), O_RDONLY);
+      if( fd < 0)
+	return NULL;
+      struct stat st;
+      if( fstat( fd, &st) != 0 || !S_ISREG( st.st_mode) || st.st_size <= 0)
+	{
+	  close( fd);
+	  return NULL;
+	}
+      void* addr = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      close( fd);
+      if( addr == MAP_FAILED)
+	return NULL;
+      mapAddr = static_cast<char*>( addr);
+      mapLength = st.st_size;
+      if( offset + nBytes > mapLength)
+	return NULL;
+    }
+  return mapAddr + offset;
+#endif
+}
+
+void GDLStream::ReadAheadOff()
+{
+  if( aheadFd != -1)
+    close( aheadFd);
+  aheadFd = -1;
+  aheadSize = 0;
+  aheadPos = 0;
+}
+
+void GDLStream::ReadAhead( SizeT blockSize)
+{
+  ReadAheadOff();
+  if( anyStream == NULL || !anyStream->IsOpen())
+    return;
+
+  if( compress)
+    {
+      if( anyStream->IgzStream() != NULL)
+	anyStream->IgzStream()->rdbuf()->setReadAhead( blockSize);
+      return;
+    }
+#if defined(POSIX_FADV_WILLNEED)
+  if( blockSize == 0 || sockNum != -1 || openPath.empty())
+    return;
+  // the fstream does not expose its descriptor, hence a second one.
+  // WILLNEED acts on the page cache of the file, shared by both; the
+  // access pattern hints (SEQUENTIAL...) would only apply to this one
+  aheadFd = open( openPath.c_str(), O_RDONLY);
+  if( aheadFd == -1)
+    return;
+  aheadSize = blockSize;
+  Prefetch();
+#endif
+}
+
+void GDLStream::Prefetch()
+{
+#if defined(POSIX_FADV_WILLNEED)
+  if( aheadFd == -1 || anyStream->FStream() == NULL)
+    return;
+  // two blocks are kept requested: the kernel reads the next one while
+  // the current one is consumed (the request does not block)
+  std::streampos pos = anyStream->FStream()->tellg();
+  if( pos == std::streampos( -1))
+    return;
+  SizeT cur = static_cast<SizeT>( pos);
+  if( cur + aheadSize <= aheadPos && cur + 2 * aheadSize >= aheadPos)
+    return;
+  posix_fadvise( aheadFd, cur, 2 * aheadSize, POSIX_FADV_WILLNEED);
+  aheadPos = cur + 2 * aheadSize;
+#endif
+}
+
 void GDLStream::Close() 
 { 
+  Unmap();
+  ReadAheadOff();
   if( anyStream != NULL)
     {
       anyStream->Close();
@@ -410,6 +529,7 @@ void GDLStream::Close()
 	std::remove(name.c_str());
     }
   name="";
+  openPath.clear();
   f77=false;
   swapEndian=false;
   compress=false;
@@ -721,10 +841,14 @@ gzstreambuf* gzstreambuf::open( const char* name, int open_mode) {
 
 gzstreambuf * gzstreambuf::close() {
     if ( is_open()) { //reset buf to 0 position: solves bug #724
+        aheadWait();
+        aheadSize = 0;
         setg( buffer + buf4,     // beginning of putback area
               buffer + buf4,     // read position
               buffer + buf4);    // end position      
          sync();
+        std::vector<char>().swap( aheadBuf[0]);
+        std::vector<char>().swap( aheadBuf[1]);
         opened = 0;
         position=0;
         if ( gzclose( file) == Z_OK)
@@ -743,6 +867,20 @@ int gzstreambuf::underflow() { // used for input buffer only
     int n_putback = gptr() - eback();
     if ( n_putback > buf4)
         n_putback = buf4;
+
+    if ( aheadSize > 0) {
+        // take the block inflated meanwhile, start on the next one
+        int num = aheadWait();
+        if ( num <= 0) // ERROR or EOF
+            return EOF;
+        memcpy( &aheadBuf[1][buf4 - n_putback], gptr() - n_putback, n_putback);
+        aheadBuf[0].swap( aheadBuf[1]);
+        aheadStart();
+        char* cur = &aheadBuf[0][0];
+        setg( cur + (buf4 - n_putback), cur + buf4, cur + buf4 + num);
+        return * reinterpret_cast<unsigned char *>( gptr());
+    }
+
     memcpy( buffer + (buf4 - n_putback), gptr() - n_putback, n_putback);
 
     int num = gzread( file, buffer+buf4, bufferSize-buf4);
@@ -758,6 +896,113 @@ int gzstreambuf::underflow() { // used for input buffer only
     return * reinterpret_cast<unsigned char *>( gptr());    
 }
 
+std::streamsize gzstreambuf::xsgetn( char* s, std::streamsize n) {
+    std::streamsize done = 0;
+    while ( done < n) {
+        std::streamsize avail = egptr() - gptr();
+        if ( avail > 0) {
+            std::streamsize take = (avail < n - done) ? avail : n - done;
+            memcpy( s + done, gptr(), take);
+            gbump( static_cast<int>( take));
+            done += take;
+            continue;
+        }
+        // (read ahead blocks must be consumed in order)
+        if ( n - done < bufferSize || aheadSize > 0) {
+            if ( underflow() == EOF)
+                break;
+            continue;
+        }
+        // large remainder: inflate straight into the destination
+        if ( ! (mode & std::ios::in) || ! opened)
+            break;
+        std::streamsize want = n - done;
+        if ( want > INT_MAX) want = INT_MAX;
+        int num = gzread( file, s + done, static_cast<unsigned>( want));
+        if ( num <= 0) // ERROR or EOF
+            break;
+        done += num;
+        // keep a putback area and an empty get area
+        int n_putback = (done < buf4) ? static_cast<int>( done) : buf4;
+        memcpy( buffer + (buf4 - n_putback), s + done - n_putback, n_putback);
+        setg( buffer + (buf4 - n_putback), buffer + buf4, buffer + buf4);
+    }
+    return done;
+}
+
+void gzstreambuf::aheadStart() {
+    if ( aheadBuf[1].size() < buf4 + aheadSize)
+        aheadBuf[1].resize( buf4 + aheadSize);
+    gzFile f = file;
+    char* dst = &aheadBuf[1][buf4];
+    unsigned n = aheadSize;
+    int* res = &aheadNum;
+    aheadPending = true;
+    try {
+        aheadThread = std::thread( [f, dst, n, res]() { *res = gzread( f, dst, n); });
+    } catch ( std::system_error&) {
+        aheadNum = gzread( file, dst, n); // no thread available: read now
+    }
+}
+
+int gzstreambuf::aheadWait() {
+    if ( ! aheadPending)
+        return 0;
+    if ( aheadThread.joinable())
+        aheadThread.join();
+    aheadPending = false;
+    return aheadNum;
+}
+
+// the pending block is dropped before the file is moved; returns its
+// size (how far the file is ahead of the get area)
+z_off_t gzstreambuf::aheadDrop() {
+    int num = aheadWait();
+    return (num > 0) ? num : 0;
+}
+
+// gztell() as seen by the reader
+z_off_t gzstreambuf::aheadTell() {
+    z_off_t off = gztell( file);
+    if ( aheadPending && aheadNum > 0)
+        off -= aheadNum;
+    return off;
+}
+
+void gzstreambuf::setReadAhead( std::streamsize blockSize) {
+    if ( blockSize > INT_MAX - buf4)
+        blockSize = INT_MAX - buf4;
+    if ( blockSize <= 0 || ! (mode & std::ios::in) || ! opened) {
+        z_off_t num = aheadDrop();
+        if ( num > 0)
+            gzseek( file, -num, SEEK_CUR);
+        aheadSize = 0;
+        return;
+    }
+    aheadSize = static_cast<unsigned>( blockSize); // effective from the next block
+    if ( ! aheadPending)
+        aheadStart();
+}
+
+std::streamsize gzstreambuf::xsputn( const char* s, std::streamsize n) {
+    if ( n < bufferSize)
+        return std::streambuf::xsputn( s, n);
+    if ( ! ( mode & std::ios::out) || ! opened)
+        return 0;
+    if ( sync() == -1)
+        return 0;
+    std::streamsize done = 0;
+    while ( done < n) {
+        std::streamsize w = n - done;
+        if ( w > INT_MAX) w = INT_MAX;
+        int num = gzwrite( file, s + done, static_cast<unsigned>( w));
+        if ( num <= 0)
+            break;
+        done += num;
+    }
+    return done;
+}
+
 int gzstreambuf::flush_buffer() {
     // Separate the writing of the buffer from overflow() and
     // sync() operation.
@@ -792,13 +1037,32 @@ int gzstreambuf::sync() {
   }
 
   std::streampos gzstreambuf::pubseekpos(std::streampos sp, std::ios_base::openmode which) {
+    if ( aheadThread.joinable())
+        aheadThread.join(); // the file is not shared with the reader thread
+    std::streampos res = doSeekPos( sp, which);
+    if ( aheadSize > 0 && ! aheadPending && opened)
+        aheadStart();
+    return res;
+  }
+
+  std::streampos gzstreambuf::pubseekoff(std::streamoff offIn, std::ios_base::seekdir way, std::ios_base::openmode which) {
+    if ( aheadThread.joinable())
+        aheadThread.join();
+    std::streampos res = doSeekOff( offIn, way, which);
+    if ( aheadSize > 0 && ! aheadPending && opened)
+        aheadStart();
+    return res;
+  }
+
+  std::streampos gzstreambuf::doSeekPos(std::streampos sp, std::ios_base::openmode which) {
     if (is_open())
     {
 //      cerr<<"seeking "<<sp<<" when we are at "<<gztell(this->file)<<endl;
       if ((which == std::ios_base::in && this->mode & std::ios::in) || /* read mode : ok */
         (which == std::ios_base::out && this->mode & std::ios::out &&
-        static_cast<z_off_t> (sp) >= gztell(this->file))) /* write mode : seek forward only */
+        static_cast<z_off_t> (sp) >= aheadTell())) /* write mode : seek forward only */
       {
+        aheadDrop();
         z_off_t off = gzseek(this->file, static_cast<z_off_t> (0), SEEK_SET); //absolutely necessary to rewind!!!
         position = 0;
         setg(buffer + buf4, buffer + buf4, buffer + buf4);
@@ -810,7 +1074,7 @@ int gzstreambuf::sync() {
         return off;
       } else
       {
-        z_off_t off=static_cast<std::streampos>(gztell(this->file)); /* Just don't Seek, no error */
+        z_off_t off=static_cast<std::streampos>(aheadTell()); /* Just don't Seek, no error */
 //        fprintf(stderr, "Tell: %d=pubseekpos(sp=%d)\n", off, static_cast<z_off_t> (sp));
         position = off;
         return off;
@@ -820,7 +1084,7 @@ int gzstreambuf::sync() {
     return -1;
   }
 
-  std::streampos gzstreambuf::pubseekoff(std::streamoff offIn, std::ios_base::seekdir way, std::ios_base::openmode which) {
+  std::streampos gzstreambuf::doSeekOff(std::streamoff offIn, std::ios_base::seekdir way, std::ios_base::openmode which) {
     // debug aid
 //    string str;
 //    switch(way)
@@ -837,8 +1101,9 @@ int gzstreambuf::sync() {
       if ((which == std::ios_base::in && this->mode & std::ios::in) || /* read mode : ok */
         (which == std::ios_base::out && this->mode & std::ios::out && /* write mode : ok if */
         ((way == std::ios_base::cur && offIn >= 0) || /* SEEK_CUR with positive offset */
-        (way == std::ios_base::beg && static_cast<z_off_t> (offIn) >= gztell(this->file))))) /* or SEEK_SET which go forward */
+        (way == std::ios_base::beg && static_cast<z_off_t> (offIn) >= aheadTell())))) /* or SEEK_SET which go forward */
       {
+        if (way == std::ios_base::cur) offIn -= aheadDrop(); else aheadDrop();
         z_off_t off = gzseek(this->file, static_cast<z_off_t> (offIn), (way == std::ios_base::beg ? SEEK_SET : SEEK_CUR));
 //        fprintf(stderr, "WRONG? Seek: %d=pubseekoff(offIn=%d,way=%s)\n", off, static_cast<z_off_t> (offIn), str.c_str());
         // GD. seems reset of buffer is needed only when rewinded at 0.
@@ -847,7 +1112,7 @@ int gzstreambuf::sync() {
         return off;
       } else
       {
-        z_off_t off=static_cast<std::streampos>(gztell(this->file)); /* Just don't Seek, no error */
+        z_off_t off=static_cast<std::streampos>(aheadTell()); /* Just don't Seek, no error */
 //        fprintf(stderr, "WRONG? Tell: %d=pubseekoff(offIn=%d,way=%s)\n", off, static_cast<z_off_t> (offIn), str.c_str());
         position = off;
         return off;
@@ -285,6 +285,9 @@ class GDLStream
   bool getLunLock;
    
   std::string name;
+  // absolute path of the file, name being relative to the directory
+  // at OPEN time (to reopen it, see MappedRange(), ReadAhead())
+  std::string openPath;
   std::ios_base::openmode mode;
 
   AnyStream* anyStream;
@@ -319,6 +322,16 @@ class GDLStream
 
   std::streampos lastSeekPos;
 
+  // read only mapping of the whole file (see MappedRange())
+  char* mapAddr;
+  SizeT mapLength;
+
+  // read ahead on plain files (see ReadAhead())
+  int aheadFd;
+  SizeT aheadSize;
+  SizeT aheadPos;
+  void ReadAheadOff();
+
   // for F77
   std::streampos lastRecord;
   std::streampos lastRecordStart;
@@ -329,6 +342,7 @@ public:
   GDLStream(): 
     getLunLock(false),
     name(), 
+    openPath(),
     mode(), 
     anyStream(NULL), 
     /*    fStream(NULL), 
@@ -350,6 +364,11 @@ public:
 
     width( defaultStreamWidth),
     lastSeekPos( 0),
+    mapAddr( NULL),
+    mapLength( 0),
+    aheadFd( -1),
+    aheadSize( 0),
+    aheadPos( 0),
     lastRecord( 0),
     lastRecordStart( 0)
     {
@@ -362,6 +381,8 @@ public:
 
   ~GDLStream() 
   {
+    Unmap();
+    ReadAheadOff();
     delete xdrs;
 
     delete anyStream;
@@ -383,6 +404,19 @@ public:
   void Flush(); 
 
   void Close(); 
+
+  // bytes [offset, offset+nBytes[ of the file through a memory mapping,
+  // NULL if the unit is not a plain read only file in native byte order
+  // or the range is beyond its end (used by ASSOC)
+  const char* MappedRange( SizeT offset, SizeT nBytes);
+  void Unmap();
+
+  // reading ahead blocks of blockSize bytes (0: off) while the
+  // interpreter works: compressed units inflate in a second thread,
+  // for plain files the kernel is asked to fetch the next blocks
+  void ReadAhead( SizeT blockSize);
+  // to be called after reading, keeps the next block(s) requested
+  void Prefetch();
   
   bool Eof()
   {
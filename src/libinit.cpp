@@ -42,6 +42,10 @@
 #include "gsl_fun.hpp"
 
 #include "where.hpp"
+#include "interpol.hpp"
+#include "correlate.hpp"
+#include "read_csv.hpp"
+#include "write_csv.hpp"
 #include "convol.hpp"
 #include "smooth.hpp"
 #include "brent.hpp"
@@ -85,7 +89,7 @@ void LibInit()
 
   const char KLISTEND[] = "";
 
-  const string restoreKey[]={ "FILENAME","DESCRIPTION","VERBOSE", KLISTEND};
+  const string restoreKey[]={ "FILENAME","DESCRIPTION","VERBOSE","VARIABLES", KLISTEND};
   const string restoreWarnKey[]={"NO_COMPILE", "RELAXED_STRUCTURE_ASSIGNMENT", "RESTORED_OBJECTS" , KLISTEND};
   new DLibPro(lib::gdl_restore,string("RESTORE"),1,restoreKey,restoreWarnKey);
   
@@ -256,6 +260,15 @@ void LibInit()
   const string file_linesKey[]={"NOEXPAND_PATH","COMPRESS",KLISTEND};
   new DLibFunRetNew(lib::file_lines,string("FILE_LINES"),1,file_linesKey);
 
+  const string read_csvKey[]={"COUNT","HEADER","MISSING_VALUE","NUM_RECORDS",
+			      "N_TABLE_HEADER","RECORD_START","TABLE_HEADER",
+			      "TYPES",KLISTEND};
+  new DLibFunRetNew(lib::read_csv_fun,string("READ_CSV"),1,read_csvKey);
+  new DLibFunRetNew(lib::read_ascii_internal_fun,string("READ_ASCII_INTERNALGDL"),3);
+
+  const string write_csvKey[]={"DELIMITER","HEADER","PRECISION","TABLE_HEADER",KLISTEND};
+  new DLibPro(lib::write_csv,string("WRITE_CSV"),9,write_csvKey);
+
   const string file_mkdirKey[]={"NOEXPAND_PATH",KLISTEND};
   new DLibPro(lib::file_mkdir,string("FILE_MKDIR"),-1,file_mkdirKey);
 
@@ -417,6 +430,7 @@ void LibInit()
 			  "SWAP_IF_LITTLE_ENDIAN" /*12*/,
 			  "VAX_FLOAT","WIDTH","XDR", "BLOCK",
 			  "NOAUTOMODE","BINARY","STREAM",
+			  "READ_AHEAD",
 			  KLISTEND};
   const string openWarnKey[]={"INITIALSIZE","EXTENDSIZE",KLISTEND}; // VAX only
   new DLibPro(lib::openr,string("OPENR"),3,openKey,openWarnKey);
@@ -496,6 +510,9 @@ void LibInit()
   new DLibFunRetNew(lib::replicate,string("REPLICATE"),9,NULL,NULL,true);
   new DLibPro(lib::replicate_inplace_pro,string("REPLICATE_INPLACE"),6);
 
+  const string array_indicesKey[]={"DIMENSIONS",KLISTEND};
+  new DLibFunRetNew(lib::array_indices,string("ARRAY_INDICES"),2,array_indicesKey);
+
   new DLibFunDirect(lib::sin_fun,string("SIN"));
   new DLibFunDirect(lib::cos_fun,string("COS"));
   new DLibFunDirect(lib::tan_fun,string("TAN"));//,1,NULL,NULL,true);
@@ -548,6 +565,17 @@ void LibInit()
   const string whereKey[]={"COMPLEMENT","NCOMPLEMENT","NULL","L64",KLISTEND};
   new DLibFunRetNew(lib::where_fun,string("WHERE"),2,whereKey);
 
+  new DLibFunRetNew(lib::uniq_fun,string("UNIQ"),2);
+  const string value_locateKey[]={"L64",KLISTEND};
+  new DLibFunRetNew(lib::value_locate_fun,string("VALUE_LOCATE"),2,value_locateKey);
+  const string interpolKey[]={"LSQUADRATIC","QUADRATIC","SPLINE",KLISTEND};
+  new DLibFunRetNew(lib::interpol_fun,string("INTERPOL"),3,interpolKey);
+
+  const string correlateKey[]={"COVARIANCE","DOUBLE",KLISTEND};
+  new DLibFunRetNew(lib::correlate_fun,string("CORRELATE"),2,correlateKey);
+  new DLibFunRetNew(lib::c_correlate_fun,string("C_CORRELATE"),3,correlateKey);
+  new DLibFunRetNew(lib::a_correlate_fun,string("A_CORRELATE"),2,correlateKey);
+
   const string totalKey[]={"CUMULATIVE","DOUBLE","NAN","INTEGER","PRESERVE_TYPE",KLISTEND};
   new DLibFunRetNew(lib::total_fun,string("TOTAL"),2,totalKey,NULL,true);
 
@@ -1050,5 +1078,17 @@ void LibInit()
   new DLibPro(lib::sem_delete, string("SEM_DELETE"), 1);
   new DLibFunRetNew(lib::sem_lock, string("SEM_LOCK"), 1);
   new DLibPro(lib::sem_release, string("SEM_RELEASE"), 1);
+
+  const string shmmapKey[] = {"BYTE", "COMPLEX", "DCOMPLEX", "DESTROY_SEGMENT",
+    "DIMENSION", "DOUBLE", "FILENAME", "FLOAT", "GET_NAME", "GET_OS_HANDLE",
+    "INTEGER", "L64", "LONG", "OFFSET", "OS_HANDLE", "SIZE", "TYPE", "UINT",
+    "UL64", "ULONG", KLISTEND };
+  const string shmmapWarnKey[] = {"PRIVATE", "SYSV", KLISTEND };
+  new DLibPro(lib::shmmap_pro, string("SHMMAP"), 9, shmmapKey, shmmapWarnKey);
+  const string shmvarKey[] = {"BYTE", "COMPLEX", "DCOMPLEX", "DIMENSION",
+    "DOUBLE", "FLOAT", "INTEGER", "L64", "LONG", "SIZE", "TYPE", "UINT",
+    "UL64", "ULONG", KLISTEND };
+  new DLibFunRetNew(lib::shmvar_fun, string("SHMVAR"), 9, shmvarKey);
+  new DLibPro(lib::shmunmap_pro, string("SHMUNMAP"), 1);
 }
 
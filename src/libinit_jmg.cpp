@@ -129,9 +129,14 @@ void LibInit_jmg()
 
   const string histogramKey[]={"BINSIZE","INPUT","MAX","MIN","NBINS",
 			       "OMAX","OMIN","REVERSE_INDICES",
-			       "LOCATIONS","NAN",KLISTEND};
-  const string histogramWarnKey[]={"L64",KLISTEND};
-  new DLibFunRetNew(lib::histogram_fun,string("HISTOGRAM"),1,histogramKey,histogramWarnKey);
+			       "LOCATIONS","NAN","L64",KLISTEND};
+  new DLibFunRetNew(lib::histogram_fun,string("HISTOGRAM"),1,histogramKey);
+
+  const string hist_ndKey[]={"MAX","MIN","NBINS","REVERSE_INDICES","WEIGHTS",KLISTEND};
+  new DLibFunRetNew(lib::hist_nd_fun,string("HIST_ND"),2,hist_ndKey);
+
+  const string hist_2dKey[]={"BIN1","BIN2","MAX1","MAX2","MIN1","MIN2",KLISTEND};
+  new DLibFunRetNew(lib::hist_2d_fun,string("HIST_2D"),2,hist_2dKey);
 
   const string interpolateKey[]={"CUBIC","DOUBLE","GRID","MISSING","NEAREST_NEIGHBOUR",KLISTEND};
   new DLibFunRetNew(lib::interpolate_fun,string("INTERPOLATE"),4,interpolateKey);
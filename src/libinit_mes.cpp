@@ -52,6 +52,8 @@ void LibInit_mes()
   const string strtokKey[]={"EXTRACT","ESCAPE","LENGTH",
 			    "PRESERVE_NULL","REGEX","COUNT","FOLD_CASE",KLISTEND};
   new DLibFunRetNew(lib::strtok_fun, string("STRTOK"), 2, strtokKey);
+  // same keywords (and order) as STRTOK: strsplit_fun calls strtok_fun
+  new DLibFunRetNew(lib::strsplit_fun, string("STRSPLIT"), 2, strtokKey);
 
 
   new DLibPro(lib::setenv_pro, string("SETENV"), 1);
@@ -65,6 +67,9 @@ void LibInit_mes()
   const string stregexKey[] = {"BOOLEAN", "EXTRACT", "LENGTH",
          "SUBEXPR", "FOLD_CASE", KLISTEND};
   new DLibFunRetNew(lib::stregex_fun, string("STREGEX"), 2, stregexKey);
+
+  const string strmatchKey[] = {"FOLD_CASE", KLISTEND};
+  new DLibFunRetNew(lib::strmatch_fun, string("STRMATCH"), 2, strmatchKey);
  
   const string structAssignKey[] = {"NOZERO", "VERBOSE", KLISTEND};
   new DLibPro(lib::struct_assign_pro, string("STRUCT_ASSIGN"), 2, structAssignKey);
@@ -93,9 +98,13 @@ void LibInit_mes()
 #ifdef USE_HDF5
   // hdf5 procedures/functions 
   new DLibFunRetNew(lib::h5f_create_fun, string("H5F_CREATE"), 1);
-  new DLibFunRetNew(lib::h5f_open_fun, string("H5F_OPEN"), 1);
-  new DLibFunRetNew(lib::h5d_open_fun, string("H5D_OPEN"), 2);
-  new DLibFunRetNew(lib::h5d_read_fun, string("H5D_READ"), 1); // TODO: 2nd argument & keywords
+  const string h5f_openKey[] = {"WRITE", KLISTEND};
+  new DLibFunRetNew(lib::h5f_open_fun, string("H5F_OPEN"), 1, h5f_openKey);
+  const string h5d_openKey[] = {"CHUNK_CACHE_PREEMPTION", "CHUNK_CACHE_SIZE",
+				"CHUNK_CACHE_SLOTS", KLISTEND};
+  new DLibFunRetNew(lib::h5d_open_fun, string("H5D_OPEN"), 2, h5d_openKey);
+  const string h5d_readKey[] = {"FILE_SPACE", "MEMORY_SPACE", KLISTEND};
+  new DLibFunRetNew(lib::h5d_read_fun, string("H5D_READ"), 1, h5d_readKey); // TODO: 2nd argument
   new DLibFunRetNew(lib::h5d_get_space_fun, string("H5D_GET_SPACE"), 1);
   new DLibFunRetNew(lib::h5s_get_simple_extent_dims_fun,
 	       string("H5S_GET_SIMPLE_EXTENT_DIMS"), 1);
@@ -120,6 +129,18 @@ void LibInit_mes()
   new DLibPro(lib::h5g_close_pro, string("H5G_CLOSE"), 1);
   new DLibFunRetNew(lib::h5g_open_fun, string("H5G_OPEN"), 2);
 
+  const string h5s_create_simpleKey[] = {"MAX_DIMENSIONS", KLISTEND};
+  new DLibFunRetNew(lib::h5s_create_simple_fun, string("H5S_CREATE_SIMPLE"), 1,
+		    h5s_create_simpleKey);
+  const string h5s_select_hyperslabKey[] = {"BLOCK", "RESET", "STRIDE", KLISTEND};
+  new DLibPro(lib::h5s_select_hyperslab_pro, string("H5S_SELECT_HYPERSLAB"), 3,
+	      h5s_select_hyperslabKey);
+  new DLibFunRetNew(lib::h5t_idl_create_fun, string("H5T_IDL_CREATE"), 1);
+  const string h5d_createKey[] = {"CHUNK_DIMENSIONS", "GZIP", "SHUFFLE", KLISTEND};
+  new DLibFunRetNew(lib::h5d_create_fun, string("H5D_CREATE"), 4, h5d_createKey);
+  const string h5d_writeKey[] = {"FILE_SPACE", "MEMORY_SPACE", KLISTEND};
+  new DLibPro(lib::h5d_write_pro, string("H5D_WRITE"), 2, h5d_writeKey);
+
   // SA: disabling the default HDF5 error handler (error handling in hdf5_fun.cpp)
   H5Eset_auto(NULL, NULL);
 #endif
@@ -889,6 +889,48 @@ BaseGDL* LIST___OverloadEQOp( EnvUDT* e)
 }
   
   
+  // a new LIST of the elements of data (owned by the list afterwards,
+  // NULL for !NULL), for library functions returning a LIST
+  BaseGDL* LIST_NewFromData( EnvT* e, std::vector<BaseGDL*>& data)
+  {
+    GDL_LIST_STRUCT()
+    GDL_CONTAINER_NODE()
+
+    DStructDesc* listDesc = structDesc::LIST;
+    DStructDesc* containerDesc = structDesc::GDL_CONTAINER_NODE;
+
+    DStructGDL* listStruct= new DStructGDL( listDesc, dimension());
+    DObj objID= e->NewObjHeap( 1, listStruct); // owns objStruct
+    BaseGDL* newObj = new DObjGDL( objID); // the list object
+
+    DStructGDL* cStructLast = NULL;
+    DStructGDL* cStruct = NULL;
+    DPtr cID = 0;
+    for( SizeT i=0; i<data.size(); ++i)
+    {
+      DPtr dID = e->Interpreter()->NewHeap(1,data[ i]);
+      data[ i] = NULL;
+
+      cStruct = new DStructGDL( containerDesc, dimension());
+      cID = e->Interpreter()->NewHeap(1,cStruct);
+      (*static_cast<DPtrGDL*>( cStruct->GetTag( pDataTag, 0)))[0] = dID;
+
+      if( cStructLast != NULL)
+    (*static_cast<DPtrGDL*>( cStructLast->GetTag( pNextTag, 0)))[0] = cID;
+      else
+      { // 1st element
+    (*static_cast<DPtrGDL*>( listStruct->GetTag( pTailTag, 0)))[0] = cID;
+      }
+
+      cStructLast = cStruct;
+    }
+
+    (*static_cast<DPtrGDL*>( listStruct->GetTag( pHeadTag, 0)))[0] = cID;
+    (*static_cast<DLongGDL*>( listStruct->GetTag( nListTag, 0)))[0] = data.size();
+
+    return newObj;
+  }
+
   BaseGDL* LIST___OverloadPlus( EnvUDT* e)
   {
     SizeT nParam = e->NParam(); // number of parameters actually given
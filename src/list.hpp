@@ -57,6 +57,7 @@ namespace lib {
 
    BaseGDL* list__isempty( EnvUDT* e);
    SizeT LIST_count( DStructGDL* oStructGDL);
+   BaseGDL* LIST_NewFromData( EnvT* e, std::vector<BaseGDL*>& data);
    BaseGDL* list__count( EnvUDT* e);
    BaseGDL* list__where( EnvUDT* e);
 // these added in order to accomodate being an IDL_CONTAINER:  
@@ -540,6 +540,83 @@ namespace lib {
   // SPLINE
   // what does not work like IDL : warning messages when Inf/Nan or Zero/Negative X steps, X and Y not same size
 
+  // second derivatives y2[0..n-1] of the cubic spline through (x,y),
+  // natural unless the first derivatives at the ends are given.
+  // u[0..n-1] is workspace. Shared by SPL_INIT and INTERPOL(/SPLINE)
+  void spl_init_kernel( const DDouble* Xpos, const DDouble* Ypos, SizeT nElpXpos,
+			bool useYP0, DDouble yp0, bool useYPN, DDouble ypn,
+			DDouble* res, DDouble* U)
+  {
+    SizeT count;
+    if( useYP0){
+      res[0]=-0.5;
+      U[0] = ( 3. / (Xpos[1]-Xpos[0])) * ((Ypos[1]-Ypos[0]) /
+					   (Xpos[1]-Xpos[0]) - yp0 );
+    }else{
+      // YP0 is omitted or equal to Inf
+      res[0]=0.;
+      U[0]=0.;
+    }
+
+    double psig, pu, x, xm, xp, y, ym, yp, p, dx, qn;
+
+    for (count = 1; count < nElpXpos-1; ++count) {
+      x=Xpos[count];
+      xm=Xpos[count-1];
+      xp=Xpos[count+1];
+      psig=(x-xm)/(xp-xm);
+
+      y=Ypos[count];
+      ym=Ypos[count-1];
+      yp=Ypos[count+1];
+      pu=((ym-y)/(xm-x)-(y-yp)/(x-xp))/(xm-xp);
+
+      p=psig*res[count-1]+2.;
+      res[count]=(psig-1.)/p;
+      U[count]=(6.00*pu-psig*U[count-1])/p;
+    }
+
+    if( useYPN){
+      res[nElpXpos-1] =0.;
+      qn=0.5;
+
+      dx=(Xpos[nElpXpos-1]-Xpos[nElpXpos-2]);
+      U[nElpXpos-1]= (3./dx)*(ypn-(Ypos[nElpXpos-1]-Ypos[nElpXpos-2])/dx);
+
+    }else{
+      // YPN_1 is omitted or equal to Inf
+      qn=0.;
+      U[nElpXpos-1]=0.;
+    }
+
+    res[nElpXpos-1] =(U[nElpXpos-1]-qn*U[nElpXpos-2])/(qn*res[nElpXpos-2]+ 1.);
+
+    for (count = nElpXpos-2; count != -1; --count){
+      res[count] =res[count]*res[count+1]+U[count];
+    }
+  }
+
+  // value at xcur of the spline (Xpos,Ypos,Yderiv2), Xpos increasing.
+  // Returns false for a zero step in Xpos
+  bool spl_interp_kernel( const DDouble* Xpos, const DDouble* Ypos, const DDouble* Yderiv2,
+			  SizeT nElpXpos, DDouble xcur, DDouble& res)
+  {
+    SizeT ilo=0;
+    SizeT ihi=nElpXpos-1;
+    while ((ihi-ilo) > 1){
+      SizeT imiddle=(ilo+ihi)/2;
+      if (Xpos[imiddle] > xcur) ihi=imiddle;
+      else ilo=imiddle;
+    }
+    double h=Xpos[ihi]-Xpos[ilo];
+    if (abs(h) == 0.0) return false;
+    double aa=(Xpos[ihi]-xcur)/h;
+    double bb=(xcur-Xpos[ilo])/h;
+    res=aa*Ypos[ilo]+bb*Ypos[ihi];
+    res=res+((aa*aa*aa-aa)*Yderiv2[ilo]+(bb*bb*bb-bb)*Yderiv2[ihi])*(h*h)/6.;
+    return true;
+  }
+
   BaseGDL* spl_init_fun( EnvT* e)
   {
     static int HELPIx=e->KeywordIx("HELP");
@@ -621,59 +698,26 @@ namespace lib {
     static int yp0Ix=e->KeywordIx("YP0");
     BaseGDL* Yderiv0=e->GetKW(yp0Ix);
     DDoubleGDL* YP0;
-
+    bool useYP0 = false;
+    DDouble yp0 = 0.;
     if(Yderiv0 !=NULL && !isinf((*(YP0=e->GetKWAs<DDoubleGDL>(yp0Ix)))[0] )){
       // first derivative at the point X0 is defined and different to Inf
-      (*res)[0]=-0.5;
-      (*U)[0] = ( 3. / ((*Xpos)[1]-(*Xpos)[0])) * (((*Ypos)[1]-(*Ypos)[0]) /
-						   ((*Xpos)[1]-(*Xpos)[0]) - (*YP0)[0] );
-
-    }else{
-      // YP0 is omitted or equal to Inf
-      (*res)[0]=0.;
-      (*U)[0]=0.;
-    }
-
-    double psig, pu, x, xm, xp, y, ym, yp, p, dx, qn;
-
-    for (count = 1; count < nElpXpos-1; ++count) {
-      x=(*Xpos)[count];
-      xm=(*Xpos)[count-1];
-      xp=(*Xpos)[count+1];
-      psig=(x-xm)/(xp-xm);
-
-      y=(*Ypos)[count];
-      ym=(*Ypos)[count-1];
-      yp=(*Ypos)[count+1];
-      pu=((ym-y)/(xm-x)-(y-yp)/(x-xp))/(xm-xp);
-
-      p=psig*(*res)[count-1]+2.;
-      (*res)[count]=(psig-1.)/p;
-      (*U)[count]=(6.00*pu-psig*(*U)[count-1])/p;
+      useYP0 = true;
+      yp0 = (*YP0)[0];
     }
     static int ypn_1Ix=e->KeywordIx("YPN_1");
     BaseGDL* YderivN=e->GetKW(ypn_1Ix);
     DDoubleGDL* YPN;
-
+    bool useYPN = false;
+    DDouble ypn = 0.;
     if(YderivN !=NULL && !isinf((*(YPN=e->GetKWAs<DDoubleGDL>(ypn_1Ix)))[0] )){
       // first derivative at the point XN-1 is defined and different to Inf
-      (*res)[nElpXpos-1] =0.;
-      qn=0.5;
-
-      dx=((*Xpos)[nElpXpos-1]-(*Xpos)[nElpXpos-2]);
-      (*U)[nElpXpos-1]= (3./dx)*((*YPN)[0]-((*Ypos)[nElpXpos-1]-(*Ypos)[nElpXpos-2])/dx);
-
-    }else{
-      // YPN_1 is omitted or equal to Inf
-      qn=0.;
-      (*U)[nElpXpos-1]=0.;
+      useYPN = true;
+      ypn = (*YPN)[0];
     }
 
-    (*res)[nElpXpos-1] =((*U)[nElpXpos-1]-qn*(*U)[nElpXpos-2])/(qn*(*res)[nElpXpos-2]+ 1.);
-
-    for (count = nElpXpos-2; count != -1; --count){
-      (*res)[count] =(*res)[count]*(*res)[count+1]+(*U)[count];
-    }
+    spl_init_kernel( &(*Xpos)[0], &(*Ypos)[0], nElpXpos, useYP0, yp0, useYPN, ypn,
+		     &(*res)[0], &(*U)[0]);
 
     GM_CV0();
 
@@ -716,28 +760,10 @@ namespace lib {
     DDoubleGDL* res;
     res = new DDoubleGDL(nElpXnew, BaseGDL::NOZERO);
 
-    int debug =0;
-    SizeT ilo, ihi, imiddle;
-    double xcur, xposcur, h, aa, bb;
-
     for (SizeT count = 0; count < nElpXnew; ++count) {
-      xcur=(*Xnew)[count];
-      ilo=0;
-      ihi=nElpXpos-1;
-      while ((ihi-ilo) > 1){
-	imiddle=(ilo+ihi)/2;
-	xposcur=(*Xpos)[imiddle];
-	if (xposcur > xcur) ihi=imiddle;
-	else ilo=imiddle;
-      }
-      h=(*Xpos)[ihi]-(*Xpos)[ilo];
-      if (abs(h) == 0.0)  e->Throw("SPL_INTERP: Bad XA input (XA not ordered or zero step in XA).");
-
-      if (debug == 1) cout << "h " << h << " lo/hi" << ilo << " " <<ihi<< endl;
-      aa=((*Xpos)[ihi]-xcur)/h;
-      bb=(xcur-(*Xpos)[ilo])/h;
-      (*res)[count]=aa*(*Ypos)[ilo]+bb*(*Ypos)[ihi];
-      (*res)[count]=(*res)[count]+((aa*aa*aa-aa)*(*Yderiv2)[ilo]+(bb*bb*bb-bb)*(*Yderiv2)[ihi])*(h*h)/6.;
+      if( !spl_interp_kernel( &(*Xpos)[0], &(*Ypos)[0], &(*Yderiv2)[0], nElpXpos,
+			      (*Xnew)[count], (*res)[count]))
+	e->Throw("SPL_INTERP: Bad XA input (XA not ordered or zero step in XA).");
     }
 
     GM_CV0();
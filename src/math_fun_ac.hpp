@@ -32,6 +32,12 @@ namespace lib {
 
   BaseGDL* spl_init_fun( EnvT* e);
   BaseGDL* spl_interp_fun( EnvT* e);
+  // cubic spline kernels, also used by INTERPOL(/SPLINE)
+  void spl_init_kernel( const DDouble* x, const DDouble* y, SizeT n,
+			bool useYP0, DDouble yp0, bool useYPN, DDouble ypn,
+			DDouble* y2, DDouble* work);
+  bool spl_interp_kernel( const DDouble* x, const DDouble* y, const DDouble* y2,
+			  SizeT n, DDouble xcur, DDouble& res);
 
   BaseGDL* sobel_fun( EnvT* e);
   BaseGDL* roberts_fun( EnvT* e);
@@ -78,6 +78,29 @@
     }
   }
 #endif    
+  if (step == 1 && !useAbs)
+  {
+    DLong minEl = start;
+    DLong maxEl = start;
+    if (MinMaxContiguous(&(*this)[0], start, stop, omitNaN,
+      (minE != NULL || minVal != NULL), (maxE != NULL || maxVal != NULL), minEl, maxEl,
+      std::integral_constant<bool, std::is_arithmetic<Ty>::value>()))
+    {
+      if (maxE != NULL) *maxE = maxEl;
+      if (maxVal != NULL)
+      {
+        if (valIx == -1) *maxVal = new Data_((*this)[maxEl]);
+        else (*static_cast<Data_*> (*maxVal))[valIx] = (*this)[maxEl];
+      }
+      if (minE != NULL) *minE = minEl;
+      if (minVal != NULL)
+      {
+        if (valIx == -1) *minVal = new Data_((*this)[minEl]);
+        else (*static_cast<Data_*> (*minVal))[valIx] = (*this)[minEl];
+      }
+      return;
+    }
+  }
   if (minE == NULL && minVal == NULL)
   {
     DLong maxEl = start;
@@ -103,7 +126,7 @@
 #endif
     } else
     {
-      Ty* maxVArray= new Ty[CpuTPOOL_NTHREADS];
+      std::vector<Ty> maxVArray(CpuTPOOL_NTHREADS);
       SizeT maxElArray[CpuTPOOL_NTHREADS];
 //precaution:initialize to something realistic:
       for (int i = 0; i < CpuTPOOL_NTHREADS; ++i) {maxVArray[i]=maxV;maxElArray[i]=maxEl;}
@@ -216,7 +239,7 @@
 #endif
     } else
     {
-      Ty* minVArray=new Ty[CpuTPOOL_NTHREADS];
+      std::vector<Ty> minVArray(CpuTPOOL_NTHREADS);
       SizeT minElArray[CpuTPOOL_NTHREADS];
 //precaution:initialize to something realistic:
       for (int i = 0; i < CpuTPOOL_NTHREADS; ++i) {minVArray[i]=minV;minElArray[i]=minEl;}
@@ -335,9 +358,9 @@
     } else
     {
 
-      Ty* maxVArray=new Ty[CpuTPOOL_NTHREADS];
+      std::vector<Ty> maxVArray(CpuTPOOL_NTHREADS);
       SizeT maxElArray[CpuTPOOL_NTHREADS];
-      Ty* minVArray=new Ty[CpuTPOOL_NTHREADS];
+      std::vector<Ty> minVArray(CpuTPOOL_NTHREADS);
       SizeT minElArray[CpuTPOOL_NTHREADS];
 //precaution:initialize to something realistic:
       for (int i = 0; i < CpuTPOOL_NTHREADS; ++i) {maxVArray[i]=maxV;maxElArray[i]=maxEl;}
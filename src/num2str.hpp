@@ -0,0 +1,114 @@
+/***************************************************************************
+                       num2str.hpp  -  fast number to string conversion
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+// number -> string for the implicit conversions (STRING(), string
+// concatenation, Convert2, GetAsString).
+// Output is identical to i2s(val,w) and to OutAuto(os,val,w,d,0), but it
+// is formatted into a stack buffer instead of going through one to three
+// ostringstream per element.
+// GDL runs with LC_NUMERIC "C" (see gdl.cpp), so snprintf() does not
+// depend on the user's locale.
+
+#ifndef NUM2STR_HPP_
+#define NUM2STR_HPP_
+
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <limits>
+
+#include "ofmt.hpp" // OutAuto
+
+// integer right aligned in a field of (at least) w characters, as i2s(val,w)
+template <typename T>
+inline std::string Int2String( const T val, const int w)
+{
+  char buf[ 32];
+  char* end = buf + sizeof( buf);
+  char* p = end;
+  // negate in unsigned arithmetic: safe for the most negative value
+  unsigned long long u = static_cast<unsigned long long>( val);
+  bool neg = std::numeric_limits<T>::is_signed && val < 0;
+  if( neg) u = 0ULL - u;
+  do {
+    *--p = static_cast<char>( '0' + u % 10);
+    u /= 10;
+  } while( u != 0);
+  if( neg) *--p = '-';
+  int len = static_cast<int>( end - p);
+  if( len >= w) return std::string( p, len);
+  std::string res( w - len, ' ');
+  res.append( p, len);
+  return res;
+}
+
+// as OutAuto( os, val, w, d, 0) (G format with default code)
+template <typename T>
+inline std::string Auto2String( const T val, const int w, const int d)
+{
+  if( !std::isfinite( val) || w <= 0)
+    {
+      std::ostringstream os;
+      OutAuto( os, val, w, d, 0);
+      return os.str();
+    }
+
+  char bufF[ 64];
+  int lenF = 0;
+  int fixLen = 1;
+  if( val == T(0.0))
+    lenF = snprintf( bufF, sizeof( bufF), "%.*f", d-1, static_cast<double>( val));
+  else
+    {
+      int powTen = static_cast<int>( std::floor( std::log10( std::abs( val))));
+      fixLen = powTen > 0 ? powTen+1 : 1;
+      if( powTen == 0 || (powTen < d && powTen > -d+1))
+	{
+	  int prec = d > fixLen ? d-fixLen+((powTen < 0) ? -powTen : 0) : 0;
+	  lenF = snprintf( bufF, sizeof( bufF)-1, "%.*f", prec, static_cast<double>( val));
+	  if( d <= fixLen) bufF[ lenF++] = '.';
+	}
+      else
+	fixLen = 0; // scientific
+    }
+
+  char bufS[ 64];
+  int lenS = snprintf( bufS, sizeof( bufS), "%.*e", d > 0 ? d-1 : 0, static_cast<double>( val));
+
+  const char* out = bufF;
+  int len = lenF;
+  if( fixLen == 0 || lenF > lenS)
+    {
+      out = bufS;
+      len = lenS;
+    }
+  if( len > w) return std::string( w, '*');
+  std::string res( w - len, ' ');
+  res.append( out, len);
+  return res;
+}
+
+// default stream output of a real number, as i2s(val)
+template <typename T>
+inline std::string Real2String( const T val)
+{
+  if( !std::isfinite( val)) return i2s( val);
+  char buf[ 32];
+  int len = snprintf( buf, sizeof( buf), "%g", static_cast<double>( val));
+  return std::string( buf, len);
+}
+
+#endif
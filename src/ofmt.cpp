@@ -74,9 +74,28 @@ std::string binstr( const Ty v, int w, int d, int code)
 }
 
 #include "ofmt.hpp"
+#include "num2str.hpp"
 
 template <typename T>
 void OutInteger(std::ostream& os, const T &val, const int w, const int d, int code, const BaseGDL::IOMode oMode) {
+ if (d <= 0 && oMode == BaseGDL::DEC) {
+  // the common case, without a stream per value ('+' with showpos for
+  // signed types only, as os << val)
+  std::string s = Int2String(val, 0);
+  if ((code & fmtSHOWPOS) && std::numeric_limits<T>::is_signed && !(val < T(0)))
+   s.insert(0, 1, '+');
+  int len = s.size();
+  if (w == 0)
+   os.write(s.data(), len);
+  else if (len > w)
+   OutStars(os, w);
+  else if (code & fmtALIGN_LEFT) {
+   os.write(s.data(), len);
+   for (int i = len; i < w; ++i) os.put(' ');
+  } else
+   OutFixFill(os, s, w, code);
+  return;
+ }
  std::ostringstream oss;
   if (d > 0) {
    std::ostringstream ossI;
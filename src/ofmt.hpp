@@ -19,6 +19,7 @@
 #define OFMT_HPP_
 
 #include <sstream>
+#include <cstdio> // snprintf
 #include <iomanip>
 #include <ostream>
 #include <cmath>
@@ -154,27 +155,54 @@ inline void OutAdjustFill(std::ostream& os, const std::string &s, const int w, c
    if ( code & fmtPAD ) os << std::setfill(' '); //which is '0' or blank at this point.
 }
 
+// the printf conversion an ostringstream with the same flags does, but
+// without building a stream for every value: length of the result, -1
+// if it does not fit into buf
+template <typename T>
+inline int FloatToChars(char* buf, const int size, const T val, const char conv, const int prec, const int code)
+{
+  char spec[8];
+  int i = 0;
+  spec[i++] = '%';
+  if ( code & fmtSHOWPOS ) spec[i++] = '+';
+  spec[i++] = '.';
+  spec[i++] = '*';
+  spec[i++] = conv;
+  spec[i] = 0;
+  int len = snprintf(buf, size, spec, prec < 0 ? 6 : prec, static_cast<double>(val));
+  return (len < 0 || len >= size) ? -1 : len;
+}
+
 template <typename T>
 void OutFixed(std::ostream& os, const T &val, const int w, const int d, const int code)
 {
   if (std::isfinite(val)) {
-   std::ostringstream oss;
-  if ( code & fmtSHOWPOS ) oss << std::showpos;
-   oss << std::fixed << std::setprecision(d) << val;
-   if (d==0) oss << ".";
+   char buf[64];
+   std::string s;
+   int len = FloatToChars(buf, sizeof(buf) - 1, val, 'f', d, code);
+   if (len >= 0) {
+    if (d==0) buf[len++] = '.';
+    s.assign(buf, len);
+   } else { // (very) large values
+    std::ostringstream oss;
+    if ( code & fmtSHOWPOS ) oss << std::showpos;
+    oss << std::fixed << std::setprecision(d) << val;
+    if (d==0) oss << ".";
+    s = oss.str();
+   }
    if( w <= 0)
-     os << oss.str();
-   else if( oss.tellp() > w)
+     os << s;
+   else if( static_cast<int>(s.length()) > w)
      OutStars( os, w);
    else if (code & fmtALIGN_LEFT) 
    {
     os << std::left;
     os << std::setw(w);
-    os << oss.str();
+    os << s;
     os << std::right;
    }
    else
-     OutFixFill(os, oss.str(), w, code);
+     OutFixFill(os, s, w, code);
   } else if (std::isnan(val))    OutFixedNan<T>( os, val, w, code);
   else OutFixedInf<T>( os, val, w, code);
 }
@@ -188,23 +216,31 @@ void OutFixed<DComplexDbl>(std::ostream& os, const DComplexDbl &val, const int w
 template <typename T>
 void OutScientific(std::ostream& os, const T &val, const int w, const int d, const int code) {
  if (std::isfinite(val)) {
-  std::ostringstream oss;
+  char buf[64];
+  std::string s;
   // TODO: IDL handles both lower and upper case "E" (tracker item no. 3147155)
-  if ( code & fmtSHOWPOS ) oss << std::showpos;
-  if ( code & fmtUPPER ) oss << std::uppercase ;
-  oss << std::scientific << std::setprecision(d) << val;
+  int len = FloatToChars(buf, sizeof(buf), val, ( code & fmtUPPER ) ? 'E' : 'e', d, code);
+  if (len >= 0)
+   s.assign(buf, len);
+  else { // (very) large precision
+   std::ostringstream oss;
+   if ( code & fmtSHOWPOS ) oss << std::showpos;
+   if ( code & fmtUPPER ) oss << std::uppercase ;
+   oss << std::scientific << std::setprecision(d) << val;
+   s = oss.str();
+  }
   if (w == 0 )
-   os << oss.str();
-  else if (oss.tellp() > w)
+   os << s;
+  else if (static_cast<int>(s.length()) > w)
    OutStars(os, w);
   else if (code & fmtALIGN_LEFT) 
   {
    os << std::left;
    os << std::setw(w);
-   os << oss.str();
+   os << s;
    os << std::right;
   }
-  else OutFixFill(os, oss.str(), w, code);
+  else OutFixFill(os, s, w, code);
  } else if (std::isnan(val)) OutFixedNan<T>(os, val, w, code);
  else OutFixedInf<T>(os, val, w, code);
 }
@@ -100,6 +100,7 @@
 ;   15-Nov-2011 : A. Coulais : better management of dir/file and
 ;                 missing file
 ;   05-Feb-2014 : G. Duvert : avoid unlawful tag names 
+;   19-Oct-2026 : no-template case parsed by READ_ASCII_INTERNALGDL
 ;
 ;-
 ; LICENCE:
@@ -299,17 +300,8 @@ rnumber = '^[+-]?([0-9]*\.?[0-9]*[ed]?[+-]?[0-9]+\.?[0-9]*|NaN|Inf|Infinity)$'
 ;------------------
 
 if N_ELEMENTS(template) eq 0 then begin
-   ncolumns = LONARR(linecount)
-   for line=0l, linecount-1 do begin
-      ncolumns[line] = N_ELEMENTS(STRSPLIT(text[line], delimiter))
-   endfor
-   ncolumn = MAX(ncolumns)
-   result = MAKE_ARRAY(ncolumn, linecount, /float, value=FLOAT(missing_value))
-   for line=0l, linecount-1 do begin
-      row = STRSPLIT(text[line], delimiter, /extract)
-      index = WHERE(STREGEX(row, rnumber, /fold_case, /boolean), count)
-      if count gt 0 then result[index, line] = float(row[index])
-   endfor
+   ;; splitting and conversion (fields matching rnumber) are native
+   result = READ_ASCII_INTERNALGDL(text, STRING(delimiter), missing_value)
    return, {field1:TEMPORARY(result)}
 endif
 ;
@@ -1390,13 +1390,23 @@ BaseGDL* POWNode::Eval()
 // ***********************
 // **** nonCopy nodes ****
 // ***********************
+// selects the "scalar op array" branch of the nonCopy nodes.
+// For scalar op scalar where only the left operand is a temporary the
+// "array op scalar" branch is taken instead, which works in place on e1
+// rather than allocating a new scalar from e2.
+inline bool LeftScalarBranch( BaseGDL* e1, BaseGDL* e2, bool e1Owned, bool e2Owned)
+{
+  if( !e1->StrictScalar()) return false;
+  return !(e1Owned && !e2Owned && e2->StrictScalar());
+}
+
 BaseGDL* AND_OPNCNode::Eval()
 { BaseGDL* res;
  Guard<BaseGDL> g1;
  Guard<BaseGDL> g2;
  BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
    {
      if( g2.get() == NULL) return e2->AndOpSNew( e1);  else  g2.release();
      res= e2->AndOpS(e1); // scalar+scalar or array+scalar
@@ -1450,7 +1460,7 @@ BaseGDL* OR_OPNCNode::Eval()
  Guard<BaseGDL> g2;
  BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
    {
      if( g2.get() == NULL) return e2->OrOpSNew( e1); else g2.release();
      res= e2->OrOpS(e1); // scalar+scalar or array+scalar
@@ -1503,7 +1513,7 @@ BaseGDL* XOR_OPNCNode::Eval()
   Guard<BaseGDL> g2;
   BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
-  if( e1->StrictScalar())
+  if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
     {
       if( g2.get() == NULL) return e2->XorOpSNew( e1); else g2.release();
       res= e2->XorOpS(e1); // scalar+scalar or array+scalar
@@ -1894,7 +1904,7 @@ BaseGDL* PLUSNCNode::Eval()
     }
   } // aTy != bTy
   
-  if ( e1->StrictScalar() )
+  if( LeftScalarBranch( e1, e2, !g1.IsNull(), !g2.IsNull()))
   {
     if ( g2.IsNull() )
     {
@@ -2161,7 +2171,7 @@ BaseGDL* MINUSNCNode::Eval()
     }
   } // aTy != bTy
  
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.Get() != NULL, g2.Get() != NULL))
    {
      if( g2.Get() == NULL) return e2->SubInvSNew( e1); else g2.Release();
      res= e2->SubInvS(e1); // scalar+scalar or array+scalar
@@ -2213,7 +2223,7 @@ BaseGDL* LTMARKNCNode::Eval()
  Guard<BaseGDL> g2;
  BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
    {
      if( g2.get() == NULL) return e2->LtMarkSNew( e1); else g2.release();
      res= e2->LtMarkS(e1); // scalar+scalar or array+scalar
@@ -2265,7 +2275,7 @@ BaseGDL* GTMARKNCNode::Eval()
  Guard<BaseGDL> g2;
  BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
    {
      if( g2.get() == NULL) return e2->GtMarkSNew( e1); else g2.release();
      res= e2->GtMarkS(e1); // scalar+scalar or array+scalar
@@ -2464,7 +2474,7 @@ BaseGDL* ASTERIXNCNode::Eval()
 	Guard<BaseGDL> g2;
 	BaseGDL *e1, *e2; AdjustTypesNC ( g1, e1, g2, e2 );
 
-	if ( e1->StrictScalar() )
+	if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
 	{
 		if ( g2.get() == NULL )
 		{
@@ -2767,7 +2777,7 @@ BaseGDL* SLASHNCNode::Eval()
  Guard<BaseGDL> g2;
  BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
    {
      if( g2.get() == NULL) return e2->DivInvSNew( e1); else g2.release();
      res= e2->DivInvS(e1); // scalar+scalar or array+scalar
@@ -2820,7 +2830,7 @@ BaseGDL* MOD_OPNCNode::Eval()
  Guard<BaseGDL> g2;
  BaseGDL *e1, *e2; AdjustTypesNC( g1, e1, g2, e2); 
 
- if( e1->StrictScalar())
+ if( LeftScalarBranch( e1, e2, g1.get() != NULL, g2.get() != NULL))
    {
      if( g2.get() == NULL) return e2->ModInvSNew( e1); else g2.release();
      res= e2->ModInvS(e1); // scalar+scalar or array+scalar
@@ -74,66 +74,69 @@ namespace lib {
     dsfmt_t **r; 
  };
  typedef struct DSFMT_STATE dsfmt_state;
-#define DEFINE_NCHUNK_FOR_dSFMT  int nchunk = (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl)) ? CpuTPOOL_NTHREADS : 1;
- 
 
-// This function could prove to be way faster than the function below, provided the parallelization insures
-// an alignment on _align16 , i.e., 2 doubles = 128 bits = address%16==0
-//
-//  int random_uniform(double* res, dsfmt_state state, SizeT nEl)
-//  {
-//    if (nEl >= dsfmt_get_min_array_size() + 1) {
-//      SizeT n = (nEl % 2) ? nEl - 1 : nEl;
-//      dsfmt_fill_array_close_open(state.r[0], res, n);
-//      if (!(n == nEl)) res[nEl - 1] = dsfmt_genrand_close_open(state.r[0]);
-//    } else {
-//      for (SizeT i = 0; i < nEl; ++i) res[i] = dsfmt_genrand_close_open(state.r[0]);
-//    }
-//    return 0;
-//  }
-  
-  int random_uniform(double* res, dsfmt_state state, SizeT nEl)
+  // Arrays are cut in at most maxNumberOfThreads() contiguous chunks, chunk i being always
+  // drawn from state i. The cut depends only on the number of elements, never on
+  // !CPU.TPOOL_NTHREADS or on the thread pool thresholds, so a given SEED gives the same
+  // values whatever the number of threads used: threads only decide who fills which chunk.
+  const SizeT RANDOM_MIN_CHUNK = 65536;
+
+  template <typename Filler>
+  void random_chunks(dsfmt_state state, SizeT nEl, const Filler& fill)
   {
-    //no difficulty as we do not use aligned functions here.
-    DEFINE_NCHUNK_FOR_dSFMT
+    SizeT nchunk = nEl / RANDOM_MIN_CHUNK;
+    if (nchunk < 1) nchunk = 1;
+    if (nchunk > (SizeT) maxNumberOfThreads()) nchunk = maxNumberOfThreads();
     SizeT chunksize = nEl / nchunk;
+#pragma omp parallel for if (nchunk > 1 && nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+    for (OMPInt i = 0; i < (OMPInt) nchunk; ++i) {
+      SizeT start = i * chunksize;
+      SizeT stop = (i == (OMPInt) nchunk - 1) ? nEl : start + chunksize;
+      fill(state.r[i], start, stop);
+    }
+  }
 
-#pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk-1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
+  // Gives exactly the values of n successive dsfmt_genrand_close1_open2() calls, minus 'offset',
+  // but reads them a whole state block at a time so that the copy loop vectorizes. Unlike
+  // dsfmt_fill_array_xxx() it keeps the state index, has no alignment or size constraint,
+  // and can be freely mixed with the dsfmt_genrand_xxx() functions.
+  template <typename T>
+  void dsfmt_fill(dsfmt_t* r, T* out, SizeT n, const double offset)
+  {
+    const double* s = &(r->status[0].d[0]);
+    while (n > 0) {
+      if (r->idx >= DSFMT_N64) {
+        dsfmt_gen_rand_all(r);
+        r->idx = 0;
       }
-      SizeT i;
-      for (i=start_index; i<stop_index; ++i) res[i] = dsfmt_genrand_close_open(state.r[thread_id]);
+      SizeT k = DSFMT_N64 - r->idx;
+      if (k > n) k = n;
+      const double* src = s + r->idx;
+      for (SizeT j = 0; j < k; ++j) out[j] = src[j] - offset;
+      r->idx += k;
+      out += k;
+      n -= k;
     }
+  }
+
+  template <typename T>
+  struct UniformFiller {
+    T* res;
+    UniformFiller(T* r) : res(r) {}
+    void operator()(dsfmt_t* r, SizeT start, SizeT stop) const {
+      dsfmt_fill(r, res + start, stop - start, 1.0); //[1,2) -> [0,1)
+    }
+  };
+
+  int random_uniform(double* res, dsfmt_state state, SizeT nEl)
+  {
+    random_chunks(state, nEl, UniformFiller<double>(res));
     return 0;
   }
 
   int random_uniform(float* res, dsfmt_state state, SizeT nEl)
   {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-
-#pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk-1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i=start_index; i<stop_index; ++i) res[i] = (float) dsfmt_genrand_close_open(state.r[thread_id]);
-    }
+    random_chunks(state, nEl, UniformFiller<float>(res));
     return 0;
   }
 
@@ -151,95 +154,44 @@ namespace lib {
     double current = sigma * y * fct;
     return current;
   }
-  
-//  //unused, but could prove useful, see comment sbelow.
-//  void dsfmt_gauss_array(dsfmt_t *r, double *ret, const SizeT n, const double sigma)
-//  {
-//    //populate array with random doubles (fastest mode)
-//    //use these randoms to make them gaussian until no more available.
-//    //complete then with singular entries.
-//    //nEl must be even and greater than 382. Only this permits the following code. 
-//    //assert(n%2==0); //There is an assert already in dSFMT!
-//    
-//    dsfmt_fill_array_close1_open2(r, ret, n); //belongs to [1,2): faster
-//    for (SizeT i=0; i< n; ++i) ret[i]=-3.+2*ret[i]; //hopefully optimized by compiler!
-//    double x, y, r2;
-//    SizeT i = 0;
-//    SizeT MARGIN=(n/5 > 512)? 512:n/5; //huge safety margin, at least 76. Probability is thus always much less than (1-PI/4)^76=210^-51
-//    SizeT index = 0;
-//    /* choose x,y in uniform square (-1,-1) to (+1,+1) */
-//    do {
-//      do {
-//        x = ret[i++];
-//        y = ret[i++];
-//        /* see if it is in the unit circle */
-//        r2 = x * x + y * y;
-//      } while (r2 > 1.0 || r2 == 0);
-//      /* Box-Muller transform */
-//      double fct = sqrt(-2.0 * log(r2) / r2);
-//      double current = sigma * y * fct;
-//      ret[index++] = current;
-//      if (index < n-1) {
-//        double other = sigma * x * fct;
-//        ret[index++] = other;
-//      }
-//    } while (i < n-MARGIN); //i always > index
-//    //finish the few last values
-//    for (SizeT k = index; k < n; ++k) ret[k] = dsfmt_gauss(r, sigma);
-//  }
-  
-// see comment about random_uniform (double) above for optimzation possibilities.
-//  int random_normal( double* res, dsfmt_state state, SizeT nEl)
-//  {
-//      if (nEl >= dsfmt_get_min_array_size() + 1) {
-//          SizeT n = (nEl % 2) ? nEl - 1 : nEl;
-//          dsfmt_gauss_array(state.r[0], res, n, 1.0);
-//          if (!(n == nEl)) res[nEl-1] = dsfmt_gauss(state.r[0], 1.0);
-//      } else {
-//        for (SizeT i = 0; i < nEl; ++i) res[i] = dsfmt_gauss(state.r[0], 1.0);
-//      }
-//    return 0;
-//  }
 
-  int random_normal(double* res, dsfmt_state state, SizeT nEl)
-  {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk-1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
+  // Plain (trigonometric) Box-Muller on blocks of uniforms: no rejection loop, both values of
+  // each pair are used, and the first and second halves of a block give the radii and
+  // angles, so that every loop runs on contiguous data. An odd last element uses dsfmt_gauss().
+  template <typename T>
+  struct NormalFiller {
+    T* res;
+    NormalFiller(T* r) : res(r) {}
+    void operator()(dsfmt_t* r, SizeT start, SizeT stop) const {
+      double u[DSFMT_N64];
+      SizeT i = start;
+      while (stop - i >= 2) {
+        SizeT n = stop - i;
+        if (n > DSFMT_N64) n = DSFMT_N64;
+        SizeT h = n / 2;
+        dsfmt_fill(r, u, 2 * h, 0.0); //[1,2)
+        T* out = res + i;
+        for (SizeT k = 0; k < h; ++k) {
+          double rho = sqrt(-2.0 * log(2.0 - u[k])); //2-u in (0,1]
+          double theta = 2.0 * M_PI * (u[h + k] - 1.0);
+          out[k] = rho * cos(theta);
+          out[h + k] = rho * sin(theta);
+        }
+        i += 2 * h;
       }
-      SizeT i;
-      for (i=start_index; i<stop_index; ++i) res[i] = dsfmt_gauss(state.r[thread_id],1.0);
+      if (i < stop) res[i] = dsfmt_gauss(r, 1.0);
     }
+  };
+
+  int random_normal(double* res, dsfmt_state state, SizeT nEl)
+  {
+    random_chunks(state, nEl, NormalFiller<double>(res));
     return 0;
   }
-  
-  int random_normal( float* res, dsfmt_state state, SizeT nEl)
+
+  int random_normal(float* res, dsfmt_state state, SizeT nEl)
   {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk-1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i=start_index; i<stop_index; ++i) res[i] = (float) dsfmt_gauss(state.r[thread_id],1.0);
-    }
+    random_chunks(state, nEl, NormalFiller<float>(res));
     return 0;
   }
  
@@ -464,45 +416,60 @@ namespace lib {
 
   }
 
+  // distributions needing rejection loops are drawn one element at a time, but still
+  // chunked as above.
+  template <typename T, typename Gen>
+  struct ElementFiller {
+    T* res;
+    Gen gen;
+    ElementFiller(T* r, const Gen& g) : res(r), gen(g) {}
+    void operator()(dsfmt_t* r, SizeT start, SizeT stop) const {
+      for (SizeT i = start; i < stop; ++i) res[i] = gen(r);
+    }
+  };
+
+  struct GammaGen {
+    double a;
+    GammaGen(double a_) : a(a_) {}
+    double operator()(dsfmt_t* r) const { return dsfmt_ran_gamma_knuth(r, a, 1.0); }
+  };
+
+  struct BinomialGen {
+    double p;
+    unsigned int n;
+    BinomialGen(double p_, unsigned int n_) : p(p_), n(n_) {}
+    double operator()(dsfmt_t* r) const { return dsfmt_ran_binomial_knuth(r, p, n); }
+  };
+
+  struct PoissonGen {
+    double mu;
+    PoissonGen(double mu_) : mu(mu_) {}
+    double operator()(dsfmt_t* r) const { return dsfmt_ran_poisson(r, mu); }
+  };
+
+  struct Int31Gen {
+    DLong operator()(dsfmt_t* r) const { return dsfmt_genrand_int31(r); } //int31 as in [0..2^31-1]
+  };
+
+  struct UInt32Gen {
+    DULong operator()(dsfmt_t* r) const { return dsfmt_genrand_uint32(r); }
+  };
+
+  template <typename T, typename Gen>
+  void random_elements(T* res, dsfmt_state state, SizeT nEl, const Gen& gen)
+  {
+    random_chunks(state, nEl, ElementFiller<T, Gen>(res, gen));
+  }
+
   int random_gamma(double* res, dsfmt_state state, SizeT nEl, DLong n)
   {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-#pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = dsfmt_ran_gamma_knuth(state.r[thread_id], 1.0 * n, 1.0);
-    }
+    random_elements(res, state, nEl, GammaGen(1.0 * n));
     return 0;
   }
 
   int random_gamma(float* res, dsfmt_state state, SizeT nEl, DLong n)
   {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-#pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = (float) dsfmt_ran_gamma_knuth(state.r[thread_id], 1.0 * n, 1.0);
-    }
+    random_elements(res, state, nEl, GammaGen(1.0 * n));
     return 0;
   }
   
@@ -511,22 +478,7 @@ namespace lib {
     //Note: Binomial values are not same IDL.    
     DULong n = (DULong) (*binomialKey)[0];
     DDouble p = (DDouble) (*binomialKey)[1];
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = dsfmt_ran_binomial_knuth(state.r[thread_id], p, n);
-    }
+    random_elements(res, state, nEl, BinomialGen(p, n));
     return 0;    
   }
   
@@ -535,108 +487,33 @@ namespace lib {
     //Note: Binomial values are not same IDL.    
     DULong n = (DULong) (*binomialKey)[0];
     DDouble p = (DDouble) (*binomialKey)[1];
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = (float) dsfmt_ran_binomial_knuth(state.r[thread_id], p, n);
-    }
+    random_elements(res, state, nEl, BinomialGen(p, n));
     return 0;    
   }
   
   int random_poisson(double* res, dsfmt_state state, SizeT nEl, DDoubleGDL* poissonKey)
   {
     DDouble mu = (DDouble) (*poissonKey)[0];
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = dsfmt_ran_poisson(state.r[thread_id], mu);
-    }
+    random_elements(res, state, nEl, PoissonGen(mu));
     return 0;
   }
 
   int random_poisson(float* res, dsfmt_state state, SizeT nEl, DDoubleGDL* poissonKey)
   {
     DDouble mu = (DDouble) (*poissonKey)[0];
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk-1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i=start_index; i<stop_index; ++i) res[i] = (float) dsfmt_ran_poisson(state.r[thread_id], mu);
-    }
+    random_elements(res, state, nEl, PoissonGen(mu));
     return 0;
   }
 
   int random_dlong(DLong* res, dsfmt_state state, SizeT nEl)
   {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = dsfmt_genrand_int31(state.r[thread_id]); //int31 as in [0..2^31-1] 
-    }
+    random_elements(res, state, nEl, Int31Gen());
     return 0;
   }
 
   int random_dulong(DULong* res, dsfmt_state state, SizeT nEl)
   {
-    DEFINE_NCHUNK_FOR_dSFMT
-    SizeT chunksize = nEl / nchunk;
-    #pragma omp parallel num_threads(nchunk) if (nchunk > 1)
-    {
-      int thread_id = currentThreadNumber();
-      SizeT start_index, stop_index;
-      start_index = thread_id * chunksize;
-      if (thread_id != nchunk - 1) //robust wrt. use of threads or not.
-      {
-        stop_index = start_index + chunksize;
-      } else {
-        stop_index = nEl;
-      }
-      SizeT i;
-      for (i = start_index; i < stop_index; ++i) res[i] = dsfmt_genrand_uint32(state.r[thread_id]); //int31 as in [0..2^31-1] 
-    }
+    random_elements(res, state, nEl, UInt32Gen());
     return 0;
   }  
   
@@ -675,7 +552,8 @@ namespace lib {
   // random numbers had been generated in the meantime. (This in a random series with a period of 2^19937 !).
   // Note: 2^128 is already way larger than the number of particles in the Universe.
   // The implementation creates maxNumberOfThreads() seed states, separated by a 2^{128} state jump,
-  // and run TPOOL_NTHREADS in parallell, each continuing with its own seed.
+  // and fills arrays by chunks, chunk i continuing with seed state i (see random_chunks()), in
+  // parallel over TPOOL_NTHREADS threads. Values do not depend on the number of threads used.
   
   // The price to pay is that **the produced random numbers are not the same as IDL**.
   // To get values comparable with IDL, but slowly, use the /RAN1 switch (1) (or do not enable dSFMT).  
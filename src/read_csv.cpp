@@ -0,0 +1,743 @@
+/***************************************************************************
+                 read_csv.cpp  -  READ_CSV() and the READ_ASCII() parser
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+// READ_CSV reads the whole file at once (memory mapped where possible),
+// finds the line boundaries in parallel chunks, infers the type of each
+// column (LONG, LONG64, DOUBLE or STRING) and parses the columns directly
+// into typed arrays, returned as the tags FIELD1..FIELDn of a structure.
+// READ_ASCII_INTERNALGDL is the parser of read_ascii.pro without template.
+
+#include "includefirst.hpp"
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "read_csv.hpp"
+#include "dstructgdl.hpp"
+#include "str.hpp"
+
+namespace lib {
+
+  using namespace std;
+
+  // the contents of a text file, memory mapped where possible
+  class TextFile
+  {
+    const char* data;
+    SizeT size;
+    bool mapped;
+    string copy;
+
+  public:
+    TextFile(): data( NULL), size( 0), mapped( false) {}
+
+    ~TextFile()
+    {
+#if !defined(_WIN32) || defined(__CYGWIN__)
+      if( mapped)
+	munmap( const_cast<char*>( data), size);
+#endif
+    }
+
+    bool Open( const string& name)
+    {
+#if !defined(_WIN32) || defined(__CYGWIN__)
+      int fd = open( name.c_str(), O_RDONLY);
+      if( fd < 0)
+	return false;
+      struct stat st;
+      if( fstat( fd, &st) != 0 || S_ISDIR( st.st_mode))
+	{
+	  close( fd);
+	  return false;
+	}
+      if( S_ISREG( st.st_mode) && st.st_size > 0)
+	{
+	  void* addr = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	  if( addr != MAP_FAILED)
+	    {
+	      close( fd);
+	      data = static_cast<const char*>( addr);
+	      size = st.st_size;
+	      mapped = true;
+	      return true;
+	    }
+	}
+      close( fd);
+#endif
+      // empty or special file, or no mmap(): read it
+      ifstream ifs( name.c_str(), ios::binary);
+      if( !ifs)
+	return false;
+      copy.assign( istreambuf_iterator<char>( ifs), istreambuf_iterator<char>());
+      data = copy.data();
+      size = copy.size();
+      return true;
+    }
+
+    const char* Data() const { return data;}
+    SizeT Size() const { return size;}
+  };
+
+  // a line of text, [start, end) without its terminator
+  struct TextLine
+  {
+    SizeT start, end;
+    TextLine( SizeT s, SizeT e): start( s), end( e) {}
+  };
+
+  static void FindLines( const char* d, SizeT n, vector<TextLine>& lines)
+  {
+    lines.clear();
+    if( n == 0)
+      return;
+
+    SizeT start = 0;
+    if( memchr( d, '"', n) != NULL)
+      {
+	// quoted fields may contain line breaks: one sequential pass
+	bool quoted = false;
+	for( SizeT i = 0; i < n; ++i)
+	  {
+	    if( d[ i] == '"')
+	      quoted = !quoted;
+	    else if( d[ i] == '\n' && !quoted)
+	      {
+		lines.push_back( TextLine( start, i));
+		start = i + 1;
+	      }
+	  }
+      }
+    else
+      {
+	// the newlines of fixed chunks in parallel, then joined in order
+	SizeT nChunk = n / 65536 + 1;
+	if( nChunk > 1024) nChunk = 1024;
+	vector< vector<SizeT> > newline( nChunk);
+#pragma omp parallel for if (n >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= n))
+	for( OMPInt c = 0; c < nChunk; ++c)
+	  {
+	    const char* p = d + n * c / nChunk;
+	    const char* last = d + n * (c + 1) / nChunk;
+	    while( (p = static_cast<const char*>( memchr( p, '\n', last - p))) != NULL)
+	      {
+		newline[ c].push_back( p - d);
+		++p;
+	      }
+	  }
+	SizeT nLine = 1;
+	for( SizeT c = 0; c < nChunk; ++c) nLine += newline[ c].size();
+	lines.reserve( nLine);
+	for( SizeT c = 0; c < nChunk; ++c)
+	  for( SizeT i = 0; i < newline[ c].size(); ++i)
+	    {
+	      lines.push_back( TextLine( start, newline[ c][ i]));
+	      start = newline[ c][ i] + 1;
+	    }
+      }
+    if( start < n)
+      lines.push_back( TextLine( start, n));
+
+    // "\r\n" terminated lines
+    for( SizeT i = 0; i < lines.size(); ++i)
+      if( lines[ i].end > lines[ i].start && d[ lines[ i].end - 1] == '\r')
+	--lines[ i].end;
+  }
+
+  static inline bool IsBlank( const char* d, const TextLine& l)
+  {
+    for( SizeT i = l.start; i < l.end; ++i)
+      if( d[ i] != ' ' && d[ i] != '\t')
+	return false;
+    return true;
+  }
+
+  // a field of a CSV line; a quoted field is kept without its quotes (and
+  // with its "" pairs), an unquoted one without its surrounding blanks
+  struct Field
+  {
+    const char* p;
+    SizeT len;
+    bool quoted;
+  };
+
+  static void SplitFields( const char* s, const char* e, vector<Field>& fields)
+  {
+    fields.clear();
+    const char* p = s;
+    for(;;)
+      {
+	while( p < e && (*p == ' ' || *p == '\t')) ++p;
+	Field f;
+	if( p < e && *p == '"')
+	  {
+	    const char* q = ++p;
+	    while( q < e)
+	      {
+		if( *q == '"')
+		  {
+		    if( q + 1 < e && q[ 1] == '"')
+		      q += 2;
+		    else
+		      break;
+		  }
+		else
+		  ++q;
+	      }
+	    f.p = p;
+	    f.len = q - p;
+	    f.quoted = true;
+	    // anything between the closing quote and the separator is dropped
+	    p = (q < e) ? q + 1 : e;
+	    const char* sep = static_cast<const char*>( memchr( p, ',', e - p));
+	    p = (sep != NULL) ? sep : e;
+	  }
+	else
+	  {
+	    const char* sep = static_cast<const char*>( memchr( p, ',', e - p));
+	    const char* end = (sep != NULL) ? sep : e;
+	    f.p = p;
+	    p = end;
+	    while( end > f.p && (end[ -1] == ' ' || end[ -1] == '\t')) --end;
+	    f.len = end - f.p;
+	    f.quoted = false;
+	  }
+	fields.push_back( f);
+	if( p >= e)
+	  break;
+	++p; // the ','
+      }
+  }
+
+  static inline bool IsEmpty( const Field& f)
+  {
+    return f.len == 0 && !f.quoted;
+  }
+
+  static DString FieldString( const Field& f)
+  {
+    if( !f.quoted || memchr( f.p, '"', f.len) == NULL)
+      return DString( f.p, f.len);
+    DString s;
+    s.reserve( f.len);
+    for( SizeT i = 0; i < f.len; ++i)
+      {
+	s += f.p[ i];
+	if( f.p[ i] == '"') ++i; // "" -> "
+      }
+    return s;
+  }
+
+  // [+-]digits: 0 if f is not an integer, 1 if it fits a LONG, 2 if it
+  // fits a LONG64 and 3 if it is larger
+  static int ParseInt( const Field& f, DLong64& v)
+  {
+    if( f.quoted)
+      return 0;
+    const char* p = f.p;
+    const char* e = p + f.len;
+    bool neg = false;
+    if( p < e && (*p == '+' || *p == '-'))
+      neg = (*p++ == '-');
+    if( p == e)
+      return 0;
+    DULong64 u = 0;
+    bool overflow = false;
+    for( ; p < e; ++p)
+      {
+	unsigned digit = *p - '0';
+	if( digit > 9)
+	  return 0;
+	if( u > (18446744073709551615ULL - digit) / 10)
+	  overflow = true;
+	else
+	  u = u * 10 + digit;
+      }
+    if( overflow || u > (neg ? 9223372036854775808ULL : 9223372036854775807ULL))
+      return 3;
+    v = neg ? -static_cast<DLong64>( u - 1) - 1 : static_cast<DLong64>( u);
+    return (v >= -2147483648LL && v <= 2147483647LL) ? 1 : 2;
+  }
+
+  static bool ParseDouble( const Field& f, double& v)
+  {
+    if( f.quoted || f.len == 0)
+      return false;
+    // strtod() would also take hexadecimal numbers
+    if( memchr( f.p, 'x', f.len) != NULL || memchr( f.p, 'X', f.len) != NULL)
+      return false;
+    char buf[ 64];
+    string big;
+    const char* s = buf;
+    if( f.len < sizeof( buf))
+      {
+	memcpy( buf, f.p, f.len);
+	buf[ f.len] = 0;
+      }
+    else
+      {
+	big.assign( f.p, f.len);
+	s = big.c_str();
+      }
+    char* end;
+    v = StrToDFast( s, &end);
+    return end == s + f.len;
+  }
+
+  // the inferred column types, in increasing order of generality
+  enum CSVType { CSV_EMPTY = 0, CSV_LONG, CSV_LONG64, CSV_DOUBLE, CSV_STRING };
+
+  static int Classify( const Field& f)
+  {
+    if( f.quoted)
+      return CSV_STRING;
+    if( f.len == 0)
+      return CSV_EMPTY;
+    DLong64 v;
+    switch( ParseInt( f, v))
+      {
+      case 1: return CSV_LONG;
+      case 2: return CSV_LONG64;
+      case 3: return CSV_DOUBLE;
+      }
+    double d;
+    return ParseDouble( f, d) ? CSV_DOUBLE : CSV_STRING;
+  }
+
+  static DType TypeFromName( const string& name)
+  {
+    if( name == "BYTE") return GDL_BYTE;
+    if( name == "INT") return GDL_INT;
+    if( name == "UINT") return GDL_UINT;
+    if( name == "LONG") return GDL_LONG;
+    if( name == "ULONG") return GDL_ULONG;
+    if( name == "LONG64") return GDL_LONG64;
+    if( name == "ULONG64") return GDL_ULONG64;
+    if( name == "FLOAT") return GDL_FLOAT;
+    if( name == "DOUBLE") return GDL_DOUBLE;
+    if( name == "STRING") return GDL_STRING;
+    return GDL_UNDEF;
+  }
+
+  static BaseGDL* NewColumn( DType t, SizeT n)
+  {
+    dimension dim( n);
+    switch( t)
+      {
+      case GDL_BYTE: return new DByteGDL( dim, BaseGDL::NOZERO);
+      case GDL_INT: return new DIntGDL( dim, BaseGDL::NOZERO);
+      case GDL_UINT: return new DUIntGDL( dim, BaseGDL::NOZERO);
+      case GDL_LONG: return new DLongGDL( dim, BaseGDL::NOZERO);
+      case GDL_ULONG: return new DULongGDL( dim, BaseGDL::NOZERO);
+      case GDL_LONG64: return new DLong64GDL( dim, BaseGDL::NOZERO);
+      case GDL_ULONG64: return new DULong64GDL( dim, BaseGDL::NOZERO);
+      case GDL_FLOAT: return new DFloatGDL( dim, BaseGDL::NOZERO);
+      case GDL_DOUBLE: return new DDoubleGDL( dim, BaseGDL::NOZERO);
+      default: return new DStringGDL( dim);
+      }
+  }
+
+  template< class DataT>
+  static inline void SetInteger( BaseGDL* col, SizeT r, DLong64 v)
+  {
+    (*static_cast<DataT*>( col))[ r] = static_cast<typename DataT::Ty>( v);
+  }
+
+  // col[ r] from field f, missing if f is NULL, empty or not a number
+  static void Store( BaseGDL* col, SizeT r, const Field* f, double missing)
+  {
+    DType t = col->Type();
+    if( t == GDL_STRING)
+      {
+	if( f != NULL)
+	  (*static_cast<DStringGDL*>( col))[ r] = FieldString( *f);
+	return;
+      }
+
+    DLong64 i = 0;
+    double d = missing;
+    bool isInt = false;
+    if( f != NULL && !IsEmpty( *f))
+      {
+	int kind = ParseInt( *f, i);
+	if( kind == 1 || kind == 2)
+	  isInt = true;
+	else if( !ParseDouble( *f, d))
+	  d = missing;
+      }
+
+    if( t == GDL_DOUBLE)
+      {
+	(*static_cast<DDoubleGDL*>( col))[ r] = isInt ? static_cast<double>( i) : d;
+	return;
+      }
+    if( t == GDL_FLOAT)
+      {
+	(*static_cast<DFloatGDL*>( col))[ r] = isInt ? static_cast<float>( i) : static_cast<float>( d);
+	return;
+      }
+    if( !isInt)
+      i = (std::isfinite( d) && fabs( d) < 9.2e18) ? static_cast<DLong64>( d) : 0;
+    switch( t)
+      {
+      case GDL_BYTE: SetInteger<DByteGDL>( col, r, i); break;
+      case GDL_INT: SetInteger<DIntGDL>( col, r, i); break;
+      case GDL_UINT: SetInteger<DUIntGDL>( col, r, i); break;
+      case GDL_LONG: SetInteger<DLongGDL>( col, r, i); break;
+      case GDL_ULONG: SetInteger<DULongGDL>( col, r, i); break;
+      case GDL_LONG64: SetInteger<DLong64GDL>( col, r, i); break;
+      case GDL_ULONG64: SetInteger<DULong64GDL>( col, r, i); break;
+      default: break;
+      }
+  }
+
+  BaseGDL* read_csv_fun( EnvT* e)
+  {
+    e->NParam( 1);
+    DString name;
+    e->AssureScalarPar<DStringGDL>( 0, name);
+    WordExp( name);
+
+    static int countIx = e->KeywordIx( "COUNT");
+    static int headerIx = e->KeywordIx( "HEADER");
+    static int missingIx = e->KeywordIx( "MISSING_VALUE");
+    static int numRecordsIx = e->KeywordIx( "NUM_RECORDS");
+    static int recordStartIx = e->KeywordIx( "RECORD_START");
+    static int nTableHeaderIx = e->KeywordIx( "N_TABLE_HEADER");
+    static int tableHeaderIx = e->KeywordIx( "TABLE_HEADER");
+    static int typesIx = e->KeywordIx( "TYPES");
+
+    TextFile file;
+    if( !file.Open( name))
+      e->Throw( "Error opening file. File: " + name);
+    const char* d = file.Data();
+
+    vector<TextLine> lines;
+    FindLines( d, file.Size(), lines);
+
+    // the table header: the first N_TABLE_HEADER lines, as they are
+    DLong64 nTable = 0;
+    if( e->KeywordPresent( nTableHeaderIx))
+      e->AssureLongScalarKW( nTableHeaderIx, nTable);
+    if( nTable < 0) nTable = 0;
+    if( nTable > static_cast<DLong64>( lines.size())) nTable = lines.size();
+    if( e->KeywordPresent( tableHeaderIx))
+      {
+	if( nTable == 0)
+	  e->SetKW( tableHeaderIx, new DStringGDL( ""));
+	else
+	  {
+	    DStringGDL* table = new DStringGDL( dimension( nTable));
+	    for( SizeT i = 0; i < nTable; ++i)
+	      (*table)[ i].assign( d + lines[ i].start, lines[ i].end - lines[ i].start);
+	    e->SetKW( tableHeaderIx, table);
+	  }
+      }
+
+    vector<TextLine> rows;
+    rows.reserve( lines.size() - nTable);
+    for( SizeT i = nTable; i < lines.size(); ++i)
+      if( !IsBlank( d, lines[ i]))
+	rows.push_back( lines[ i]);
+    SizeT nRows = rows.size();
+
+    if( nRows == 0)
+      {
+	if( e->KeywordPresent( countIx))
+	  e->SetKW( countIx, new DLongGDL( 0));
+	if( e->KeywordPresent( headerIx))
+	  e->SetKW( headerIx, new DStringGDL( ""));
+	return new DLongGDL( 0);
+      }
+
+    // column types of all lines but the first, in parallel chunks
+    SizeT nChunk = (nRows - 1) / 1024 + 1;
+    if( nChunk > 256) nChunk = 256;
+    vector< vector<int> > chunkType( nChunk);
+#pragma omp parallel for if (nRows >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nRows))
+    for( OMPInt c = 0; c < nChunk; ++c)
+      {
+	vector<Field> fields;
+	vector<int>& type = chunkType[ c];
+	SizeT last = 1 + (nRows - 1) * (c + 1) / nChunk;
+	for( SizeT r = 1 + (nRows - 1) * c / nChunk; r < last; ++r)
+	  {
+	    SplitFields( d + rows[ r].start, d + rows[ r].end, fields);
+	    if( fields.size() > type.size())
+	      type.resize( fields.size(), CSV_EMPTY);
+	    for( SizeT k = 0; k < fields.size(); ++k)
+	      if( type[ k] != CSV_STRING)
+		{
+		  int t = Classify( fields[ k]);
+		  if( t > type[ k]) type[ k] = t;
+		}
+	  }
+      }
+    vector<int> colType;
+    for( SizeT c = 0; c < nChunk; ++c)
+      {
+	vector<int>& type = chunkType[ c];
+	if( type.size() > colType.size())
+	  colType.resize( type.size(), CSV_EMPTY);
+	for( SizeT k = 0; k < type.size(); ++k)
+	  if( type[ k] > colType[ k]) colType[ k] = type[ k];
+      }
+
+    // a first line with text over numeric columns is the header
+    vector<Field> first;
+    SplitFields( d + rows[ 0].start, d + rows[ 0].end, first);
+    bool hasHeader = false;
+    if( nRows > 1)
+      for( SizeT k = 0; k < first.size() && k < colType.size(); ++k)
+	if( Classify( first[ k]) == CSV_STRING &&
+	    colType[ k] != CSV_STRING && colType[ k] != CSV_EMPTY)
+	  hasHeader = true;
+    if( first.size() > colType.size())
+      colType.resize( first.size(), CSV_EMPTY);
+    if( !hasHeader)
+      for( SizeT k = 0; k < first.size(); ++k)
+	{
+	  int t = Classify( first[ k]);
+	  if( t > colType[ k]) colType[ k] = t;
+	}
+    SizeT nCol = colType.size();
+
+    if( e->KeywordPresent( headerIx))
+      {
+	if( !hasHeader)
+	  e->SetKW( headerIx, new DStringGDL( ""));
+	else
+	  {
+	    DStringGDL* header = new DStringGDL( dimension( first.size()));
+	    for( SizeT k = 0; k < first.size(); ++k)
+	      (*header)[ k] = FieldString( first[ k]);
+	    e->SetKW( headerIx, header);
+	  }
+      }
+
+    // the requested records
+    DLong64 recordStart = 0;
+    if( e->KeywordPresent( recordStartIx))
+      e->AssureLongScalarKW( recordStartIx, recordStart);
+    if( recordStart < 0) recordStart = 0;
+    SizeT begin = (hasHeader ? 1 : 0) + recordStart;
+    if( begin > nRows) begin = nRows;
+    SizeT nRec = nRows - begin;
+    if( e->KeywordPresent( numRecordsIx))
+      {
+	DLong64 numRecords = 0;
+	e->AssureLongScalarKW( numRecordsIx, numRecords);
+	if( numRecords > 0 && static_cast<SizeT>( numRecords) < nRec)
+	  nRec = numRecords;
+      }
+    if( e->KeywordPresent( countIx))
+      e->SetKW( countIx, new DLongGDL( nRec));
+
+    vector<DType> type( nCol);
+    for( SizeT k = 0; k < nCol; ++k)
+      switch( colType[ k])
+	{
+	case CSV_LONG: type[ k] = GDL_LONG; break;
+	case CSV_LONG64: type[ k] = GDL_LONG64; break;
+	case CSV_DOUBLE: type[ k] = GDL_DOUBLE; break;
+	default: type[ k] = GDL_STRING; break;
+	}
+    if( e->KeywordPresent( typesIx))
+      {
+	DStringGDL* types = e->GetKWAs<DStringGDL>( typesIx);
+	for( SizeT k = 0; k < nCol && k < types->N_Elements(); ++k)
+	  {
+	    DString typeName = StrUpCase( (*types)[ k]);
+	    StrTrim( typeName);
+	    if( typeName.empty())
+	      continue;
+	    type[ k] = TypeFromName( typeName);
+	    if( type[ k] == GDL_UNDEF)
+	      e->Throw( "Invalid type name: " + (*types)[ k]);
+	  }
+      }
+
+    double missing = 0.;
+    if( e->KeywordPresent( missingIx))
+      missing = (*e->GetKWAs<DDoubleGDL>( missingIx))[ 0];
+
+    // zero records still give one element per column
+    vector<BaseGDL*> column( nCol);
+    for( SizeT k = 0; k < nCol; ++k)
+      column[ k] = NewColumn( type[ k], nRec > 0 ? nRec : 1);
+    if( nRec == 0)
+      for( SizeT k = 0; k < nCol; ++k)
+	Store( column[ k], 0, NULL, missing);
+
+    SizeT nEl = nRec * nCol;
+#pragma omp parallel if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+    {
+      vector<Field> fields;
+#pragma omp for
+      for( OMPInt r = 0; r < nRec; ++r)
+	{
+	  const TextLine& l = rows[ begin + r];
+	  SplitFields( d + l.start, d + l.end, fields);
+	  for( SizeT k = 0; k < nCol; ++k)
+	    Store( column[ k], r, (k < fields.size()) ? &fields[ k] : NULL, missing);
+	}
+    }
+
+    DStructGDL* res = new DStructGDL( new DStructDesc( "$truct"));
+    SizeT nDigits = i2s( nCol).size();
+    for( SizeT k = 0; k < nCol; ++k)
+      {
+	string n = i2s( k + 1);
+	res->NewTag( "FIELD" + string( nDigits - n.size(), '0') + n, column[ k]);
+      }
+    return res;
+  }
+
+  static inline bool EqualNoCase( const char* s, SizeT n, const char* word)
+  {
+    SizeT i = 0;
+    for( ; i < n && word[ i] != 0; ++i)
+      if( tolower( s[ i]) != word[ i])
+	return false;
+    return i == n && word[ i] == 0;
+  }
+
+  // [0-9]*\.?[0-9]*[ed]?[+-]?[0-9]+\.?[0-9]*, from item on
+  static bool MatchNumber( const char* p, const char* e, int item)
+  {
+    static const char* const set[ 8] =
+      { "0123456789", ".", "0123456789", "eEdD", "+-", "0123456789", ".", "0123456789"};
+    static const int minRep[ 8] = { 0, 0, 0, 0, 0, 1, 0, 0};
+    static const int maxRep[ 8] = { -1, 1, -1, 1, 1, -1, 1, -1};
+    if( item == 8)
+      return p == e;
+    // greedy, then backtracking
+    const char* q = p;
+    while( q < e && *q != 0 && (maxRep[ item] < 0 || q - p < maxRep[ item]) &&
+	   strchr( set[ item], *q) != NULL)
+      ++q;
+    for(;;)
+      {
+	if( q - p >= minRep[ item] && MatchNumber( q, e, item + 1))
+	  return true;
+	if( q == p)
+	  return false;
+	--q;
+      }
+  }
+
+  // READ_ASCII's numbers:
+  // ^[+-]?([0-9]*\.?[0-9]*[ed]?[+-]?[0-9]+\.?[0-9]*|NaN|Inf|Infinity)$
+  static bool AsciiNumber( const char* s, SizeT n)
+  {
+    if( n > 0 && (*s == '+' || *s == '-'))
+      {
+	++s;
+	--n;
+      }
+    if( EqualNoCase( s, n, "nan") || EqualNoCase( s, n, "inf") ||
+	EqualNoCase( s, n, "infinity"))
+      return true;
+    for( SizeT i = 0; i < n; ++i)
+      if( strchr( "0123456789.eEdD+-", s[ i]) == NULL || s[ i] == 0)
+	return false;
+    return MatchNumber( s, s + n, 0);
+  }
+
+  // READ_ASCII_INTERNALGDL( text, delimiter, missing): the lines text split
+  // at any of the characters of delimiter into FLTARR( ncolumn, nline),
+  // missing where a field is absent or not a number
+  BaseGDL* read_ascii_internal_fun( EnvT* e)
+  {
+    e->NParam( 3);
+    DStringGDL* text = e->GetParAs<DStringGDL>( 0);
+    DString delimiter = (*e->GetParAs<DStringGDL>( 1))[ 0];
+    if( delimiter.empty())
+      delimiter = " ";
+    DFloat missing = (*e->GetParAs<DFloatGDL>( 2))[ 0];
+
+    SizeT nLine = text->N_Elements();
+    vector<SizeT> nField( nLine, 0);
+#pragma omp parallel for if (nLine >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nLine))
+    for( OMPInt l = 0; l < nLine; ++l)
+      {
+	const DString& s = (*text)[ l];
+	SizeT p = s.find_first_not_of( delimiter);
+	while( p != string::npos)
+	  {
+	    ++nField[ l];
+	    p = s.find_first_of( delimiter, p);
+	    if( p != string::npos)
+	      p = s.find_first_not_of( delimiter, p);
+	  }
+      }
+    SizeT nCol = 1;
+    for( SizeT l = 0; l < nLine; ++l)
+      if( nField[ l] > nCol) nCol = nField[ l];
+
+    // as FLTARR(nCol, nLine): a single line gives a vector
+    dimension resDim( nCol, nLine);
+    resDim.Purge();
+    DFloatGDL* res = new DFloatGDL( resDim, BaseGDL::NOZERO);
+#pragma omp parallel for if (nLine >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nLine))
+    for( OMPInt l = 0; l < nLine; ++l)
+      {
+	const DString& s = (*text)[ l];
+	DFloat* row = &(*res)[ l * nCol];
+	for( SizeT k = 0; k < nCol; ++k) row[ k] = missing;
+	SizeT k = 0;
+	SizeT p = s.find_first_not_of( delimiter);
+	while( p != string::npos)
+	  {
+	    SizeT end = s.find_first_of( delimiter, p);
+	    SizeT len = ((end == string::npos) ? s.size() : end) - p;
+	    if( AsciiNumber( s.c_str() + p, len))
+	      {
+		// the field alone, s may continue with digits after a delimiter
+		char buf[ 64];
+		string big;
+		const char* field = buf;
+		if( len < sizeof( buf))
+		  {
+		    memcpy( buf, s.c_str() + p, len);
+		    buf[ len] = 0;
+		  }
+		else
+		  {
+		    big.assign( s, p, len);
+		    field = big.c_str();
+		  }
+		char* cEnd;
+		row[ k] = StrToD( field, &cEnd);
+	      }
+	    ++k;
+	    p = (end == string::npos) ? end : s.find_first_not_of( delimiter, end);
+	  }
+      }
+    return res;
+  }
+
+} // namespace
@@ -0,0 +1,29 @@
+/***************************************************************************
+                 read_csv.hpp  -  READ_CSV() and the READ_ASCII() parser
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef READ_CSV_HPP_
+#define READ_CSV_HPP_
+
+#include "datatypes.hpp"
+#include "envt.hpp"
+
+namespace lib {
+
+  BaseGDL* read_csv_fun( EnvT* e);
+  BaseGDL* read_ascii_internal_fun( EnvT* e);
+
+} // namespace
+
+#endif
@@ -125,23 +125,86 @@ namespace lib {
     return xdr_getpos(xdrs); //end of header
   }
 
+  // one zlib stream for in[0..n), as compress2() gives, but deflated in
+  // independent blocks on several threads: each block is a raw deflate
+  // ending on a full flush (the last one finishes the stream), the
+  // checksums are combined with adler32_combine(). Any zlib reader,
+  // IDL's included, inflates it as a whole.
+  void parallelCompress(const char* in, uLong n, std::vector<char>& out) {
+    const uLong blockSize = 1 << 20;
+    if (n < 2 * blockSize)
+    {
+      uLong cLength = compressBound(n);
+      out.resize(cLength);
+      compress2((Bytef *) &out[0], &cLength, (const Bytef *) in, n, Z_BEST_SPEED);
+      out.resize(cLength);
+      return;
+    }
+
+    SizeT nBlocks = (n + blockSize - 1) / blockSize;
+    std::vector<std::vector<char> > block(nBlocks);
+    std::vector<uLong> adler(nBlocks);
+    bool failed = false;
+#pragma omp parallel for if (n >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= n))
+    for (OMPInt b = 0; b < nBlocks; ++b)
+    {
+      const char* start = in + b * blockSize;
+      uLong len = (b == nBlocks - 1) ? n - b * blockSize : blockSize;
+      adler[b] = adler32(adler32(0L, Z_NULL, 0), (const Bytef *) start, len);
+      z_stream strm;
+      strm.zalloc = Z_NULL;
+      strm.zfree = Z_NULL;
+      strm.opaque = Z_NULL;
+      if (deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        failed = true;
+        continue;
+      }
+      // room for the flush marker too
+      std::vector<char>& o = block[b];
+      o.resize(deflateBound(&strm, len) + 16);
+      strm.next_in = (Bytef *) start;
+      strm.avail_in = len;
+      strm.next_out = (Bytef *) &o[0];
+      strm.avail_out = o.size();
+      int ret = deflate(&strm, (b == nBlocks - 1) ? Z_FINISH : Z_FULL_FLUSH);
+      if (strm.avail_in != 0 || strm.avail_out == 0 || (ret != Z_OK && ret != Z_STREAM_END)) failed = true;
+      o.resize(o.size() - strm.avail_out);
+      deflateEnd(&strm);
+    }
+    if (failed) throw GDLException("fatal error when compressing data.");
+
+    uLong check = adler[0];
+    SizeT total = 6 + block[0].size();
+    for (SizeT b = 1; b < nBlocks; ++b)
+    {
+      check = adler32_combine(check, adler[b], (b == nBlocks - 1) ? n - b * blockSize : blockSize);
+      total += block[b].size();
+    }
+    out.clear();
+    out.reserve(total);
+    out.push_back(0x78); //zlib header, fastest level
+    out.push_back(0x01);
+    for (SizeT b = 0; b < nBlocks; ++b) out.insert(out.end(), block[b].begin(), block[b].end());
+    for (int i = 3; i >= 0; --i) out.push_back((check >> (8 * i)) & 0xff);
+  }
+
   inline uint32_t updateNewRecordHeader(XDR *xdrs, uint32_t cur) {
     uint32_t next = xdr_getpos(xdrs);
     //dirty trick for compression: write uncompressed, rewind, read what was just written, compress, write over, reset positions.
     if (save_compress)
     {
       uint32_t uLength = next - cur;
-      uLong cLength = compressBound(uLength);
-      char* uncompressed = (char*) calloc(uLength+1,1);
+      std::vector<char> uncompressed(uLength + 1);
       xdr_setpos(xdrs, cur);
-      size_t retval = fread(uncompressed, 1, uLength, save_fid);
+      size_t retval = fread(&uncompressed[0], 1, uLength, save_fid);
       if (retval!=uLength) cerr<<"(compress) read error:"<<retval<<"eof:"<<feof(save_fid)<<", error:"<<ferror(save_fid)<<endl;
-      char* compressed = (char*) calloc(cLength + 1,1);
       // Deflate
-      compress2((Bytef *) compressed, &cLength, (Bytef *) uncompressed, uLength, Z_BEST_SPEED);
-      //cLength is the good length now.
+      std::vector<char> compressed;
+      parallelCompress(&uncompressed[0], uLength, compressed);
+      uLong cLength = compressed.size();
       xdr_setpos(xdrs, cur);
-      xdr_opaque(xdrs,compressed,cLength);
+      xdr_opaque(xdrs,&compressed[0],cLength);
       next = cur+cLength;
       xdr_setpos(xdrs, next);
       //if (next!=(cur+cLength)) cerr<<"problem:"<<cur+cLength<<":"<<next<<"\n";
@@ -945,6 +1008,107 @@ namespace lib {
     return var;
   }
 
+  // Bulk XDR coding of numeric arrays. XDR stores every item as one or two
+  // big-endian 32-bit words (INT and UINT widened to a word, as
+  // xdr_int16_t() does), so an array is the same bytes as a byte-swapped
+  // copy of it: swapping a chunk into a staging buffer and passing it to
+  // xdr_opaque() gives exactly what xdr_vector() writes, without a
+  // function call per element. On reading, items that are a word wide are
+  // read in place and swapped there. Small arrays (typically structure
+  // tags) keep xdr_vector().
+  static const SizeT xdrBulkMinElts = 256;
+  static const SizeT xdrBulkChunk = 1 << 20; // items per xdr_opaque() call
+
+  static inline uint32_t xdrSwap(uint32_t u) {
+#if defined(__GNUC__)
+    return __builtin_bswap32(u);
+#else
+    return (u >> 24) | ((u >> 8) & 0xff00) | ((u << 8) & 0xff0000) | (u << 24);
+#endif
+  }
+
+  static inline uint64_t xdrSwap(uint64_t u) {
+#if defined(__GNUC__)
+    return __builtin_bswap64(u);
+#else
+    return (static_cast<uint64_t> (xdrSwap(static_cast<uint32_t> (u))) << 32) | xdrSwap(static_cast<uint32_t> (u >> 32));
+#endif
+  }
+
+  // value <-> XDR word(s), in host order
+  static inline uint32_t xdrWord(DInt v) { return static_cast<uint32_t> (static_cast<int32_t> (v)); }
+  static inline uint32_t xdrWord(DUInt v) { return v; }
+  static inline uint32_t xdrWord(DLong v) { return static_cast<uint32_t> (v); }
+  static inline uint32_t xdrWord(DULong v) { return v; }
+  static inline uint32_t xdrWord(DFloat v) { uint32_t u; memcpy(&u, &v, 4); return u; }
+  static inline uint64_t xdrWord(DLong64 v) { return static_cast<uint64_t> (v); }
+  static inline uint64_t xdrWord(DULong64 v) { return v; }
+  static inline uint64_t xdrWord(DDouble v) { uint64_t u; memcpy(&u, &v, 8); return u; }
+
+  static inline void xdrValue(uint32_t u, DInt& v) { v = static_cast<DInt> (static_cast<int32_t> (u)); }
+  static inline void xdrValue(uint32_t u, DUInt& v) { v = static_cast<DUInt> (u); }
+
+  template<typename U, typename T>
+  static void xdrEncodeChunk(const T* in, U* out, OMPInt n, bool swap) {
+    if (swap)
+    {
+#pragma omp parallel for if (n >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= n))
+      for (OMPInt i = 0; i < n; ++i) out[i] = xdrSwap(xdrWord(in[i]));
+    } else
+    {
+      for (OMPInt i = 0; i < n; ++i) out[i] = xdrWord(in[i]);
+    }
+  }
+
+  // writes n items of type T as XDR words U
+  template<typename U, typename T>
+  static bool xdrPutArray(XDR* xdrs, const T* data, SizeT n) {
+    bool swap = !BigEndian();
+    std::vector<U> stage((n < xdrBulkChunk) ? n : xdrBulkChunk);
+    for (SizeT i0 = 0; i0 < n; i0 += stage.size())
+    {
+      SizeT cnt = (n - i0 < stage.size()) ? n - i0 : stage.size();
+      xdrEncodeChunk(data + i0, &stage[0], cnt, swap);
+      if (!xdr_opaque(xdrs, reinterpret_cast<char*> (&stage[0]), cnt * sizeof (U))) return false;
+    }
+    return true;
+  }
+
+  // reads n word-wide items (U is uint32_t or uint64_t, sizeof(T) == sizeof(U)) in place
+  template<typename U>
+  static bool xdrGetArrayInPlace(XDR* xdrs, void* data, SizeT n) {
+    bool swap = !BigEndian();
+    U* p = static_cast<U*> (data);
+    for (SizeT i0 = 0; i0 < n; i0 += xdrBulkChunk)
+    {
+      OMPInt cnt = (n - i0 < xdrBulkChunk) ? n - i0 : xdrBulkChunk;
+      if (!xdr_opaque(xdrs, reinterpret_cast<char*> (p + i0), cnt * sizeof (U))) return false;
+      if (swap)
+      {
+        U* q = p + i0;
+#pragma omp parallel for if (cnt >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= cnt))
+        for (OMPInt i = 0; i < cnt; ++i) q[i] = xdrSwap(q[i]);
+      }
+    }
+    return true;
+  }
+
+  // reads n INT or UINT items, one word each
+  template<typename T>
+  static bool xdrGetShortArray(XDR* xdrs, T* data, SizeT n) {
+    bool swap = !BigEndian();
+    std::vector<uint32_t> stage((n < xdrBulkChunk) ? n : xdrBulkChunk);
+    for (SizeT i0 = 0; i0 < n; i0 += stage.size())
+    {
+      OMPInt cnt = (n - i0 < stage.size()) ? n - i0 : stage.size();
+      if (!xdr_opaque(xdrs, reinterpret_cast<char*> (&stage[0]), cnt * sizeof (uint32_t))) return false;
+      T* q = data + i0;
+#pragma omp parallel for if (cnt >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= cnt))
+      for (OMPInt i = 0; i < cnt; ++i) xdrValue(swap ? xdrSwap(stage[i]) : stage[i], q[i]);
+    }
+    return true;
+  }
+
   void fillVariableData(XDR* xdrs, BaseGDL* var) {
     u_int nEl = var->N_Elements();
     switch (var->Type()) {
@@ -957,54 +1121,54 @@ namespace lib {
         break;
       case GDL_INT:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DInt), (xdrproc_t) xdr_int16_t)) cerr << "error GDL_INT" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetShortArray(xdrs, static_cast<DInt*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DInt), (xdrproc_t) xdr_int16_t))) cerr << "error GDL_INT" << endl;
       }
         break;
       case GDL_UINT:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DUInt), (xdrproc_t) xdr_uint16_t)) cerr << "error GDL_UINT" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetShortArray(xdrs, static_cast<DUInt*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DUInt), (xdrproc_t) xdr_uint16_t))) cerr << "error GDL_UINT" << endl;
       }
         break;
       case GDL_LONG:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (int32_t), (xdrproc_t) xdr_int32_t)) cerr << "error GDL_LONG" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint32_t>(xdrs, var->DataAddr(), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (int32_t), (xdrproc_t) xdr_int32_t))) cerr << "error GDL_LONG" << endl;
       }
         break;
       case GDL_ULONG:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong), (xdrproc_t) xdr_uint32_t)) cerr << "error GDL_ULONG" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint32_t>(xdrs, var->DataAddr(), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong), (xdrproc_t) xdr_uint32_t))) cerr << "error GDL_ULONG" << endl;
       }
         break;
       case GDL_LONG64:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DLong64), (xdrproc_t) xdr_int64_t)) cerr << "error GDL_LONG64" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint64_t>(xdrs, var->DataAddr(), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DLong64), (xdrproc_t) xdr_int64_t))) cerr << "error GDL_LONG64" << endl;
       }
         break;
       case GDL_ULONG64:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong64), (xdrproc_t) xdr_uint64_t)) cerr << "error GDL_ULONG64" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint64_t>(xdrs, var->DataAddr(), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong64), (xdrproc_t) xdr_uint64_t))) cerr << "error GDL_ULONG64" << endl;
       }
         break;
       case GDL_FLOAT:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DFloat), (xdrproc_t) xdr_float)) cerr << "error GDL_FLOAT" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint32_t>(xdrs, var->DataAddr(), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DFloat), (xdrproc_t) xdr_float))) cerr << "error GDL_FLOAT" << endl;
       }
         break;
       case GDL_DOUBLE:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DDouble), (xdrproc_t) xdr_double)) cerr << "error GDL_DOUBLE" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint64_t>(xdrs, var->DataAddr(), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DDouble), (xdrproc_t) xdr_double))) cerr << "error GDL_DOUBLE" << endl;
       }
         break;
       case GDL_COMPLEX:
       {
         u_int nEl2 = nEl * 2;
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DFloat), (xdrproc_t) xdr_float)) cerr << "error GDL_COMPLEX" << endl;
+        if (!((nEl2 >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint32_t>(xdrs, var->DataAddr(), nEl2) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DFloat), (xdrproc_t) xdr_float))) cerr << "error GDL_COMPLEX" << endl;
       }
         break;
       case GDL_COMPLEXDBL:
       {
         u_int nEl2 = nEl * 2;
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DDouble), (xdrproc_t) xdr_double)) cerr << "error GDL_COMPLEXDBL" << endl;
+        if (!((nEl2 >= xdrBulkMinElts) ? xdrGetArrayInPlace<uint64_t>(xdrs, var->DataAddr(), nEl2) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DDouble), (xdrproc_t) xdr_double))) cerr << "error GDL_COMPLEXDBL" << endl;
       }
         break;
       case GDL_STRING:
@@ -1069,54 +1233,54 @@ namespace lib {
         break;
       case GDL_INT:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DInt), (xdrproc_t) xdr_int16_t)) cerr << "error GDL_INT" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint32_t>(xdrs, static_cast<const DInt*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DInt), (xdrproc_t) xdr_int16_t))) cerr << "error GDL_INT" << endl;
       }
         break;
       case GDL_UINT:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DUInt), (xdrproc_t) xdr_uint16_t)) cerr << "error GDL_UINT" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint32_t>(xdrs, static_cast<const DUInt*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DUInt), (xdrproc_t) xdr_uint16_t))) cerr << "error GDL_UINT" << endl;
       }
         break;
       case GDL_LONG:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (int32_t), (xdrproc_t) xdr_int32_t)) cerr << "error GDL_LONG" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint32_t>(xdrs, static_cast<const DLong*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (int32_t), (xdrproc_t) xdr_int32_t))) cerr << "error GDL_LONG" << endl;
       }
         break;
       case GDL_ULONG:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong), (xdrproc_t) xdr_uint32_t)) cerr << "error GDL_ULONG" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint32_t>(xdrs, static_cast<const DULong*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong), (xdrproc_t) xdr_uint32_t))) cerr << "error GDL_ULONG" << endl;
       }
         break;
       case GDL_LONG64:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DLong64), (xdrproc_t) xdr_int64_t)) cerr << "error GDL_LONG64" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint64_t>(xdrs, static_cast<const DLong64*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DLong64), (xdrproc_t) xdr_int64_t))) cerr << "error GDL_LONG64" << endl;
       }
         break;
       case GDL_ULONG64:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong64), (xdrproc_t) xdr_uint64_t)) cerr << "error GDL_ULONG64" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint64_t>(xdrs, static_cast<const DULong64*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DULong64), (xdrproc_t) xdr_uint64_t))) cerr << "error GDL_ULONG64" << endl;
       }
         break;
       case GDL_FLOAT:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DFloat), (xdrproc_t) xdr_float)) cerr << "error GDL_FLOAT" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint32_t>(xdrs, static_cast<const DFloat*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DFloat), (xdrproc_t) xdr_float))) cerr << "error GDL_FLOAT" << endl;
       }
         break;
       case GDL_DOUBLE:
       {
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DDouble), (xdrproc_t) xdr_double)) cerr << "error GDL_DOUBLE" << endl;
+        if (!((nEl >= xdrBulkMinElts) ? xdrPutArray<uint64_t>(xdrs, static_cast<const DDouble*> (var->DataAddr()), nEl) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl, sizeof (DDouble), (xdrproc_t) xdr_double))) cerr << "error GDL_DOUBLE" << endl;
       }
         break;
       case GDL_COMPLEX:
       {
         u_int nEl2 = nEl * 2;
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DFloat), (xdrproc_t) xdr_float)) cerr << "error GDL_COMPLEX" << endl;
+        if (!((nEl2 >= xdrBulkMinElts) ? xdrPutArray<uint32_t>(xdrs, static_cast<const DFloat*> (var->DataAddr()), nEl2) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DFloat), (xdrproc_t) xdr_float))) cerr << "error GDL_COMPLEX" << endl;
       }
         break;
       case GDL_COMPLEXDBL:
       {
         u_int nEl2 = nEl * 2;
-        if (!xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DDouble), (xdrproc_t) xdr_double)) cerr << "error GDL_COMPLEXDBL" << endl;
+        if (!((nEl2 >= xdrBulkMinElts) ? xdrPutArray<uint64_t>(xdrs, static_cast<const DDouble*> (var->DataAddr()), nEl2) : xdr_vector(xdrs, (char*) var->DataAddr(), nEl2, sizeof (DDouble), (xdrproc_t) xdr_double))) cerr << "error GDL_COMPLEXDBL" << endl;
       }
         break;
       case GDL_STRING:
@@ -1370,29 +1534,60 @@ namespace lib {
     }
   }
 
-  //clever but very VERY VERY dirty trick not gentle with memory and full of leaks:
+  // inflates the zlib stream of a compressed record body (compsz bytes
+  // from the current position of fid), reading it by blocks so that only
+  // the expanded record is held in memory. With maxOut > 0, stops as soon
+  // as maxOut bytes are expanded (enough to peek at a variable name).
+  void inflateRecord(FILE* fid, DULong64 compsz, std::vector<char>& out, SizeT maxOut = 0) {
+    const SizeT inBlock = 1 << 20;
+    std::vector<char> in((compsz < inBlock) ? compsz + 1 : inBlock);
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = Z_NULL;
+    strm.avail_in = 0;
+    if (inflateInit(&strm) != Z_OK) throw GDLException("fatal error when uncompressing data.");
+
+    // a first guess, doubled whenever needed
+    SizeT outSize = 4 * compsz;
+    if (outSize < 4096) outSize = 4096;
+    if (outSize > (SizeT(1) << 26)) outSize = SizeT(1) << 26;
+    if (maxOut > 0 && outSize > maxOut) outSize = maxOut;
+    out.resize(outSize);
+    SizeT have = 0;
+    int ret = Z_OK;
+    while (ret != Z_STREAM_END) {
+      if (strm.avail_in == 0 && compsz > 0) {
+        SizeT n = (compsz < in.size()) ? compsz : in.size();
+        if (fread(&in[0], 1, n, fid) != n) break;
+        compsz -= n;
+        strm.next_in = (Bytef *) &in[0];
+        strm.avail_in = n;
+      }
+      if (have == out.size()) {
+        if (maxOut > 0) break;
+        out.resize(2 * out.size());
+      }
+      strm.next_out = (Bytef *) &out[have];
+      strm.avail_out = out.size() - have;
+      ret = inflate(&strm, Z_NO_FLUSH);
+      have = out.size() - strm.avail_out;
+      if (ret == Z_BUF_ERROR && strm.avail_in == 0 && compsz == 0) break; //truncated record
+      if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+        inflateEnd(&strm);
+        throw GDLException("fatal error when uncompressing data.");
+      }
+    }
+    inflateEnd(&strm);
+    out.resize(have);
+  }
 
-  XDR* uncompress_trick(FILE* fid, XDR* xdrsmem, char* &expanded, DULong64 nextptr, DULong64 currentptr) {
-    if (expanded!=NULL) free(expanded);
-    uLong compsz = nextptr - currentptr;
-    char* expandable = (char*) malloc(compsz);
-    size_t retval = fread(expandable, 1, compsz, fid);
-    int iloop = 1;
-    uLong uncompsz;
-    //of course one should never do like that. One should do as in gzstream.hpp...
-    while (1)
-    {
-      uncompsz = 10 * iloop*compsz; //a default starting value...
-      expanded = (char*) malloc(uncompsz);
-      int retval = uncompress((Bytef *) expanded, &uncompsz, (Bytef *) expandable, compsz);
-      if (retval == Z_OK) break; //ok length was sufficient
-      free(expanded);
-      if (retval != Z_BUF_ERROR) throw GDLException("fatal error when uncompressing data.");
-      iloop++;
-    }
-    free(expandable);
-    xdrmem_create(xdrsmem, NULL, 0, XDR_FREE);
-    xdrmem_create(xdrsmem, expanded, uncompsz, XDR_DECODE);
+  // the body of a compressed record, [currentptr, nextptr), expanded in
+  // memory and decoded from there
+  XDR* uncompressRecord(FILE* fid, XDR* xdrsmem, std::vector<char>& expanded, DULong64 nextptr, DULong64 currentptr, SizeT maxOut = 0) {
+    inflateRecord(fid, nextptr - currentptr, expanded, maxOut);
+    xdrmem_create(xdrsmem, expanded.empty() ? NULL : &expanded[0], expanded.size(), XDR_DECODE);
     return xdrsmem;
   }
   
@@ -1439,8 +1634,19 @@ namespace lib {
     if (verboselevel>1) debug=true;
     bool hasDescription = e->KeywordPresent(DESCRIPTION);
 
+    //restore only these variables, the other records are skipped without being read
+    static int VARIABLES = e->KeywordIx("VARIABLES");
+    std::set<std::string> wantedVars, foundVars;
+    if (e->KeywordPresent(VARIABLES))
+    {
+      DStringGDL* vars = e->GetKWAs<DStringGDL>(VARIABLES);
+      for (SizeT i = 0; i < vars->N_Elements(); ++i) wantedVars.insert(StrUpCase((*vars)[i]));
+    }
+
     //empty heap map by security.
     heapIndexMapRestore.clear();
+    //heap indexes defining objects (object and pointer ids may coincide)
+    std::set<long> objHeapIndex;
 
     std::vector<Guard<BaseGDL>* > guardVector;
     //    std::vector<BaseGDL*> myObj;
@@ -1472,7 +1678,7 @@ namespace lib {
     XDR* xdrsfile = new XDR;
     xdrstdio_create(xdrsfile, fid, XDR_DECODE);
     xdrs = xdrsfile;
-    char* expanded = NULL;
+    std::vector<char> expanded;
 
     SizeT returned;
     char signature[4];
@@ -1532,7 +1738,7 @@ namespace lib {
         if (ptrs1 > 0)
         {
           DULong64 tmp = ptrs1;
-          nextptr &= (tmp << 32);
+          nextptr |= (tmp << 32);
         }
       }
 
@@ -1551,7 +1757,7 @@ namespace lib {
             //            Message("sorry, can''t deal with this yet.  if possible, save without the \"COMPRESS\" flag.");
             isCompress = true;
           }
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
           getTimeUserHost(xdrs);
           if (verbose)
           {
@@ -1561,7 +1767,7 @@ namespace lib {
           }
           break;
         case 14:
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
           if (!getVersion(xdrs))
           {
             cerr << "error in VERSION" << endl;
@@ -1574,7 +1780,7 @@ namespace lib {
         case 13: //IDENTIFICATION
           if (verbose)
           {
-            if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+            if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
             if (!getIdentification(xdrs))
             {
               cerr << "error in AUTHOR" << endl;
@@ -1583,7 +1789,7 @@ namespace lib {
           }
           break;
         case 19: //NOTICE
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
           if (!getNotice(xdrs))
           {
             cerr << "error in NOTICE" << endl;
@@ -1593,14 +1799,14 @@ namespace lib {
         case 20: //description
           if (verbose || hasDescription)
           {
-            if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+            if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
             std::string descr(getDescription(xdrs));
             if (verbose) Message("Description: " + descr);
             if (hasDescription) e->SetKW(DESCRIPTION, new DStringGDL(descr));
           }
           break;
         case 1: //COMMONBLOCK
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
           if (!defineCommonBlock(e, xdrs, verboselevel))
           {
             cerr << "error in COMMONBLOCK" << endl;
@@ -1608,7 +1814,7 @@ namespace lib {
           }
           break;
         case 15: //HEAP_HEADER. IS IN PREAMBLE since version 5. BEFORE ANY REFERENCE TO HEAP.
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
         {
           int32_t elementcount;
           if (!xdr_int32_t(xdrs, &elementcount)) break;
@@ -1624,7 +1830,7 @@ namespace lib {
           break;
         }
         case 16: //define all HEAP_DATA variable but do not fill them yet
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
         {
           int32_t heap_index = 0;
           if (!xdr_int32_t(xdrs, &heap_index)) break;
@@ -1657,6 +1863,7 @@ namespace lib {
           if (isObjStruct) ptr = e->NewObjHeap(1, static_cast<DStructGDL*>(ret));
           else ptr = e->NewHeap(1, ret);
           heapIndexMapRestore.insert(std::pair<long, std::pair<BaseGDL*,DPtr>>(heap_index, std::make_pair(ret,ptr)));
+          if (isObjStruct) objHeapIndex.insert(heap_index);
           //we skip filling the gdl variable, as we wait until all heap variables in heapIndexMapRestore are copmletely defined.
           //This has proven to be way safer as the order of variables in the save file is strange.
         }
@@ -1682,9 +1889,18 @@ namespace lib {
     currentptr = 0;
     nextptr = LONG;
     SomethingFussyHappened = true;
+    //heap variables defined above whose HEAP_DATA has not been read yet
+    SizeT heapToFill = heapIndexMapRestore.size();
 
     while (1)
     {
+      //lazy restore: stop once the requested variables are read, unless heap data remains to be filled
+      //(a requested pointer may refer to any of them, this is only known once all are filled)
+      if (!wantedVars.empty() && foundVars.size() == wantedVars.size() && heapToFill == 0)
+      {
+        SomethingFussyHappened = false;
+        break;
+      }
 
       xdrs = xdrsfile; //back to file if we were smarting the xdr to read a char* due to compression.
       if (fseek(fid, nextptr, SEEK_SET)) break;
@@ -1713,7 +1929,7 @@ namespace lib {
         if (ptrs1 > 0)
         {
           DULong64 tmp = ptrs1;
-          nextptr &= (tmp << 32);
+          nextptr |= (tmp << 32);
         }
       }
 
@@ -1728,7 +1944,20 @@ namespace lib {
         case 3: //SYSTEM VARIABLE
           isSysVar = 0x02; //see? no break. defines a read-write system variable (default)
         case 2: //VARIABLE
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (!wantedVars.empty())
+          {
+            //lazy restore: peek at the name (only the start of a compressed record is expanded)
+            if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr, 4096);
+            char* varname = 0;
+            if (!xdr_string(xdrs, &varname, 2048)) break;
+            std::string upName = StrUpCase(varname);
+            free(varname);
+            if (wantedVars.count(upName) == 0) break;
+            foundVars.insert(upName);
+            fseek(fid, currentptr, SEEK_SET);
+            xdrs = xdrsfile;
+          }
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
         {
           char* varname = 0;
           if (!xdr_string(xdrs, &varname, 2048)) break;
@@ -1763,7 +1992,7 @@ namespace lib {
         }
           break;
       case 16: //HEAP_DATA: use previous variable, now that the list of heap pointers is complete.
-          if (isCompress) xdrs = uncompress_trick(fid, xdrsmem, expanded, nextptr, currentptr);
+          if (isCompress) xdrs = uncompressRecord(fid, xdrsmem, expanded, nextptr, currentptr);
         {
           int32_t heap_index = 0;
           if (!xdr_int32_t(xdrs, &heap_index)) break;
@@ -1781,6 +2010,7 @@ namespace lib {
             if (debug) std::cerr<<"success restore Heap var"<<std::endl;
             BaseGDL* ret = heapIndexMapRestore.find(heap_index)->second.first;
             fillVariableData(xdrs, ret);
+            if (heapToFill > 0) --heapToFill;
           }
         }
           break;
@@ -1789,7 +2019,6 @@ namespace lib {
       }
     }
     
-    if (expanded!=NULL) free(expanded);
     fclose(fid);
     delete xdrsmem;
     delete xdrsfile;
@@ -1797,6 +2026,26 @@ namespace lib {
     //if problem, guards should deleted the allocated BaseGDLs.
     if (SomethingFussyHappened) e->Throw("Error Reading File: " + name + ".");
     //here everything was ok
+    for (std::set<std::string>::iterator it = wantedVars.begin(); it != wantedVars.end(); ++it)
+      if (foundVars.count(*it) == 0) Message("Variable not found in save file: " + *it + ".");
+
+    //with VARIABLES=, all the heap data of the file was restored: free again
+    //what the restored variables do not point to
+    if (!wantedVars.empty() && !heapIndexMapRestore.empty())
+    {
+      DPtrListT ptrAccessible, objAccessible;
+      for (SizeT i = 0; i < variableVector.size(); ++i) EnvBaseT::Add(ptrAccessible, objAccessible, variableVector[i].second);
+      for (SizeT i = 0; i < systemVariableVector.size(); ++i) EnvBaseT::Add(ptrAccessible, objAccessible, systemVariableVector[i].second);
+      for (SizeT i = 0; i < systemReadonlyVariableVector.size(); ++i) EnvBaseT::Add(ptrAccessible, objAccessible, systemReadonlyVariableVector[i].second);
+      for (std::map<long, std::pair<BaseGDL*,DPtr>>::iterator it = heapIndexMapRestore.begin(); it != heapIndexMapRestore.end(); ++it)
+      {
+        DPtr id = it->second.second;
+        if (objHeapIndex.count(it->first) > 0)
+        {
+          if (objAccessible.count(id) == 0) e->FreeObjHeap(id);
+        } else if (ptrAccessible.count(id) == 0) e->FreeHeap(id);
+      }
+    }
 
 
 
@@ -35,8 +35,15 @@
 #include <fcntl.h>
 #include <map>
 #include <cerrno>
+#if !defined(_WIN32) || defined(__CYGWIN__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "envt.hpp"
+#include "semshm.hpp"
+#include "basic_fun.hpp"
 
 
 namespace lib {
@@ -263,4 +270,358 @@ namespace lib {
     }
   }
 
+
+  // shared memory ***********************************************************
+
+  // map: segment_name -> segment data
+  typedef struct {
+    char*     addr;     // start of the mapping
+    SizeT     length;   // bytes mapped
+    SizeT     skip;     // bytes before the data (file mappings are page aligned)
+    DString   osHandle; // shm_open() name or file name
+    DType     type;     // default type and dimensions for SHMVAR
+    dimension dim;
+    SizeT     nRef;     // SHMVAR variables alive
+    bool      unmapped; // SHMUNMAP called: unmap when nRef drops to 0
+    bool      destroy;  // shm_unlink() when unmapping
+  } shm_data_t;
+
+  typedef std::map<DString, shm_data_t> shm_map_t;
+
+  static shm_map_t &shm_map()
+  {
+    static shm_map_t map;
+    return map;
+  }
+
+  static void shm_release(shm_map_t::iterator it)
+  {
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    munmap(it->second.addr, it->second.length);
+    if (it->second.destroy)
+    {
+      shm_unlink(it->second.osHandle.c_str());
+    }
+#endif
+    shm_map().erase(it);
+  }
+
+  // reference counting by the variables returned by SHMVAR
+  static void shm_ref(const DString &name, int delta)
+  {
+    shm_map_t::iterator it = shm_map().find(name);
+    if (it == shm_map().end()) return;
+    it->second.nRef += delta;
+    if (it->second.nRef == 0 && it->second.unmapped)
+    {
+      shm_release(it);
+    }
+  }
+
+  // a variable whose data is (a part of) a mapped segment
+  template<class Parent_>
+  class ShmVar_: public Parent_
+  {
+    DString segment;
+
+  public:
+    // not from the Data_ free list, the size differs
+    static void* operator new(size_t bytes) { return ::operator new(bytes); }
+    static void operator delete(void *ptr) { ::operator delete(ptr); }
+
+    ShmVar_(const dimension &dim, char *data, const DString &segment_)
+      : Parent_(dim, BaseGDL::NOALLOC), segment(segment_)
+    {
+      this->SetBuffer(data);
+      this->SetBufferSize(dim.NDimElementsConst());
+      shm_ref(segment, 1);
+    }
+
+    ~ShmVar_()
+    {
+      // the data belongs to the segment
+      this->SetBuffer(NULL);
+      this->SetBufferSize(0);
+      shm_ref(segment, -1);
+    }
+  };
+
+  static SizeT shm_type_size(DType type)
+  {
+    switch (type)
+    {
+      case GDL_BYTE: return sizeof(DByte);
+      case GDL_INT: return sizeof(DInt);
+      case GDL_UINT: return sizeof(DUInt);
+      case GDL_LONG: return sizeof(DLong);
+      case GDL_ULONG: return sizeof(DULong);
+      case GDL_LONG64: return sizeof(DLong64);
+      case GDL_ULONG64: return sizeof(DULong64);
+      case GDL_FLOAT: return sizeof(DFloat);
+      case GDL_DOUBLE: return sizeof(DDouble);
+      case GDL_COMPLEX: return sizeof(DComplex);
+      case GDL_COMPLEXDBL: return sizeof(DComplexDbl);
+      default: return 0;
+    }
+  }
+
+  // TYPE=, SIZE= or one of the type flags, GDL_UNDEF if none given
+  static DType shm_type(EnvT *e)
+  {
+    static const char *flags[] = {"BYTE", "INTEGER", "LONG", "FLOAT", "DOUBLE",
+      "COMPLEX", "DCOMPLEX", "UINT", "ULONG", "L64", "UL64"};
+    static const DType flagTypes[] = {GDL_BYTE, GDL_INT, GDL_LONG, GDL_FLOAT,
+      GDL_DOUBLE, GDL_COMPLEX, GDL_COMPLEXDBL, GDL_UINT, GDL_ULONG,
+      GDL_LONG64, GDL_ULONG64};
+
+    DType type = GDL_UNDEF;
+    int typeIx = e->KeywordIx("TYPE");
+    int sizeIx = e->KeywordIx("SIZE");
+    if (e->KeywordPresent(typeIx))
+    {
+      DLong t;
+      e->AssureLongScalarKW(typeIx, t);
+      type = static_cast<DType>(t);
+    }
+    else if (e->KeywordPresent(sizeIx))
+    {
+      DLongGDL *s = e->GetKWAs<DLongGDL>(sizeIx);
+      SizeT n = s->N_Elements();
+      if (n < 3) e->Throw("SIZE vector is too short.");
+      type = static_cast<DType>((*s)[n - 2]);
+    }
+    else
+    {
+      for (SizeT i = 0; i < sizeof(flags) / sizeof(flags[0]); ++i)
+        if (e->KeywordSet(e->KeywordIx(flags[i])))
+        {
+          type = flagTypes[i];
+          break;
+        }
+      return type;
+    }
+    if (shm_type_size(type) == 0)
+      e->Throw("Shared memory segments must have a numeric type: " + i2s(type));
+    return type;
+  }
+
+  // dimensions from the parameters D1..D8 (first one at pOffs), DIMENSION=
+  // or SIZE=, false if none given
+  static bool shm_dim(EnvT *e, SizeT pOffs, dimension &dim)
+  {
+    int dimensionIx = e->KeywordIx("DIMENSION");
+    int sizeIx = e->KeywordIx("SIZE");
+    if (e->NParam() > pOffs)
+    {
+      arr(e, dim, pOffs);
+      return true;
+    }
+    if (e->KeywordPresent(dimensionIx))
+    {
+      DLongGDL *d = e->GetKWAs<DLongGDL>(dimensionIx);
+      for (SizeT i = 0; i < d->N_Elements(); ++i)
+      {
+        if ((*d)[i] < 1) e->Throw("Array dimensions must be greater than 0.");
+        dim << (*d)[i];
+      }
+      return true;
+    }
+    if (e->KeywordPresent(sizeIx))
+    {
+      DLongGDL *s = e->GetKWAs<DLongGDL>(sizeIx);
+      SizeT n = s->N_Elements();
+      if (n < 3 || (*s)[0] < 1 || static_cast<SizeT>((*s)[0]) + 3 > n)
+        e->Throw("SIZE vector is inconsistent.");
+      for (DLong i = 1; i <= (*s)[0]; ++i) dim << (*s)[i];
+      return true;
+    }
+    return false;
+  }
+
+  static shm_map_t::iterator shm_get(const DString &name, EnvT *e)
+  {
+    shm_map_t::iterator it = shm_map().find(name);
+    if (it == shm_map().end() || it->second.unmapped)
+    {
+      e->Throw("Unknown shared memory segment name provided: " + name + ".");
+    }
+    return it;
+  }
+
+  // executed in gdlexit()
+  void shm_onexit()
+  {
+    shm_map_t &map = shm_map();
+    while (!map.empty()) shm_release(map.begin());
+  }
+
+  void shmmap_pro(EnvT *e)
+  {
+#if defined(_WIN32) && !defined(__CYGWIN__)
+    e->Throw("Shared memory is not supported on this platform.");
+#else
+    SizeT nParam = e->NParam();
+
+    static SizeT segmentCount = 0;
+    DString name;
+    if (nParam > 0)
+      e->AssureStringScalarPar(0, name);
+    else
+      name = "GDL_SHM_" + i2s(++segmentCount);
+    if (shm_map().find(name) != shm_map().end())
+      e->Throw("Shared memory segment name already in use: " + name + ".");
+
+    DType type = shm_type(e);
+    if (type == GDL_UNDEF) type = GDL_FLOAT;
+    dimension dim;
+    if (!shm_dim(e, 1, dim))
+      e->Throw("Segment dimensions must be specified.");
+    SizeT nBytes = dim.NDimElements() * shm_type_size(type);
+
+    static int destroyIx = e->KeywordIx("DESTROY_SEGMENT");
+    static int filenameIx = e->KeywordIx("FILENAME");
+    static int offsetIx = e->KeywordIx("OFFSET");
+    static int osHandleIx = e->KeywordIx("OS_HANDLE");
+    static int getNameIx = e->KeywordIx("GET_NAME");
+    static int getOsHandleIx = e->KeywordIx("GET_OS_HANDLE");
+
+    shm_data_t data;
+    data.type = type;
+    data.dim = dim;
+    data.nRef = 0;
+    data.unmapped = false;
+    data.skip = 0;
+
+    int fd;
+    bool created = false;
+    if (e->KeywordPresent(filenameIx))
+    {
+      // a file mapped shared: its content is the segment
+      e->AssureStringScalarKW(filenameIx, data.osHandle);
+      DLong64 offset = 0;
+      if (e->KeywordPresent(offsetIx)) e->AssureLongScalarKW(offsetIx, offset);
+      if (offset < 0) e->Throw("OFFSET must not be negative.");
+      fd = open(data.osHandle.c_str(), O_RDWR);
+      if (fd < 0)
+        e->Throw("Unable to open file: " + data.osHandle + ". " + strerror(errno));
+      SizeT page = sysconf(_SC_PAGESIZE);
+      data.skip = offset % page;
+      struct stat st;
+      if (fstat(fd, &st) != 0 ||
+          static_cast<SizeT>(st.st_size) < static_cast<SizeT>(offset) + nBytes)
+      {
+        close(fd);
+        e->Throw("File " + data.osHandle + " is too short for the requested segment.");
+      }
+      data.length = data.skip + nBytes;
+      void *addr = mmap(NULL, data.length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        fd, offset - data.skip);
+      close(fd);
+      if (addr == MAP_FAILED)
+        e->Throw("Unable to map file: " + data.osHandle + ". " + strerror(errno));
+      data.addr = static_cast<char *>(addr);
+      data.destroy = false;
+    }
+    else
+    {
+      // POSIX shared memory object, created unless it exists already
+      if (e->KeywordPresent(osHandleIx))
+        e->AssureStringScalarKW(osHandleIx, data.osHandle);
+      else
+        data.osHandle = "/GDL_" + i2s(getpid()) + "_" + name;
+      if (data.osHandle.empty() || data.osHandle[0] != '/')
+        data.osHandle = "/" + data.osHandle;
+      fd = shm_open(data.osHandle.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+      if (fd >= 0)
+      {
+        created = true;
+        if (ftruncate(fd, nBytes) != 0)
+        {
+          close(fd);
+          shm_unlink(data.osHandle.c_str());
+          e->Throw("Unable to size shared memory segment: " + data.osHandle + ". " + strerror(errno));
+        }
+      }
+      else if (errno == EEXIST)
+      {
+        fd = shm_open(data.osHandle.c_str(), O_RDWR, 0666);
+      }
+      if (fd < 0)
+        e->Throw("Unable to open shared memory segment: " + data.osHandle + ". " + strerror(errno));
+      struct stat st;
+      if (fstat(fd, &st) != 0 || static_cast<SizeT>(st.st_size) < nBytes)
+      {
+        close(fd);
+        e->Throw("Shared memory segment " + data.osHandle + " is smaller than requested.");
+      }
+      data.length = nBytes;
+      void *addr = mmap(NULL, nBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      close(fd);
+      if (addr == MAP_FAILED)
+      {
+        if (created) shm_unlink(data.osHandle.c_str());
+        e->Throw("Unable to map shared memory segment: " + data.osHandle + ". " + strerror(errno));
+      }
+      data.addr = static_cast<char *>(addr);
+      // as for the semaphores: the creator removes the segment unless
+      // DESTROY_SEGMENT says otherwise
+      data.destroy = created;
+      if (e->KeywordPresent(destroyIx))
+        data.destroy = e->KeywordSet(destroyIx);
+    }
+
+    shm_map().insert(std::pair<DString, shm_data_t>(name, data));
+
+    if (e->KeywordPresent(getNameIx))
+      e->SetKW(getNameIx, new DStringGDL(name));
+    if (e->KeywordPresent(getOsHandleIx))
+      e->SetKW(getOsHandleIx, new DStringGDL(data.osHandle));
+#endif
+  }
+
+  BaseGDL* shmvar_fun(EnvT *e)
+  {
+    e->NParam(1);
+    DString name;
+    e->AssureStringScalarPar(0, name);
+    shm_map_t::iterator it = shm_get(name, e);
+    const shm_data_t &data = it->second;
+
+    DType type = shm_type(e);
+    if (type == GDL_UNDEF) type = data.type;
+    dimension dim;
+    if (!shm_dim(e, 1, dim)) dim = data.dim;
+    if (dim.NDimElements() * shm_type_size(type) > data.length - data.skip)
+      e->Throw("Requested variable is larger than the shared memory segment " + name + ".");
+
+    char *addr = data.addr + data.skip;
+    switch (type)
+    {
+      case GDL_BYTE: return new ShmVar_<DByteGDL>(dim, addr, name);
+      case GDL_INT: return new ShmVar_<DIntGDL>(dim, addr, name);
+      case GDL_UINT: return new ShmVar_<DUIntGDL>(dim, addr, name);
+      case GDL_LONG: return new ShmVar_<DLongGDL>(dim, addr, name);
+      case GDL_ULONG: return new ShmVar_<DULongGDL>(dim, addr, name);
+      case GDL_LONG64: return new ShmVar_<DLong64GDL>(dim, addr, name);
+      case GDL_ULONG64: return new ShmVar_<DULong64GDL>(dim, addr, name);
+      case GDL_FLOAT: return new ShmVar_<DFloatGDL>(dim, addr, name);
+      case GDL_DOUBLE: return new ShmVar_<DDoubleGDL>(dim, addr, name);
+      case GDL_COMPLEX: return new ShmVar_<DComplexGDL>(dim, addr, name);
+      case GDL_COMPLEXDBL: return new ShmVar_<DComplexDblGDL>(dim, addr, name);
+      default: e->Throw("Shared memory segments must have a numeric type.");
+    }
+    return NULL;
+  }
+
+  void shmunmap_pro(EnvT *e)
+  {
+    e->NParam(1);
+    DString name;
+    e->AssureStringScalarPar(0, name);
+    shm_map_t::iterator it = shm_get(name, e);
+    // variables still using it keep the mapping alive
+    it->second.unmapped = true;
+    if (it->second.nRef == 0) shm_release(it);
+  }
+
 }
@@ -30,6 +30,12 @@ namespace lib {
 
   void sem_onexit();
 
+  void shmmap_pro(EnvT*);
+  BaseGDL* shmvar_fun(EnvT*);
+  void shmunmap_pro(EnvT*);
+
+  void shm_onexit();
+
 } // namespace
 
 #endif
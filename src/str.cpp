@@ -19,6 +19,7 @@
 #include "includefirst.hpp"
 
 #include <cstdlib>
+#include <cstring>
 
 // that's enough with Cygwin >= 1.7.1 
 //#ifdef __CYGWIN__
@@ -130,41 +131,97 @@ string StrMid(const string& s, long first, long len, bool reverse)
   return s.substr( first, len);
 }
 
-string StrCompress(const string& s, bool removeAll)
+// Byte scanning for blanks (' ' or '\t'), eight bytes at a time.
+// A word contains a byte equal to c iff HasZeroByte( w ^ (c * 0x0101..01)).
+static const DULong64 SWAR_ONES  = 0x0101010101010101ULL;
+static const DULong64 SWAR_HIGHS = 0x8080808080808080ULL;
+
+static inline DULong64 HasZeroByte( DULong64 w)
 {
-  SizeT strLen = s.length();
-  if( strLen == 0) return string("");
+  return (w - SWAR_ONES) & ~w & SWAR_HIGHS;
+}
 
-  string res;
+static inline bool HasBlank( DULong64 w)
+{
+  return (HasZeroByte( w ^ (SWAR_ONES * ' ')) | HasZeroByte( w ^ (SWAR_ONES * '\t'))) != 0;
+}
 
-  if( removeAll)
+static inline bool IsBlank( char c) { return c == ' ' || c == '\t';}
+
+// index of the first blank in s[0..len[, len if there is none
+SizeT StrFindBlank( const char* s, SizeT len)
+{
+  SizeT i = 0;
+  for( ; i + sizeof( DULong64) <= len; i += sizeof( DULong64))
     {
-      for( SizeT i=0; i<strLen; ++i)
-	if( s[i] != ' ' && s[i] != '\t') res += s[i];
-      return res;
+      DULong64 w;
+      memcpy( &w, s + i, sizeof( DULong64));
+      if( HasBlank( w)) break;
     }
+  for( ; i < len; ++i)
+    if( IsBlank( s[ i])) return i;
+  return len;
+}
+
+void StrCompressInplace( string& s, bool removeAll)
+{
+  SizeT strLen = s.length();
+  // the common case: nothing to do
+  SizeT first = StrFindBlank( s.data(), strLen);
+  if( first == strLen) return;
 
-  SizeT actPos = 0;
-  while( actPos < strLen)
+  // compact towards the front, the write position never passes the read one
+  char* p = &s[ 0];
+  SizeT w = first;
+  if( removeAll)
+    {
+      for( SizeT r = first; r < strLen; ++r)
+	if( !IsBlank( p[ r])) p[ w++] = p[ r];
+    }
+  else
     {
-      SizeT first = s.find_first_not_of(" \t",actPos);
-      if( first >= strLen)
+      bool inBlank = false;
+      for( SizeT r = first; r < strLen; ++r)
 	{
-	  res += " ";
-	  break;
+	  if( IsBlank( p[ r]))
+	    {
+	      if( !inBlank) p[ w++] = ' ';
+	      inBlank = true;
+	    }
+	  else
+	    {
+	      p[ w++] = p[ r];
+	      inBlank = false;
+	    }
 	}
-      if( first != actPos) res += " ";
-
-      SizeT last  = s.find_first_of(" \t",first);
-      if( last >= strLen) last = strLen;
-      actPos = last;
-
-      res += s.substr( first, last-first);
     }
+  s.resize( w);
+}
 
+string StrCompress(const string& s, bool removeAll)
+{
+  string res( s);
+  StrCompressInplace( res, removeAll);
   return res;
 }
 
+void StrTrimInplace( string& s, int mode)
+{
+  SizeT strLen = s.length();
+  SizeT last = strLen;
+  if( mode != 1) // trailing
+    {
+      while( last > 0 && IsBlank( s[ last-1])) --last;
+      s.resize( last);
+    }
+  if( mode != 0) // leading
+    {
+      SizeT first = 0;
+      while( first < last && IsBlank( s[ first])) ++first;
+      if( first > 0) s.erase( 0, first);
+    }
+}
+
 void StrPut(std::string& s1, const std::string& s2, DLong pos)
 {
   unsigned len1=s1.length();
@@ -174,63 +231,36 @@ void StrPut(std::string& s1, const std::string& s2, DLong pos)
   s1.replace( pos, n, s2, 0, n);
 }
 
-string StrUpCase(const string& s)
+// ASCII case mapping (GDL runs in the "C" locale), written branch free so
+// that the compiler vectorizes it
+void StrUpCaseInplace( string& s)
 {
-  unsigned len=s.length();
-  char const *sCStr=s.c_str();
-  char* r = new char[len+1];
-  ArrayGuard<char> guard( r);
-  r[len]=0;
-  for(unsigned i=0;i<len;i++)
-#ifdef _MSC_VER
-    r[i]=toupper(sCStr[i]);
-#else
-  r[i]=std::toupper(sCStr[i]);
-#endif
-  return string(r);
+  SizeT len = s.length();
+  if( len == 0) return;
+  unsigned char* p = reinterpret_cast<unsigned char*>( &s[ 0]);
+  for( SizeT i=0; i<len; ++i)
+    p[ i] -= static_cast<unsigned char>( p[ i] - 'a' < 26u) << 5;
 }
-void StrUpCaseInplace( string& s)
+string StrUpCase(const string& s)
 {
-  unsigned len=s.length();
-  //   char const *sCStr=s.c_str();
-  //   char* r = new char[len+1];
-  //   ArrayGuard<char> guard( r);
-  //   r[len]=0;
-  for(unsigned i=0;i<len;i++)
-#ifdef _MSC_VER
-    s[i]=toupper(s[i]);
-#else
-  s[i]=std::toupper(s[i]);
-#endif
-  //   return string(r);
+  string res( s);
+  StrUpCaseInplace( res);
+  return res;
 }
 
-string StrLowCase(const string& s)
+void StrLowCaseInplace(string& s)
 {
-  unsigned len=s.length();
-  char const *sCStr=s.c_str();
-  char* r = new char[len+1];
-  ArrayGuard<char> guard( r);
-  r[len]=0;
-  for(unsigned i=0;i<len;i++)
-#ifdef _MSC_VER
-    r[i]=tolower(sCStr[i]);
-#else
-  r[i]=std::tolower(sCStr[i]);
-#endif
-  return string(r);
+  SizeT len = s.length();
+  if( len == 0) return;
+  unsigned char* p = reinterpret_cast<unsigned char*>( &s[ 0]);
+  for( SizeT i=0; i<len; ++i)
+    p[ i] += static_cast<unsigned char>( p[ i] - 'A' < 26u) << 5;
 }
-void StrLowCaseInplace(string& s)
+string StrLowCase(const string& s)
 {
-  unsigned len=s.length();
-  //   char const *sCStr=s.c_str();
-  for(unsigned i=0;i<len;i++)
-#ifdef _MSC_VER
-    s[i]=tolower(s[i]);
-#else
-  s[i]=std::tolower(s[i]);
-#endif
-  //     s[i]=std::tolower(sCStr[i]);
+  string res( s);
+  StrLowCaseInplace( res);
+  return res;
 }
 
 // replacement for library routine 
@@ -267,6 +297,70 @@ double StrToD( const char* cStart, char** cEnd)
     }
   return ret;
 }
+double StrToDFast( const char* cStart, char** cEnd)
+{
+  // exactly representable powers of ten
+  static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+    1e20, 1e21, 1e22};
+  const unsigned long long maxMant = 1ULL << 53;
+
+  const char* c = cStart;
+  bool neg = (*c == '-');
+  if( *c == '-' || *c == '+') ++c;
+
+  unsigned long long mant = 0;
+  int nDigits = 0;
+  int exp10 = 0;
+  const char* digits = c;
+  for( ; *c >= '0' && *c <= '9'; ++c, ++nDigits)
+    mant = mant * 10 + (*c - '0');
+  bool intDigits = (c != digits);
+  if( *c == '.')
+    {
+      const char* frac = ++c;
+      for( ; *c >= '0' && *c <= '9'; ++c, ++nDigits)
+	mant = mant * 10 + (*c - '0');
+      exp10 = -static_cast<int>( c - frac);
+      if( !intDigits && c == frac)
+	return StrToD( cStart, cEnd); // no digits at all
+    }
+  else if( !intDigits || *c == 'x' || *c == 'X') // inf, nan, hex...
+    return StrToD( cStart, cEnd);
+
+  if( *c == 'e' || *c == 'E' || *c == 'd' || *c == 'D')
+    {
+      // an exponent only if digits follow, else the number ends here
+      const char* e = c + 1;
+      bool eNeg = (*e == '-');
+      if( *e == '-' || *e == '+') ++e;
+      if( *e >= '0' && *e <= '9')
+	{
+	  int eVal = 0;
+	  for( ; *e >= '0' && *e <= '9'; ++e)
+	    {
+	      if( eVal > 10000)
+		return StrToD( cStart, cEnd);
+	      eVal = eVal * 10 + (*e - '0');
+	    }
+	  exp10 += eNeg ? -eVal : eVal;
+	  c = e;
+	}
+    }
+
+  if( nDigits > 19 || mant > maxMant || exp10 < -22 || exp10 > 22)
+    return StrToD( cStart, cEnd);
+
+  if( cEnd != NULL)
+    *cEnd = const_cast<char*>( c);
+  double ret = static_cast<double>( mant);
+  if( exp10 < 0)
+    ret /= pow10[ -exp10];
+  else
+    ret *= pow10[ exp10];
+  return neg ? -ret : ret;
+}
+
 double Str2D( const char* cStart)
 {
   char* cEnd;
@@ -79,6 +79,10 @@ void StrUpCaseInplace(std::string&);
 std::string StrLowCase(const std::string&);
 void StrLowCaseInplace(std::string&);
 std::string StrCompress(const std::string&,bool removeAll);
+void StrCompressInplace(std::string&,bool removeAll);
+// mode as for STRTRIM: 0 trailing, 1 leading, 2 both
+void StrTrimInplace(std::string&,int mode);
+SizeT StrFindBlank(const char* s, SizeT len);
 void StrPut(std::string& s1, const std::string& s2, DLong pos);
 
 class String_abbref_eq: public std::unary_function< std::string, bool>
@@ -110,6 +114,10 @@ public:
 // this is done very slow by copying the string and replacing the first d/D with e/E
 // however, this only, if strtod fails. Otherwise the overhead is minimal
 double StrToD( const char* cStart, char** cEnd);
+// StrToD() computing plain decimal numbers ([+-]digits[.digits][eEdD[+-]digits])
+// with at most 2^53 as mantissa and a power of ten below 10^23 directly
+// (exact, so the same result as strtod); anything else goes to StrToD()
+double StrToDFast( const char* cStart, char** cEnd);
 
 double Str2D( const char* c);
 double Str2D( const std::string& s);
@@ -0,0 +1,259 @@
+/***************************************************************************
+                 write_csv.cpp  -  WRITE_CSV
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+// native version of the former write_csv.pro. The rows are formatted in
+// parallel, a block of rows per buffer, and the buffers are written in
+// order. Numbers are written as STRING() would (without the padding),
+// strings and complex values are quoted.
+
+#include "includefirst.hpp"
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "write_csv.hpp"
+#include "dstructgdl.hpp"
+#include "num2str.hpp"
+
+namespace lib {
+
+  using namespace std;
+
+  // one output column: element offset + row * stride of data
+  struct CSVColumn
+  {
+    BaseGDL* data;
+    SizeT offset, stride;
+    CSVColumn( BaseGDL* d, SizeT o, SizeT s): data( d), offset( o), stride( s) {}
+  };
+
+  static void AppendQuoted( string& out, const DString& s)
+  {
+    out += '"';
+    for( SizeT i = 0; i < s.size(); ++i)
+      {
+	if( s[ i] == '"') out += '"';
+	out += s[ i];
+      }
+    out += '"';
+  }
+
+  // OutAuto( val, w, d) (the default output of STRING()) without the
+  // padding; or PRECISION significant digits when precision > 0
+  template< typename T>
+  static void AppendFloat( string& out, T val, int w, int d, int precision)
+  {
+    if( precision > 0 && std::isfinite( val))
+      {
+	char buf[ 64];
+	int n = snprintf( buf, sizeof( buf), "%.*g", precision, static_cast<double>( val));
+	if( n > 0 && n < static_cast<int>( sizeof( buf)))
+	  {
+	    out.append( buf, n);
+	    return;
+	  }
+	ostringstream oss;
+	oss << setprecision( precision) << val;
+	out += oss.str();
+	return;
+      }
+    string s = Auto2String( val, w, d);
+    SizeT first = s.find_first_not_of( ' ');
+    if( first != string::npos)
+      out.append( s, first, string::npos);
+  }
+
+  static void AppendValue( string& out, BaseGDL* p, SizeT ix, int precision)
+  {
+    switch( p->Type())
+      {
+      case GDL_BYTE: out += Int2String( (*static_cast<DByteGDL*>( p))[ ix], 0); break;
+      case GDL_INT: out += Int2String( (*static_cast<DIntGDL*>( p))[ ix], 0); break;
+      case GDL_UINT: out += Int2String( (*static_cast<DUIntGDL*>( p))[ ix], 0); break;
+      case GDL_LONG: out += Int2String( (*static_cast<DLongGDL*>( p))[ ix], 0); break;
+      case GDL_ULONG: out += Int2String( (*static_cast<DULongGDL*>( p))[ ix], 0); break;
+      case GDL_LONG64: out += Int2String( (*static_cast<DLong64GDL*>( p))[ ix], 0); break;
+      case GDL_ULONG64: out += Int2String( (*static_cast<DULong64GDL*>( p))[ ix], 0); break;
+      case GDL_FLOAT: AppendFloat( out, (*static_cast<DFloatGDL*>( p))[ ix], 13, 6, precision); break;
+      case GDL_DOUBLE: AppendFloat( out, (*static_cast<DDoubleGDL*>( p))[ ix], 16, 8, precision); break;
+      case GDL_COMPLEX:
+	{
+	  DComplex c = (*static_cast<DComplexGDL*>( p))[ ix];
+	  out += "\"(";
+	  AppendFloat( out, c.real(), 13, 6, precision);
+	  out += ',';
+	  AppendFloat( out, c.imag(), 13, 6, precision);
+	  out += ")\"";
+	  break;
+	}
+      case GDL_COMPLEXDBL:
+	{
+	  DComplexDbl c = (*static_cast<DComplexDblGDL*>( p))[ ix];
+	  out += "\"(";
+	  AppendFloat( out, c.real(), 16, 8, precision);
+	  out += ',';
+	  AppendFloat( out, c.imag(), 16, 8, precision);
+	  out += ")\"";
+	  break;
+	}
+      case GDL_STRING: AppendQuoted( out, (*static_cast<DStringGDL*>( p))[ ix]); break;
+      default: break; // checked before
+      }
+  }
+
+  void write_csv( EnvT* e)
+  {
+    SizeT nParam = e->NParam( 2);
+    if( e->GetParDefined( 0)->Type() != GDL_STRING)
+      e->Throw( "Filename must be a string.");
+    DString name;
+    e->AssureScalarPar<DStringGDL>( 0, name);
+    WordExp( name);
+
+    static int delimiterIx = e->KeywordIx( "DELIMITER");
+    static int headerIx = e->KeywordIx( "HEADER");
+    static int precisionIx = e->KeywordIx( "PRECISION");
+    static int tableHeaderIx = e->KeywordIx( "TABLE_HEADER");
+
+    const string mess = "Data fields must all have the same number of elements.";
+    vector<CSVColumn> column;
+    vector<DString> header;
+    SizeT nRows;
+    BaseGDL* p1 = e->GetParDefined( 1);
+    if( p1->Type() == GDL_STRUCT)
+      {
+	// one column per tag, the tag names as header
+	if( nParam > 2)
+	  e->Throw( "Too many parameters.");
+	DStructGDL* s = static_cast<DStructGDL*>( p1);
+	if( s->N_Elements() != 1)
+	  e->Throw( "Expression must be a scalar in this context: " + e->GetParString( 1));
+	for( SizeT t = 0; t < s->NTags(); ++t)
+	  {
+	    column.push_back( CSVColumn( s->GetTag( t, 0), 0, 1));
+	    header.push_back( s->Desc()->TagName( t));
+	  }
+	nRows = column[ 0].data->N_Elements();
+	for( SizeT t = 1; t < column.size(); ++t)
+	  if( column[ t].data->N_Elements() != nRows)
+	    e->Throw( mess);
+      }
+    else if( p1->Rank() == 2)
+      {
+	// one column per element of the first dimension
+	if( nParam > 2)
+	  e->Throw( "Too many parameters.");
+	SizeT nCols = p1->Dim( 0);
+	for( SizeT j = 0; j < nCols; ++j)
+	  column.push_back( CSVColumn( p1, j, nCols));
+	nRows = p1->Dim( 1);
+      }
+    else
+      {
+	// one column per parameter
+	nRows = p1->N_Elements();
+	for( SizeT p = 1; p < nParam; ++p)
+	  {
+	    BaseGDL* par = e->GetParDefined( p);
+	    if( par->N_Elements() != nRows)
+	      e->Throw( mess);
+	    column.push_back( CSVColumn( par, 0, 1));
+	  }
+      }
+    SizeT nCols = column.size();
+    for( SizeT j = 0; j < nCols; ++j)
+      {
+	DType t = column[ j].data->Type();
+	if( t == GDL_STRUCT || t == GDL_PTR || t == GDL_OBJ)
+	  e->Throw( "Data type not supported: " + column[ j].data->TypeStr());
+      }
+
+    if( e->KeywordPresent( headerIx))
+      {
+	DStringGDL* h = e->GetKWAs<DStringGDL>( headerIx);
+	header.assign( &(*h)[ 0], &(*h)[ 0] + h->N_Elements());
+      }
+    DString delimiter = ",";
+    if( e->KeywordPresent( delimiterIx))
+      e->AssureStringScalarKW( delimiterIx, delimiter);
+    DLong precision = 0;
+    if( e->KeywordPresent( precisionIx))
+      e->AssureLongScalarKW( precisionIx, precision);
+
+    ofstream ofs( name.c_str(), ios::binary | ios::trunc);
+    if( !ofs)
+      e->Throw( "Error opening file. File: " + name);
+
+    string line;
+    if( e->KeywordPresent( tableHeaderIx))
+      {
+	DStringGDL* table = e->GetKWAs<DStringGDL>( tableHeaderIx);
+	for( SizeT i = 0; i < table->N_Elements(); ++i)
+	  line += (*table)[ i] + '\n';
+      }
+    if( !header.empty())
+      {
+	for( SizeT j = 0; j < header.size(); ++j)
+	  {
+	    if( j > 0) line += delimiter;
+	    AppendQuoted( line, header[ j]);
+	  }
+	line += '\n';
+      }
+    ofs.write( line.data(), line.size());
+
+    // blocks of rows formatted in parallel, one buffer per block, written
+    // in order; a batch of blocks at a time bounds the memory used
+    const SizeT blockRows = 1024;
+    const SizeT batchBlocks = 256;
+    vector<string> block( batchBlocks);
+    SizeT nBlocks = (nRows + blockRows - 1) / blockRows;
+    for( SizeT b0 = 0; b0 < nBlocks; b0 += batchBlocks)
+      {
+	SizeT nB = (nBlocks - b0 < batchBlocks) ? nBlocks - b0 : batchBlocks;
+	SizeT nEl = nB * blockRows * nCols;
+#pragma omp parallel for if (nEl >= CpuTPOOL_MIN_ELTS && (CpuTPOOL_MAX_ELTS == 0 || CpuTPOOL_MAX_ELTS <= nEl))
+	for( OMPInt b = 0; b < nB; ++b)
+	  {
+	    string& out = block[ b];
+	    out.clear();
+	    SizeT r0 = (b0 + b) * blockRows;
+	    SizeT r1 = (r0 + blockRows < nRows) ? r0 + blockRows : nRows;
+	    for( SizeT r = r0; r < r1; ++r)
+	      {
+		for( SizeT j = 0; j < nCols; ++j)
+		  {
+		    if( j > 0) out += delimiter;
+		    AppendValue( out, column[ j].data, column[ j].offset + r * column[ j].stride, precision);
+		  }
+		out += '\n';
+	      }
+	  }
+	for( SizeT b = 0; b < nB; ++b)
+	  ofs.write( block[ b].data(), block[ b].size());
+	if( !ofs)
+	  e->Throw( "Error writing file: " + name);
+      }
+    ofs.close();
+    if( ofs.fail())
+      e->Throw( "Error writing file: " + name);
+  }
+
+} // namespace
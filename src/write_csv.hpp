@@ -0,0 +1,28 @@
+/***************************************************************************
+                 write_csv.hpp  -  WRITE_CSV
+                             -------------------
+    begin                : October 2026
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef WRITE_CSV_HPP_
+#define WRITE_CSV_HPP_
+
+#include "datatypes.hpp"
+#include "envt.hpp"
+
+namespace lib {
+
+  void write_csv( EnvT* e);
+
+} // namespace
+
+#endif
@@ -0,0 +1,80 @@
+;
+; Basic benchmark on TRANSPOSE() throughput, in GB/s
+; (bytes read + bytes written, per second)
+;
+; pro BENCH_TRANSPOSE
+; - The /Save keyword will allow you to save the results
+;   and intercompare on different computers and with IDL & FL
+;
+; BENCH_TRANSPOSE, size=4096, nb_run=5, /double, /save
+;
+; ----------
+; Modification history :
+;
+; --------------------------------------------------------------
+;
+function BENCH_TRANSPOSE_RATE, input, perm, nb_run, temporary=temporary
+;
+nbytes=2.*N_ELEMENTS(input)*(SIZE(input,/type) EQ 5 ? 8 : 4)
+best=1e30
+for ii=0, nb_run-1 do begin
+   if KEYWORD_SET(temporary) then tmp=input
+   time0=SYSTIME(1)
+   if KEYWORD_SET(temporary) then begin
+      b=TRANSPOSE(TEMPORARY(tmp))
+   endif else begin
+      if N_ELEMENTS(perm) GT 0 then b=TRANSPOSE(input, perm) else b=TRANSPOSE(input)
+   endelse
+   time1=SYSTIME(1)
+   best=best < (time1-time0)
+endfor
+return, nbytes/(best > 1e-6)/1e9
+end
+;
+; --------------------------------------------------------------
+;
+pro BENCH_TRANSPOSE, size=size, nb_run=nb_run, $
+                     save=save, double=double, $
+                     verbose=verbose, test=test, help=help
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro BENCH_TRANSPOSE, size=size, nb_run=nb_run, $'
+   print, '                     save=save, double=double, $'
+   print, '                     verbose=verbose, test=test, help=help'
+   return
+endif
+;
+if KEYWORD_SET(save) then CHECK_SAVE_RESTORE
+;
+if KEYWORD_SET(double) then radical='transpose_d' else radical='transpose'
+;
+if (N_ELEMENTS(size) EQ 0) then size=4096
+if (N_ELEMENTS(nb_run) EQ 0) then nb_run=5
+;
+size3=LONG(size^(2./3.)) ; same number of elements as the 2D case
+;
+cases=['2D', '2D, square, TEMPORARY()', '3D [2,1,0]', '3D [1,0,2]', '3D [1,2,0]']
+rate_transpose=FLTARR(N_ELEMENTS(cases))
+;
+input=RANDOMU(seed, size, size, double=double)
+rate_transpose[0]=BENCH_TRANSPOSE_RATE(input, perm, nb_run)
+rate_transpose[1]=BENCH_TRANSPOSE_RATE(input, perm, nb_run, /temporary)
+;
+input=RANDOMU(seed, size3, size3, size3, double=double)
+rate_transpose[2]=BENCH_TRANSPOSE_RATE(input, [2,1,0], nb_run)
+rate_transpose[3]=BENCH_TRANSPOSE_RATE(input, [1,0,2], nb_run)
+rate_transpose[4]=BENCH_TRANSPOSE_RATE(input, [1,2,0], nb_run)
+input=0
+;
+for ii=0, N_ELEMENTS(cases)-1 do $
+   print, format='(A-28, " : ", F8.2, " GB/s")', cases[ii], rate_transpose[ii]
+;
+if KEYWORD_SET(save) then begin
+   cpuinfo=BENCHMARK_GENERATE_CPUINFO()
+   filename=BENCHMARK_GENERATE_FILENAME(radical)   
+   SAVE, filename=filename, cpuinfo, size, cases, rate_transpose
+endif
+;
+if KEYWORD_SET(test) then STOP
+;
+end
@@ -1,5 +1,5 @@
 ;
-; testing ARRAY_INDICES (.pro)
+; testing ARRAY_INDICES
 ;
 ; initial version by Reto Stockli <reto.stockli@gmail.com>
 ; https://sourceforge.net/p/gnudatalanguage/patches/87/
@@ -110,6 +110,48 @@ end
 ;
 ; -------------------------------------
 ;
+; many indices at once, result shape and type, errors
+;
+pro TEST_ARRAY_INDICES_LARGE, cumul_errors, verbose=verbose, test=test
+;
+nb_errors=0
+;
+dims=[7,5,3,4]
+n=PRODUCT(dims, /integer)
+ix=LINDGEN(50000) mod n
+res=ARRAY_INDICES(dims, ix, /dimensions)
+if ~ARRAY_EQUAL(SIZE(res, /dim), [4,50000]) then $
+   ERRORS_ADD, nb_errors, 'dimensions of the result'
+expected=TRANSPOSE([[ix mod 7], [(ix/7) mod 5], [(ix/35) mod 3], [ix/105]])
+if ~ARRAY_EQUAL(res, expected) then ERRORS_ADD, nb_errors, 'many indices'
+if SIZE(res, /type) NE 3 then ERRORS_ADD, nb_errors, 'LONG result'
+if SIZE(ARRAY_INDICES(dims, 5LL, /dim), /type) NE 14 then $
+   ERRORS_ADD, nb_errors, 'LONG64 result'
+if ~ARRAY_EQUAL(SIZE(ARRAY_INDICES(dims, 5, /dim), /dim), 4) then $
+   ERRORS_ADD, nb_errors, 'scalar index'
+;
+CATCH, err
+if err EQ 0 then begin
+   r=ARRAY_INDICES(dims, n, /dim)
+   ERRORS_ADD, nb_errors, 'no error on index out of range'
+endif
+CATCH, /cancel
+;
+; REPLICATE of a scalar fills the whole array
+r=REPLICATE(3.5, 100, 200)
+if ~ARRAY_EQUAL(r, 3.5) || N_ELEMENTS(r) NE 20000 then $
+   ERRORS_ADD, nb_errors, 'REPLICATE'
+r=REPLICATE('ab', 1000)
+if ~ARRAY_EQUAL(r, 'ab') then ERRORS_ADD, nb_errors, 'REPLICATE string'
+;
+BANNER_FOR_TESTSUITE, 'TEST_ARRAY_INDICES_LARGE', nb_errors, /status
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+;
+end
+;
+; -------------------------------------
+;
 pro TEST_ARRAY_INDICES, help=help, verbose=verbose, no_exit=no_exit, test=test
 ;
 if KEYWORD_SET(help) then begin
@@ -124,6 +166,14 @@ TEST_ARRAY_INDICES_REKO, nb_errors, verbose=verbose, test=test
 ;
 TEST_ARRAY_INDICES_DIST, nb_errors, verbose=verbose, test=test
 ;
+TEST_ARRAY_INDICES_LARGE, nb_errors, verbose=verbose, test=test
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_ARRAY_INDICES_LARGE, nb_errors, verbose=verbose, test=test
+CPU, RESTORE=SAVECPU
+;
 ; ----------------- final message ----------
 ;
 BANNER_FOR_TESTSUITE, 'TEST_ARRAY_INDICES', nb_errors
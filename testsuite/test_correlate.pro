@@ -141,6 +141,57 @@ end
 ;
 ; -----------------------------------
 ;
+; C_CORRELATE and A_CORRELATE against the sums over the lagged
+; deviations (IDL definitions); long lag lists may go through an FFT
+;
+pro TEST_CORRELATE_LAGS, cumul_errors, verbose=verbose, test=test
+;
+nb_errors=0
+;
+n=500
+x=SIN(FINDGEN(n)*0.1)+RANDOMU(seed, n)
+y=SHIFT(x, 7)+RANDOMU(seed, n)*0.1
+xd=x-MEAN(x, /double)
+yd=y-MEAN(y, /double)
+;
+for pass=0, 1 do begin
+   lag=(pass EQ 0) ? [-3, 0, 7, 12] : LINDGEN(2*n-1)-(n-1)
+   nl=N_ELEMENTS(lag)
+   cross=DBLARR(nl)
+   auto=DBLARR(nl)
+   for i=0, nl-1 do begin
+      l=lag[i]
+      if l GE 0 then cross[i]=TOTAL(xd[0:n-l-1]*yd[l:*]) $
+      else cross[i]=TOTAL(yd[0:n+l-1]*xd[-l:*])
+      al=ABS(l)
+      auto[i]=TOTAL(xd[0:n-al-1]*xd[al:*])
+   endfor
+   ;
+   res=C_CORRELATE(x, y, lag, /double)
+   if MAX(ABS(res-cross/SQRT(TOTAL(xd^2)*TOTAL(yd^2)))) GT 1e-10 then $
+      ERRORS_ADD, nb_errors, 'C_CORRELATE, pass '+STRTRIM(pass,2)
+   res=C_CORRELATE(x, y, lag, /covariance, /double)
+   if MAX(ABS(res-cross/n)) GT 1e-10 then $
+      ERRORS_ADD, nb_errors, 'C_CORRELATE /COV, pass '+STRTRIM(pass,2)
+   res=A_CORRELATE(x, lag, /double)
+   if MAX(ABS(res-auto/TOTAL(xd^2))) GT 1e-10 then $
+      ERRORS_ADD, nb_errors, 'A_CORRELATE, pass '+STRTRIM(pass,2)
+endfor
+;
+; the peak is at the shift, the lag 0 autocorrelation is one
+if (WHERE(C_CORRELATE(x, y, INDGEN(21)-10) EQ MAX(C_CORRELATE(x, y, INDGEN(21)-10))))[0] NE 17 then $
+   ERRORS_ADD, nb_errors, 'C_CORRELATE peak'
+if ABS(A_CORRELATE(x, 0)-1) GT 1e-6 then ERRORS_ADD, nb_errors, 'A_CORRELATE lag 0'
+if SIZE(A_CORRELATE(x, [1,2]), /type) NE 4 then ERRORS_ADD, nb_errors, 'FLOAT result'
+;
+BANNER_FOR_TESTSUITE, 'TEST_CORRELATE_LAGS', nb_errors, /short
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_set(test) then STOP
+;
+end
+;
+; -----------------------------------
+;
 pro TEST_CORRELATE, no_exit=no_exit, help=help, verbose=verbose, test=test
 ;
 if KEYWORD_SET(help) then begin
@@ -155,6 +206,7 @@ TEST_CORRELATE_BASIC, cumul_errors, verbose=verbose, test=test
 TEST_CORRELATE_COYOTE, cumul_errors, verbose=verbose, test=test
 TEST_CORRELATE_COYOTE, cumul_errors, translate=1, verbose=verbose, test=test
 TEST_CORRELATE_COYOTE, cumul_errors, translate=2, verbose=verbose, test=test
+TEST_CORRELATE_LAGS, cumul_errors, verbose=verbose, test=test
 ;
 ; ----------------- final message ----------
 ;
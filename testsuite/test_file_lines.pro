@@ -1,9 +1,60 @@
-PRO test_file_lines, no_exit=no_exit
+;
+; FILE_LINES: CR, LF and CR LF line ends, last line without end,
+; compressed files, several files at once
+;
+; ---------------------------------------
+;
+pro TEST_FILE_LINES_WRITE, file, bytes, compress=compress
+OPENW, lun, file, /get_lun, compress=compress
+if N_ELEMENTS(bytes) GT 0 then WRITEU, lun, bytes
+FREE_LUN, lun
+end
+;
+; ---------------------------------------
+;
+PRO test_file_lines, no_exit=no_exit, test=test
 total_errors=0
 filesw = file_which("swap_endian.pro")
 if file_lines(filesw) ne 96 then total_errors++
 if file_lines(filesw,/compress) ne 96 then total_errors++
 ;
+prefix=GDL_IDL_FL(/lower)+'_test_file_lines_'
+files=prefix+['lf','cr','crlf','mixed','noend','empty','gz']+'.txt'
+cr=13b & lf=10b & x=120b
+TEST_FILE_LINES_WRITE, files[0], [x,lf,x,lf,lf]
+TEST_FILE_LINES_WRITE, files[1], [x,cr,x,cr,cr]
+TEST_FILE_LINES_WRITE, files[2], [x,cr,lf,x,cr,lf,cr,lf]
+TEST_FILE_LINES_WRITE, files[3], [x,cr,lf,lf,cr,cr,lf,x,lf]
+TEST_FILE_LINES_WRITE, files[4], [x,lf,x]
+TEST_FILE_LINES_WRITE, files[5]
+TEST_FILE_LINES_WRITE, files[6], [x,cr,lf,x,lf,x], /compress
+expected=[3,3,3,5,2,0,3]
+for i=0, N_ELEMENTS(files)-1 do $
+   if FILE_LINES(files[i]) NE expected[i] then ERRORS_ADD, total_errors, files[i]
+;
+; several files (counted in parallel), shape of the result kept
+nb=FILE_LINES(REFORM(files, 7, 1))
+if ~ARRAY_EQUAL(nb, expected) || ~ARRAY_EQUAL(SIZE(nb, /dim), [7,1]) then $
+   ERRORS_ADD, total_errors, 'array of files'
+;
+; large file, counted in blocks
+big=prefix+'big.txt'
+n=3000000L
+line=[x,x,cr,lf]
+TEST_FILE_LINES_WRITE, big, REFORM(REBIN(line, 4, n), 4*n)
+if FILE_LINES(big) NE n then ERRORS_ADD, total_errors, 'large file'
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+if FILE_LINES(big) NE n then ERRORS_ADD, total_errors, 'large file, threads'
+if ~ARRAY_EQUAL(FILE_LINES([files, big]), [expected, n]) then $
+   ERRORS_ADD, total_errors, 'array of files, threads'
+CPU, TPOOL_NTHREADS=1
+if ~ARRAY_EQUAL(FILE_LINES([files, big]), [expected, n]) then $
+   ERRORS_ADD, total_errors, 'array of files, one thread'
+CPU, RESTORE=SAVECPU
+;
+FILE_DELETE, [files, big], /quiet
+;
 ; final message
 ;
 BANNER_FOR_TESTSUITE, 'TEST_FILE_LINES', total_errors, short=short
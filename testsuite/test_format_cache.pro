@@ -0,0 +1,95 @@
+;
+; Formats are parsed once and kept (least recently used dropped
+; first): results must not depend on whether a format comes from
+; the cache. Also checks the stream-free I, F and E conversions.
+;
+; ---------------------------------------
+;
+pro TEST_FORMAT_CACHE_REUSE, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+; the same format many times, and many different formats (more than
+; the cache holds) before going back to the first ones
+fmt='(I5,":",F8.3,1x,A)'
+first=STRING(7, 3.14159, 'abc', format=fmt)
+for i=0, 99 do $
+   if STRING(7, 3.14159, 'abc', format=fmt) NE first then $
+      ERRORS_ADD, nb_errors, 'same format'
+;
+for i=1, 300 do begin
+   s=STRING(i, format='(I'+STRTRIM(i MOD 40 + 4, 2)+'.'+STRTRIM(i MOD 3, 2)+')')
+   if STRLEN(s) NE i MOD 40 + 4 || LONG(s) NE i then ERRORS_ADD, nb_errors, 'format '+STRTRIM(i,2)
+endfor
+if STRING(7, 3.14159, 'abc', format=fmt) NE first then ERRORS_ADD, nb_errors, 'after eviction'
+if first NE '    7:   3.142 abc' then ERRORS_ADD, nb_errors, 'value'
+;
+; a bad format is reported each time, it is not cached
+for i=0, 1 do begin
+   catch, err
+   if err EQ 0 then begin
+      s=STRING(1, format='(I5,')
+      ERRORS_ADD, nb_errors, 'bad format accepted'
+   endif
+   catch, /cancel
+endfor
+;
+BANNER_FOR_TESTSUITE, 'TEST_FORMAT_CACHE_REUSE', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_FORMAT_CACHE_CONVERSIONS, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+if STRING(-5, format='(I5)') NE '   -5' then ERRORS_ADD, nb_errors, 'I5'
+if STRING(-5, format='(I05)') NE '-0005' then ERRORS_ADD, nb_errors, 'I05'
+if STRING(42, format='(I0)') NE '42' then ERRORS_ADD, nb_errors, 'I0'
+if STRING(123456, format='(I3)') NE '***' then ERRORS_ADD, nb_errors, 'I3 overflow'
+if STRING(-9223372036854775807LL-1, format='(I0)') NE '-9223372036854775808' then $
+   ERRORS_ADD, nb_errors, 'LONG64 min'
+if STRING(18446744073709551615ULL, format='(I0)') NE '18446744073709551615' then $
+   ERRORS_ADD, nb_errors, 'ULONG64 max'
+if STRING(12, format='(I-5,"|")') NE '12   |' then ERRORS_ADD, nb_errors, 'I left aligned'
+if ~ARRAY_EQUAL(STRING([1,-20,300], format='(3I4)'), '   1 -20 300') then $
+   ERRORS_ADD, nb_errors, 'array'
+;
+if STRING(3.14159, format='(F8.3)') NE '   3.142' then ERRORS_ADD, nb_errors, 'F8.3'
+if STRING(2.6, format='(F5.0)') NE '   3.' then ERRORS_ADD, nb_errors, 'F5.0'
+if STRING(-0.25d, format='(F08.3)') NE '-000.250' then ERRORS_ADD, nb_errors, 'F08.3'
+if STRING(1d10, format='(F6.2)') NE '******' then ERRORS_ADD, nb_errors, 'F overflow'
+if STRLEN(STRING(1d300, format='(F0.1)')) NE 303 then ERRORS_ADD, nb_errors, 'F huge'
+if STRING(12345., format='(E10.3)') NE ' 1.235E+04' then ERRORS_ADD, nb_errors, 'E10.3'
+if STRING(12345., format='(e10.3)') NE ' 1.235e+04' then ERRORS_ADD, nb_errors, 'e10.3'
+if STRING(-1d-100, format='(E12.4)') NE '-1.0000E-100' then ERRORS_ADD, nb_errors, 'E12.4'
+;
+BANNER_FOR_TESTSUITE, 'TEST_FORMAT_CACHE_CONVERSIONS', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_FORMAT_CACHE, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_FORMAT_CACHE, help=help, verbose=verbose, $'
+   print, '                       no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+TEST_FORMAT_CACHE_REUSE, cumul_errors, verbose=verbose
+TEST_FORMAT_CACHE_CONVERSIONS, cumul_errors, verbose=verbose
+;
+BANNER_FOR_TESTSUITE, 'TEST_FORMAT_CACHE', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
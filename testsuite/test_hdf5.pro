@@ -73,6 +73,13 @@ expected='Peter is great.'
 ;
 if ~ARRAY_EQUAL(mystring, expected) then errors=1
 ;
+; strings read through a FILE_SPACE dataspace
+space_id=H5D_GET_SPACE(data_id)
+mystring=''
+ok=EXECUTE('mystring=H5D_READ(data_id, file_space=space_id)')
+if ~ARRAY_EQUAL(mystring, expected) then errors++
+H5S_CLOSE, space_id
+;
 BANNER_FOR_TESTSUITE, 'TEST_HDF5_STRING', errors, /short
 ;
 if KEYWORD_SET(test) then STOP
@@ -84,6 +91,69 @@ end
 ;
 ; -----------------------------------------------
 ;
+pro TEST_HDF5_WRITE_READ, cumul_errors, test=test
+;
+; chunked and deflated dataset written, then read back whole
+; (chunks inflated in parallel) and through hyperslab selections
+;
+errors=0
+;
+file=GDL_IDL_FL(/lower)+'_test_hdf5_write.h5'
+FILE_DELETE, file, /quiet
+;
+data=FINDGEN(77,130,50)
+file_id=H5F_CREATE(file)
+type_id=H5T_IDL_CREATE(data)
+space_id=H5S_CREATE_SIMPLE(SIZE(data, /dim))
+data_id=H5D_CREATE(file_id, 'cube', type_id, space_id, $
+                   chunk_dimensions=[16,32,7], gzip=6)
+H5D_WRITE, data_id, data
+H5D_CLOSE, data_id
+H5S_CLOSE, space_id
+H5T_CLOSE, type_id
+H5F_CLOSE, file_id
+;
+file_id=H5F_OPEN(file)
+data_id=H5D_OPEN(file_id, 'cube', chunk_cache_size=16000000L, $
+                 chunk_cache_slots=1021)
+;
+cube=H5D_READ(data_id)
+if ~ARRAY_EQUAL(SIZE(cube, /dim), [77,130,50]) then begin
+    MESSAGE, /continue, 'Bad dimensions ...'
+    errors++
+endif
+if ~ARRAY_EQUAL(cube, data, /no_typeconv) then begin
+    MESSAGE, /continue, 'Bad values (whole chunked dataset) ...'
+    errors++
+endif
+;
+space_id=H5D_GET_SPACE(data_id)
+H5S_SELECT_HYPERSLAB, space_id, [1,2,3], [4,5,6], stride=[10,3,2], $
+                      block=[2,1,1], /reset
+sub=H5D_READ(data_id, file_space=space_id)
+ix=1+(LINDGEN(8)/2)*10+(LINDGEN(8) mod 2)
+expected=((data[ix,*,*])[*,2+LINDGEN(5)*3,*])[*,*,3+LINDGEN(6)*2]
+if ~ARRAY_EQUAL(SIZE(sub, /dim), [8,5,6]) || ~ARRAY_EQUAL(sub, expected) then begin
+    MESSAGE, /continue, 'Bad hyperslab (stride, block) ...'
+    errors++
+endif
+H5S_CLOSE, space_id
+;
+H5D_CLOSE, data_id
+H5F_CLOSE, file_id
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, 'TEST_HDF5_WRITE_READ', errors, /short
+;
+if KEYWORD_SET(test) then STOP
+;
+if ~ISA(cumul_errors) then cumul_errors=0
+cumul_errors=cumul_errors+errors
+;
+end
+;
+; -----------------------------------------------
+;
 pro TEST_HDF5, help=help, test=test, no_exit=no_exit
 ;
 if KEYWORD_SET(help) then begin
@@ -110,6 +180,14 @@ TEST_HDF5_BYTE_ARRAY, cumul_errors
 ;
 TEST_HDF5_STRING, cumul_errors
 ;
+TEST_HDF5_WRITE_READ, cumul_errors
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_HDF5_WRITE_READ, cumul_errors
+CPU, RESTORE=SAVECPU
+;
 BANNER_FOR_TESTSUITE, 'TEST_HDF5', cumul_errors
 ;
 if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
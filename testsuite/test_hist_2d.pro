@@ -70,6 +70,25 @@ for i = 0, N_ELEMENTS(mins) - 1 do ptr_free, mins[i]
 for i = 0, N_ELEMENTS(maxs) - 1 do ptr_free, maxs[i]
 for i = 0, N_ELEMENTS(bins) - 1 do ptr_free, bins[i]
 ;
+; HIST_ND (native since HIST_2D is): counts, WEIGHTS and REVERSE_INDICES
+MESSAGE, 'HIST_ND tests...', /conti
+pts = RANDOMU(seed, 3, 10000)
+h = HIST_ND(pts, 0.25, min=0, max=1, reverse=ri)
+if ~ARRAY_EQUAL(SIZE(h, /dim), [5,5,5]) || TOTAL(h) ne 10000 then nb_errors++
+ix = FIX(pts/0.25)
+flat = ix[0,*] + 5*(ix[1,*] + 5*ix[2,*])
+if ~ARRAY_EQUAL(h, HISTOGRAM(flat, min=0, max=124)) then nb_errors++
+if ~ARRAY_EQUAL(ri[ri[42]:ri[43]-1], WHERE(flat eq 42)) then nb_errors++
+hw = HIST_ND(pts, 0.25, min=0, max=1, weights=REPLICATE(2., 10000))
+if SIZE(hw, /type) ne 5 || ~ARRAY_EQUAL(hw, 2*h) then nb_errors++
+hn = HIST_ND(pts, nbins=4, min=0, max=1)
+if ~ARRAY_EQUAL(SIZE(hn, /dim), [4,4,4]) || TOTAL(hn) ne 10000 then nb_errors++
+;; with NBINS a value equal to MAX is not clamped (as in the former
+;; hist_nd.pro): it goes to the next bin of the following dimension,
+;; and is dropped for the last dimension
+hm = HIST_ND([[1.,0.],[0.,1.],[0.2,0.2]], nbins=2, min=0, max=1)
+if ~ARRAY_EQUAL(hm, [[1,0],[1,0]]) then nb_errors++
+;
 ; ----------------- final message ----------
 ;
 BANNER_FOR_TESTSUITE, 'TEST_HIST_2D', nb_errors
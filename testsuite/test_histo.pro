@@ -3,6 +3,7 @@
 ; SA 30-Aug-2009 (TEST_HISTO_BASIC)
 ; AC 06-Dec-2011 (adding TEST_HISTO_NAN)
 ; AC 20-Feb-2013 (adding TEST_HISTO_UNITY_BIN)
+; 2026-Oct (adding TEST_HISTO_REVERSE_INPUT)
 ;
 pro TEST_HISTO_RANDOMU, nbp=nbp, nan=nan
 ;
@@ -154,11 +155,71 @@ if KEYWORD_SET(test) then STOP
 ;
 end
 ;
+; REVERSE_INDICES (built in parallel for large inputs) must list the
+; indices of each bin in ascending order, and accumulating chunks
+; through INPUT= must give the histogram of the whole array
+;
+pro TEST_HISTO_REVERSE_INPUT, cumul_errors, test=test
+;
+nb_errors=0
+;
+for type=1, 15 do if type lt 6 or type gt 11 then begin
+   data=FIX(RANDOMU(seed, 200000)*1000, type=type)
+   h=HISTOGRAM(data, min=0, max=999, binsize=7, reverse=ri)
+   if TOTAL(h, /integer) NE N_ELEMENTS(data) then $
+      ERRORS_ADD, nb_errors, 'bad total, type: '+STRING(type)
+   if ri[0] NE N_ELEMENTS(h)+1 then $
+      ERRORS_ADD, nb_errors, 'bad ri[0], type: '+STRING(type)
+   for i=0, N_ELEMENTS(h)-1, 13 do begin
+      if ri[i+1]-ri[i] NE h[i] then begin
+         ERRORS_ADD, nb_errors, 'bad ri bounds, type: '+STRING(type)
+         break
+      endif
+      if h[i] EQ 0 then continue
+      ix=ri[ri[i]:ri[i+1]-1]
+      if ~ARRAY_EQUAL(ix, WHERE(data GE i*7 and data LT (i+1)*7)) then begin
+         ERRORS_ADD, nb_errors, 'bad ri content, type: '+STRING(type)
+         break
+      endif
+   endfor
+   ;;
+   ;; same histogram by chunks
+   hc=HISTOGRAM(data[0:49999], min=0, max=999, binsize=7)
+   hc=HISTOGRAM(data[50000:*], min=0, max=999, binsize=7, input=hc)
+   if ~ARRAY_EQUAL(hc, h) then $
+      ERRORS_ADD, nb_errors, 'bad INPUT accumulation, type: '+STRING(type)
+   hc=HISTOGRAM(data[0:49999], min=0, max=999, binsize=7, /l64)
+   hc=HISTOGRAM(data[50000:*], min=0, max=999, binsize=7, input=hc)
+   if (SIZE(hc, /type) NE 14) or ~ARRAY_EQUAL(hc, h) then $
+      ERRORS_ADD, nb_errors, 'bad /L64 accumulation, type: '+STRING(type)
+endif
+;
+; strings are binned as DOUBLE
+h=HISTOGRAM(['1','2.5','2','5'], min=0, binsize=1, reverse=ri)
+if ~ARRAY_EQUAL(h, HISTOGRAM([1d,2.5,2,5], min=0, binsize=1)) || $
+   ~ARRAY_EQUAL(h, [0,1,2,0,0,1]) then ERRORS_ADD, nb_errors, 'bad STRING input'
+;
+BANNER_FOR_TESTSUITE, 'TEST_HISTO_REVERSE_INPUT', nb_errors, /status
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+;
+end
+;
 ; ------------------------------------------------------------------
 ;
-pro TEST_HISTO
+pro TEST_HISTO, no_exit=no_exit, test=test
+;
+cumul_errors=0
 ;
 TEST_HISTO_UNITY_BIN
 ;
+TEST_HISTO_REVERSE_INPUT, cumul_errors
+;
+BANNER_FOR_TESTSUITE, 'TEST_HISTO', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
 end
 
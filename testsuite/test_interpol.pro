@@ -112,6 +112,39 @@ endif else begin
     if ~KEYWORD_SET(quiet) then MESSAGE, 'SUCCESS: extrapol. line w. spline', /continue
 endelse
 ;
+; quadratic interpolation is exact on a parabola, also outside
+;
+x = [0.,1.,2.,3.,4.]
+y = x*x
+x_new = [-1., 0.5, 1.25, 3.5, 6.]
+if (MAX(ABS(INTERPOL(y, x, x_new, /quadratic)-x_new^2)) GT error_level) then begin
+    MESSAGE, 'ERROR: quadratic', /continue
+    nb_errors=nb_errors+1
+endif else begin
+    if ~KEYWORD_SET(quiet) then MESSAGE, 'SUCCESS: quadratic', /continue
+endelse
+;
+; decreasing abscissae, non finite points kept, result shape and type
+;
+res=INTERPOL(REVERSE(y), REVERSE(x), [[0.5, !values.f_nan],[2.5, 3.]])
+expected=[[0.5, !values.f_nan],[6.5, 9.]]
+if ~ARRAY_EQUAL(res[[0,2,3]], expected[[0,2,3]]) || FINITE(res[1]) || $
+   ~ARRAY_EQUAL(SIZE(res, /dim), [2,2]) then begin
+    MESSAGE, 'ERROR: decreasing X / NaN', /continue
+    nb_errors=nb_errors+1
+endif else begin
+    if ~KEYWORD_SET(quiet) then MESSAGE, 'SUCCESS: decreasing X / NaN', /continue
+endelse
+;
+if (SIZE(INTERPOL([1,2,3], 5), /type) NE 4) || $
+   (SIZE(INTERPOL([1d,2,3], 5), /type) NE 5) || $
+   (SIZE(INTERPOL(COMPLEX([1,2,3],[3,2,1]), 5), /type) NE 6) then begin
+    MESSAGE, 'ERROR: result type', /continue
+    nb_errors=nb_errors+1
+endif else begin
+    if ~KEYWORD_SET(quiet) then MESSAGE, 'SUCCESS: result type', /continue
+endelse
+;
 ; ------------------- final errors count ------------------
 ;
 if (nb_errors GT 0) then begin
@@ -133,6 +133,48 @@ end
 ;
 ; ----------------------------------------------------
 ;
+; /GRID and point modes must agree, and frames stacked along the
+; leading dimension must give the same result as frame by frame
+;
+pro TEST_INTERPOLATE_GRID_FRAMES, cumul_errors, test=test
+;
+errors=0
+;
+img=DIST(40,30)
+xi=FINDGEN(57)*0.7-1.
+yi=FINDGEN(44)*0.7-1.
+xx=REBIN(xi, 57, 44)
+yy=REBIN(TRANSPOSE(yi), 57, 44)
+;
+for cubic=0,1 do begin
+   g=INTERPOLATE(img, xi, yi, /grid, cubic=(cubic ? -0.5 : 0))
+   p=INTERPOLATE(img, xx, yy, cubic=(cubic ? -0.5 : 0))
+   if ~ARRAY_EQUAL(g, p) then ERRORS_ADD, errors, 'grid/points, cubic: '+STRING(cubic)
+   gm=INTERPOLATE(img, xi, yi, /grid, missing=-1., cubic=(cubic ? -0.5 : 0))
+   if (gm[0] ne -1.) || (gm[56,43] ne -1.) || (gm[10,10] ne g[10,10]) then $
+      ERRORS_ADD, errors, 'grid with missing, cubic: '+STRING(cubic)
+endfor
+;
+frames=FLTARR(3, 40, 30)
+for k=0,2 do frames[k,*,*]=img*(k+1)
+s=INTERPOLATE(frames, xi, yi, /grid)
+for k=0,2 do if ~ARRAY_EQUAL(REFORM(s[k,*,*]), INTERPOLATE(img*(k+1), xi, yi, /grid)) then $
+   ERRORS_ADD, errors, 'stacked frame '+STRING(k)
+;
+cube=FINDGEN(6,5,4)
+v=INTERPOLATE(cube, [0.5,5.], [0.5,4.], [0.5,3.])
+if (ABS(v[0]-(0.5+0.5*6+0.5*30)) gt 1e-5) || (v[1] ne cube[5,4,3]) then $
+   ERRORS_ADD, errors, 'trilinear'
+;
+BANNER_FOR_TESTSUITE, 'TEST_INTERPOLATE_GRID_FRAMES', errors, /status
+;
+ERRORS_CUMUL, cumul_errors, errors
+if KEYWORD_SET(test) then STOP
+;
+end
+;
+; ----------------------------------------------------
+;
 ; Testing the type of the output of INTERPOLATE()
 ; It should be the same than the input !!!
 ;
@@ -178,6 +220,7 @@ TEST_BUG_458, cumul_errors
 TEST_BUG_223, cumul_errors
 TEST_INTERPOLATE_TYPE, cumul_errors
 TEST_INTERPOLATE_MISSING, cumul_errors
+TEST_INTERPOLATE_GRID_FRAMES, cumul_errors
 ;
 ; ----------------- final message ----------
 BANNER_FOR_TESTSUITE, 'TEST_INTERPOLATE', cumul_errors
@@ -0,0 +1,104 @@
+;
+; LOGICAL_AND, LOGICAL_OR, LOGICAL_TRUE: scalar and array operands,
+; result dimension, pointer operands, and refused structures
+;
+; ---------------------------------------
+;
+pro TEST_LOGICAL_VALUES, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+n=100003L
+a=LINDGEN(n) mod 3
+b=FLOAT(LINDGEN(n) mod 2)
+;
+if ~ARRAY_EQUAL(LOGICAL_AND(a, b), BYTE((a NE 0) AND (b NE 0))) then $
+   ERRORS_ADD, nb_errors, 'LOGICAL_AND, arrays'
+if ~ARRAY_EQUAL(LOGICAL_OR(a, b), BYTE((a NE 0) OR (b NE 0))) then $
+   ERRORS_ADD, nb_errors, 'LOGICAL_OR, arrays'
+if ~ARRAY_EQUAL(LOGICAL_TRUE(a), BYTE(a NE 0)) then $
+   ERRORS_ADD, nb_errors, 'LOGICAL_TRUE'
+;
+if ~ARRAY_EQUAL(LOGICAL_AND(1, a), BYTE(a NE 0)) then ERRORS_ADD, nb_errors, 'LOGICAL_AND, true scalar'
+if ~ARRAY_EQUAL(LOGICAL_AND(a, 0), 0b) then ERRORS_ADD, nb_errors, 'LOGICAL_AND, false scalar'
+if ~ARRAY_EQUAL(LOGICAL_OR('a', a), 1b) then ERRORS_ADD, nb_errors, 'LOGICAL_OR, true scalar'
+if ~ARRAY_EQUAL(LOGICAL_OR(a, 0d), BYTE(a NE 0)) then ERRORS_ADD, nb_errors, 'LOGICAL_OR, false scalar'
+;
+; the shorter operand gives the result dimension
+if N_ELEMENTS(LOGICAL_AND(a, [1,1,1])) NE 3 then ERRORS_ADD, nb_errors, 'LOGICAL_AND, dimension'
+if N_ELEMENTS(LOGICAL_OR([0,0], b)) NE 2 then ERRORS_ADD, nb_errors, 'LOGICAL_OR, dimension'
+;
+; pointers: true when not null
+p=PTRARR(n)
+p[0]=PTR_NEW(1)
+if ~ARRAY_EQUAL(LOGICAL_TRUE(p), BYTE(LINDGEN(n) EQ 0)) then ERRORS_ADD, nb_errors, 'LOGICAL_TRUE, pointers'
+if ~ARRAY_EQUAL(LOGICAL_AND(p, a+1), BYTE(LINDGEN(n) EQ 0)) then ERRORS_ADD, nb_errors, 'LOGICAL_AND, pointers'
+if ~ARRAY_EQUAL(LOGICAL_OR(p, b), BYTE((LINDGEN(n) EQ 0) OR (b NE 0))) then ERRORS_ADD, nb_errors, 'LOGICAL_OR, pointers'
+PTR_FREE, p[0]
+;
+BANNER_FOR_TESTSUITE, 'TEST_LOGICAL_VALUES', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_LOGICAL_BAD_TYPES, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+s=REPLICATE({a:1}, 1000)
+;
+CATCH, err
+if err EQ 0 then begin
+   r=LOGICAL_AND(s, 1)
+   ERRORS_ADD, nb_errors, 'LOGICAL_AND accepted a structure'
+endif
+CATCH, /cancel
+;
+CATCH, err
+if err EQ 0 then begin
+   r=LOGICAL_OR(1, s)
+   ERRORS_ADD, nb_errors, 'LOGICAL_OR accepted a structure'
+endif
+CATCH, /cancel
+;
+CATCH, err
+if err EQ 0 then begin
+   r=LOGICAL_TRUE(s)
+   ERRORS_ADD, nb_errors, 'LOGICAL_TRUE accepted a structure'
+endif
+CATCH, /cancel
+;
+BANNER_FOR_TESTSUITE, 'TEST_LOGICAL_BAD_TYPES', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_LOGICAL, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_LOGICAL, help=help, verbose=verbose, $'
+   print, '                  no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+TEST_LOGICAL_VALUES, cumul_errors, verbose=verbose
+TEST_LOGICAL_BAD_TYPES, cumul_errors, verbose=verbose
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_LOGICAL_VALUES, cumul_errors, verbose=verbose
+TEST_LOGICAL_BAD_TYPES, cumul_errors, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+BANNER_FOR_TESTSUITE, 'TEST_LOGICAL', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
@@ -278,6 +278,54 @@ pro DIMENSION_TEST_MINMAX
   endif
 end
 
+;
+; check values and subscripts of MIN/MAX with DIMENSION against
+; MIN/MAX on each extracted slice, with NaNs, with and without /NAN
+pro DIMENSION_VALUES_MINMAX, cumul_errors, verbose=verbose
+;
+nb_errors=0
+data=FLOAT(FIX(RANDOMU(seed, 7, 300, 5)*20))
+data[WHERE(RANDOMU(seed, 7, 300, 5) LT 0.1)]=!values.f_nan
+data[3,*,2]=!values.f_nan ; an all-NaN line along dim 2
+for dim=1, 3 do begin
+   for nan=0, 1 do begin
+      mn=MIN(data, imn, max=mx, sub=imx, dim=dim, nan=nan)
+      dims=SIZE(data, /dim)
+      odims=dims[WHERE(INDGEN(3) NE dim-1)]
+      for j=0, odims[1]-1 do for i=0, odims[0]-1 do begin
+         case dim of
+            1: line=data[*,i,j]
+            2: line=data[i,*,j]
+            3: line=data[i,j,*]
+         endcase
+         rmn=MIN(line, rimn, max=rmx, sub=rimx, nan=nan)
+         ;; all-NaN line with /NAN: subscript 0, as for MIN/MAX without DIMENSION
+         if nan && (TOTAL(FINITE(line)) EQ 0) then begin
+            if (imn[i,j] NE 0) || (imx[i,j] NE 0) || (rimn NE 0) || (rimx NE 0) then $
+               ERRORS_ADD, nb_errors, 'all-NaN subscripts, dim='+STRTRIM(dim,2)
+            continue
+         endif
+         ;; NaN results (no /NAN) must match position, not value
+         ok_mn=(mn[i,j] EQ rmn) || (~FINITE(mn[i,j]) && ~FINITE(rmn))
+         ok_mx=(mx[i,j] EQ rmx) || (~FINITE(mx[i,j]) && ~FINITE(rmx))
+         if ~ok_mn || ~ok_mx then begin
+            ERRORS_ADD, nb_errors, 'values, dim='+STRTRIM(dim,2)+' nan='+STRTRIM(nan,2)
+            break
+         endif
+         ;; subscripts are global: back to the position along dim
+         pmn=(ARRAY_INDICES(data, imn[i,j]))[dim-1]
+         pmx=(ARRAY_INDICES(data, imx[i,j]))[dim-1]
+         if (pmn NE rimn) || (pmx NE rimx) then begin
+            ERRORS_ADD, nb_errors, 'subscripts, dim='+STRTRIM(dim,2)+' nan='+STRTRIM(nan,2)
+            break
+         endif
+      endfor
+   endfor
+endfor
+;
+BANNER_FOR_TESTSUITE, 'DIMENSION_VALUES_MINMAX', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+end
 ;
 ; calling all tests
 ;
@@ -304,4 +352,16 @@ BENCH_TEST_MINMAX, lun, nbp=1e7
 printf,lun, '' & printf,lun, 'Testing the DIMENSION keyword (no output)'
 DIMENSION_TEST_MINMAX
 ;
+cumul_errors=0
+DIMENSION_VALUES_MINMAX, cumul_errors, verbose=verbose
+; same, threaded
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+DIMENSION_VALUES_MINMAX, cumul_errors, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+CLOSE, lun
+FREE_LUN, lun
+if (cumul_errors GT 0) then EXIT, status=1
+;
 end
@@ -112,8 +112,8 @@ indices=4*INDGEN(5)
 if dsfmt_exists() then begin
   exptd_u_f=[0.683328,0.511748,0.712392,0.974657,0.267097]
   exptd_u_d=[       0.6833279104279921,       0.5117476599880262,       0.7123919069196021,       0.9746571081546436, 0.2670968079969038]
-  exptd_n_f=[     -1.0257840,     -0.8902389,      0.2266469,      0.2755476,      0.9339375]
-  exptd_n_d=[      -1.0257840075947602,      -0.8902389633612189,       0.2266468876086417,       0.2755475765848067,       0.9339375254286939]
+  exptd_n_f=[      1.4536258,      0.7250015,     -0.2166718,     -0.1859016,      1.2604266]
+  exptd_n_d=[       1.4536258023444717,       0.7250015353423260,      -0.2166718144857125,      -0.1859016265764556,       1.2604266672536821]
 endif else begin
   exptd_u_f=[0.771321, 0.633648, 0.498507, 0.198063, 0.169111]
   exptd_u_d=[0.77132064, 0.49850701, 0.16911084, 0.0039482663, 0.72175532]
@@ -147,6 +147,43 @@ if KEYWORD_SET(test) then STOP
 end
 ;
 ; ---------------------------------------
+; for a given SEED, dSFMT values must not depend on the number
+; of threads used (arrays larger than one generator chunk)
+;
+pro TEST_RANDOM_THREADS, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+nbp=300000L
+;
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=1000, TPOOL_NTHREADS=1
+seed=10 & u1=RANDOMU(seed, nbp, /double)
+seed=10 & n1=RANDOMN(seed, nbp)
+seed=10 & p1=RANDOMU(seed, nbp, poisson=3.)
+;
+CPU, TPOOL_NTHREADS=!CPU.HW_NCPU
+seed=10 & u2=RANDOMU(seed, nbp, /double)
+seed=10 & n2=RANDOMN(seed, nbp)
+seed=10 & p2=RANDOMU(seed, nbp, poisson=3.)
+CPU, RESTORE=SAVECPU
+;
+if ~ARRAY_EQUAL(u1, u2) then ERRORS_ADD, nb_errors, 'RANDOMU depends on threads'
+if ~ARRAY_EQUAL(n1, n2) then ERRORS_ADD, nb_errors, 'RANDOMN depends on threads'
+if ~ARRAY_EQUAL(p1, p2) then ERRORS_ADD, nb_errors, 'POISSON depends on threads'
+;
+if (ABS(MEAN(n1)) GT 0.01) then ERRORS_ADD, nb_errors, 'RANDOMN mean'
+if (ABS(STDDEV(n1)-1.) GT 0.01) then ERRORS_ADD, nb_errors, 'RANDOMN stddev'
+;
+; ----- final ----
+;
+BANNER_FOR_TESTSUITE, 'TEST_RANDOM_THREADS', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+;
+if KEYWORD_SET(test) then STOP
+;
+end
+;
+; ---------------------------------------
 ; ULONG keyword appeared in IDL 8.2.2
 ;
 pro TEST_RANDOM_ULONG, cumul_errors, test=test, verbose=verbose
@@ -425,6 +462,7 @@ TEST_RANDOM_BINOMIAL, cumul_errors, verbose=verbose, ampl=100.
 if STATUS_VERSION_OF_RANDOM() then begin
    TEST_RANDOM_ULONG, cumul_errors, test=test, verbose=verbose
    TEST_RANDOM_MERSENNE, cumul_errors, test=test, verbose=verbose
+   if dsfmt_exists() then TEST_RANDOM_THREADS, cumul_errors, test=test, verbose=verbose
 endif else begin
    BANNER_FOR_TESTSUITE, 'TEST_RANDOM_ULONG', 'Too old version detected'
    BANNER_FOR_TESTSUITE, 'TEST_RANDOM_SEED', 'Too old version detected'
@@ -0,0 +1,169 @@
+;
+; Tests for the native READ_CSV, and for READ_ASCII without template
+; (which uses the same native parser)
+;
+; ---------------------------------------
+;
+pro TEST_READ_CSV_WRITE, file, lines
+OPENW, lun, file, /get_lun
+for i=0L, N_ELEMENTS(lines)-1 do PRINTF, lun, lines[i]
+FREE_LUN, lun
+end
+;
+; ---------------------------------------
+;
+pro TEST_READ_CSV_BASIC, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+lines=['id,value,name,big', $
+       '1,2.5,"Smith, J.",3000000000', $
+       '', $
+       '2, -1e3 ,plain,4', $
+       '3,,"say ""hi""",5'+STRING(13b)]
+TEST_READ_CSV_WRITE, file, lines
+;
+a=READ_CSV(file, header=header, count=count)
+if ~ARRAY_EQUAL(header, ['id','value','name','big']) then ERRORS_ADD, nb_errors, 'header'
+if count NE 3 then ERRORS_ADD, nb_errors, 'count'
+if ~ARRAY_EQUAL(TAG_NAMES(a), ['FIELD1','FIELD2','FIELD3','FIELD4']) then $
+   ERRORS_ADD, nb_errors, 'tag names'
+if SIZE(a.field1, /type) NE 3 || ~ARRAY_EQUAL(a.field1, [1,2,3]) then $
+   ERRORS_ADD, nb_errors, 'LONG column'
+if SIZE(a.field2, /type) NE 5 || ~ARRAY_EQUAL(a.field2, [2.5d,-1000d,0d]) then $
+   ERRORS_ADD, nb_errors, 'DOUBLE column, missing'
+if ~ARRAY_EQUAL(a.field3, ['Smith, J.','plain','say "hi"']) then $
+   ERRORS_ADD, nb_errors, 'STRING column, quotes'
+if SIZE(a.field4, /type) NE 14 || a.field4[0] NE 3000000000LL then $
+   ERRORS_ADD, nb_errors, 'LONG64 column'
+;
+a=READ_CSV(file, missing_value=-99)
+if a.field2[2] NE -99 then ERRORS_ADD, nb_errors, 'MISSING_VALUE'
+;
+BANNER_FOR_TESTSUITE, 'TEST_READ_CSV_BASIC', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_READ_CSV_KEYWORDS, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+lines=['# produced by', '# nobody', 'a,b']
+lines=[lines, STRTRIM(INDGEN(12),2)+','+STRTRIM(INDGEN(12)*2,2)]
+TEST_READ_CSV_WRITE, file, lines
+;
+a=READ_CSV(file, n_table_header=2, table_header=th, record_start=3, $
+           num_records=4, count=count)
+if ~ARRAY_EQUAL(th, ['# produced by', '# nobody']) then ERRORS_ADD, nb_errors, 'TABLE_HEADER'
+if count NE 4 then ERRORS_ADD, nb_errors, 'COUNT'
+if ~ARRAY_EQUAL(a.field1, [3,4,5,6]) || ~ARRAY_EQUAL(a.field2, [6,8,10,12]) then $
+   ERRORS_ADD, nb_errors, 'RECORD_START, NUM_RECORDS'
+;
+a=READ_CSV(file, n_table_header=2, types=['float','string'])
+if SIZE(a.field1, /type) NE 4 || SIZE(a.field2, /type) NE 7 then $
+   ERRORS_ADD, nb_errors, 'TYPES'
+if a.field2[11] NE '22' then ERRORS_ADD, nb_errors, 'TYPES, STRING value'
+;
+; 12 columns: FIELD01 .. FIELD12
+TEST_READ_CSV_WRITE, file, STRJOIN(STRTRIM(INDGEN(12),2), ',')
+a=READ_CSV(file)
+if (TAG_NAMES(a))[0] NE 'FIELD01' || (TAG_NAMES(a))[11] NE 'FIELD12' then $
+   ERRORS_ADD, nb_errors, 'FIELDnn names'
+;
+BANNER_FOR_TESTSUITE, 'TEST_READ_CSV_KEYWORDS', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_READ_CSV_LARGE, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+n=50000L
+x=LINDGEN(n)-n/2
+y=RANDOMU(seed, n)*1d6
+lines=STRTRIM(x,2)+','+STRING(y, format='(E25.17)')+',s'+STRTRIM(x,2)
+TEST_READ_CSV_WRITE, file, lines
+;
+a=READ_CSV(file, count=count)
+if count NE n then ERRORS_ADD, nb_errors, 'count'
+if ~ARRAY_EQUAL(a.field1, x) then ERRORS_ADD, nb_errors, 'LONG values'
+if ~ARRAY_EQUAL(a.field2, y) then ERRORS_ADD, nb_errors, 'DOUBLE values'
+if ~ARRAY_EQUAL(a.field3, 's'+STRTRIM(x,2)) then ERRORS_ADD, nb_errors, 'STRING values'
+;
+BANNER_FOR_TESTSUITE, 'TEST_READ_CSV_LARGE', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_READ_CSV_READ_ASCII, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+lines=['; a comment', '1 2.5   3', '', '4 abc 6e1 ; trailing', '7d0'+STRING(9b)+'-Inf']
+TEST_READ_CSV_WRITE, file, lines
+;
+a=READ_ASCII(file)
+r=a.field1
+if ~ARRAY_EQUAL(SIZE(r, /dim), [3,3]) then ERRORS_ADD, nb_errors, 'dimensions'
+if ~ARRAY_EQUAL(r[*,0], [1.,2.5,3.]) then ERRORS_ADD, nb_errors, 'line 1'
+if r[0,1] NE 4. || FINITE(r[1,1]) || r[2,1] NE 60. then ERRORS_ADD, nb_errors, 'line 2'
+if r[0,2] NE 7. || r[1,2] NE -!values.f_infinity || FINITE(r[2,2]) then $
+   ERRORS_ADD, nb_errors, 'line 3'
+;
+a=READ_ASCII(file, missing_value=-1, record_start=1)
+if ~ARRAY_EQUAL(a.field1, [[4.,-1.,60.],[7.,-!values.f_infinity,-1.]]) then $
+   ERRORS_ADD, nb_errors, 'missing_value, record_start'
+;
+; a single line gives a vector
+TEST_READ_CSV_WRITE, file, '1 2 3'
+a=READ_ASCII(file)
+if ~ARRAY_EQUAL(SIZE(a.field1, /dim), [3]) || ~ARRAY_EQUAL(a.field1, [1.,2.,3.]) then $
+   ERRORS_ADD, nb_errors, 'single line'
+;
+BANNER_FOR_TESTSUITE, 'TEST_READ_CSV_READ_ASCII', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_READ_CSV, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_READ_CSV, help=help, verbose=verbose, $'
+   print, '                   no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+file=GDL_IDL_FL(/lower)+'_test_read_csv.txt'
+;
+TEST_READ_CSV_BASIC, cumul_errors, file, verbose=verbose
+TEST_READ_CSV_KEYWORDS, cumul_errors, file, verbose=verbose
+TEST_READ_CSV_LARGE, cumul_errors, file, verbose=verbose
+TEST_READ_CSV_READ_ASCII, cumul_errors, file, verbose=verbose
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_READ_CSV_LARGE, cumul_errors, file, verbose=verbose
+TEST_READ_CSV_READ_ASCII, cumul_errors, file, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, 'TEST_READ_CSV', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
@@ -172,6 +172,69 @@ end
 ;
 ; --------------------------------------------
 ;
+; a whole numeric table read at once, values separated by blanks,
+; tabs and newlines, with E and D exponents; reading past the end
+; must still fail
+;
+pro TEST_READF_TABLE, verbose=verbose, errors=errors, test=test
+;
+if N_ELEMENTS(errors) EQ 0 then errors=0
+nb_errors=0
+;
+filename='test_readf_table.tmp'
+n=20000L
+ref=DBLARR(4, n)
+ref[0,*]=DINDGEN(n)
+ref[1,*]=-DINDGEN(n)/8
+ref[2,*]=(DINDGEN(n)+1)*1d-7
+ref[3,*]=DINDGEN(n)*1d20
+;
+OPENW, lun, filename, /get_lun
+for i=0L, n-1 do begin
+   sep=(i MOD 2) ? STRING(9b) : '   '
+   PRINTF, lun, STRTRIM(LONG(ref[0,i]),2)+sep+STRTRIM(STRING(ref[1,i], format='(F0.3)'),2) $
+           +' '+STRING(ref[2,i], format='(E0.10)')+sep $
+           +STRJOIN(STRSPLIT(STRING(ref[3,i], format='(E0.10)'), 'E', /extract), 'D')
+endfor
+FREE_LUN, lun
+;
+OPENR, lun, filename, /get_lun
+a=DBLARR(4, n)
+READF, lun, a
+if MAX(ABS(a-ref)/(ABS(ref)>1d-300)) GT 1d-10 then ERRORS_ADD, nb_errors, 'DOUBLE table'
+POINT_LUN, lun, 0
+l=LONARR(4, 100)
+READF, lun, l
+if ~ARRAY_EQUAL(l[0,*], LINDGEN(1,100)) then ERRORS_ADD, nb_errors, 'LONG column'
+POINT_LUN, lun, 0
+f=FLTARR(4, n)
+READF, lun, f
+if ~ARRAY_EQUAL(f, FLOAT(a)) then ERRORS_ADD, nb_errors, 'FLOAT table'
+;
+catch, err
+if err EQ 0 then begin
+   READF, lun, f
+   ERRORS_ADD, nb_errors, 'no EOF error'
+endif
+catch, /cancel
+FREE_LUN, lun
+FILE_DELETE, filename
+;
+s=FLTARR(5)
+READS, ' 1  2.5'+STRING(9b)+'-3e2 4d1 .5', s
+if ~ARRAY_EQUAL(s, [1., 2.5, -300., 40., 0.5]) then ERRORS_ADD, nb_errors, 'READS'
+;
+if (nb_errors GT 0) then begin
+   MESSAGE, /continue, 'Failure in TEST_READF_TABLE'
+   errors=errors+nb_errors
+endif else MESSAGE, /continue, 'passing with success TEST_READF_TABLE'
+;
+if KEYWORD_SET(test) then STOP
+;
+end
+;
+; --------------------------------------------
+;
 pro TEST_READF, verbose=verbose, no_erase=no_erase, help=help, $
                 no_exit=no_exit, test=test
 ;
@@ -194,6 +257,7 @@ TESTREADF, verbose=verbose, no_erase=no_erase, errors=errors, type='CRLF'
 TESTREADF, verbose=verbose, no_erase=no_erase, errors=errors, type='CR'
 ;
 TEST_BUG_573, verbose=verbose, errors=errors
+TEST_READF_TABLE, verbose=verbose, errors=errors
 ;
 if ~KEYWORD_SET(no_exit) then begin
    if (errors GT 0) then EXIT, status=1
@@ -0,0 +1,169 @@
+;
+; Round trips of READU/WRITEU on large arrays and arrays of structures
+; through /SWAP_ENDIAN, /XDR and /COMPRESS units (all moved in blocks),
+; and on units read with READ_AHEAD
+;
+; ---------------------------------------
+;
+function TEST_READU_BULK_DATA, n
+;
+x=DINDGEN(n)*1.5d - n/3
+return, {b:BYTE(x), i:FIX(x), u:UINT(ABS(x)), l:LONG(x)*1000, $
+         ul:ULONG(ABS(x))*1000, l64:LONG64(x)*100000000LL, $
+         ul64:ULONG64(ABS(x))*100000000ULL, f:FLOAT(x)/7, d:x/7, $
+         c:COMPLEX(x, -x), dc:DCOMPLEX(x/3, -x/3)}
+end
+;
+; ---------------------------------------
+;
+pro TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, test=test, verbose=verbose, $
+                               _extra=extra
+;
+nb_errors=0
+;
+n=100001L
+ref=TEST_READU_BULK_DATA(n)
+;
+; arrays, one WRITEU per type
+OPENW, lun, file, /get_lun, _extra=extra
+for i=0, N_TAGS(ref)-1 do WRITEU, lun, ref.(i)
+FREE_LUN, lun
+;
+OPENR, lun, file, /get_lun, _extra=extra
+for i=0, N_TAGS(ref)-1 do begin
+   a=ref.(i)
+   a[*]=0
+   READU, lun, a
+   if ~ARRAY_EQUAL(a, ref.(i)) then ERRORS_ADD, nb_errors, 'array, tag '+STRTRIM(i,2)
+endfor
+FREE_LUN, lun
+;
+; array of structures with numeric tags
+s=REPLICATE({b:0b, d:0d, i:0, c:COMPLEX(0,0), l64:0LL, f:FLTARR(3)}, 20000)
+s.b=BYTE(LINDGEN(20000))
+s.d=DINDGEN(20000)/3
+s.i=-INDGEN(20000)
+s.c=COMPLEX(FINDGEN(20000), 1)
+s.l64=-LONG64(LINDGEN(20000))*3000000000LL
+s.f=RANDOMU(seed, 3, 20000)
+OPENW, lun, file, /get_lun, _extra=extra
+WRITEU, lun, s
+FREE_LUN, lun
+r=REPLICATE({b:0b, d:0d, i:0, c:COMPLEX(0,0), l64:0LL, f:FLTARR(3)}, 20000)
+OPENR, lun, file, /get_lun, _extra=extra
+READU, lun, r
+FREE_LUN, lun
+for i=0, N_TAGS(s)-1 do $
+   if ~ARRAY_EQUAL(r.(i), s.(i)) then ERRORS_ADD, nb_errors, 'struct, tag '+STRTRIM(i,2)
+;
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, 'TEST_READU_BULK_ROUNDTRIP', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+; the byte order written with /SWAP_ENDIAN is really swapped
+;
+pro TEST_READU_BULK_SWAPPED, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+l=LINDGEN(1000)*65537L
+OPENW, lun, file, /get_lun, /swap_endian
+WRITEU, lun, l, {a:1000L, b:DCOMPLEX(1,2)}
+FREE_LUN, lun
+;
+raw=BYTARR(4, 1000)
+st=BYTARR(4+16)
+OPENR, lun, file, /get_lun
+READU, lun, raw, st
+FREE_LUN, lun
+if ~ARRAY_EQUAL(raw, REVERSE(BYTE(l, 0, 4, 1000), 1)) then ERRORS_ADD, nb_errors, 'LONG'
+if ~ARRAY_EQUAL(st[0:3], REVERSE(BYTE(1000L, 0, 4))) then ERRORS_ADD, nb_errors, 'struct LONG tag'
+if ~ARRAY_EQUAL(st[4:11], REVERSE(BYTE(1d, 0, 8))) then ERRORS_ADD, nb_errors, 'struct DCOMPLEX tag'
+;
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, 'TEST_READU_BULK_SWAPPED', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+; frame by frame reading on READ_AHEAD units, with seeks in between
+;
+pro TEST_READU_BULK_READ_AHEAD, cumul_errors, file, test=test, verbose=verbose, $
+                                _extra=extra
+;
+nb_errors=0
+;
+nx=300L & nFrames=50
+frames=LINDGEN(nx, nx, nFrames)
+OPENW, lun, file, /get_lun, _extra=extra
+WRITEU, lun, frames
+FREE_LUN, lun
+;
+frame=LONARR(nx, nx)
+frameBytes=nx*nx*4LL
+foreach blockSize, [1, 4096, 1000000] do begin
+   OPENR, lun, file, /get_lun, read_ahead=blockSize, _extra=extra
+   for i=0, nFrames-1 do begin
+      READU, lun, frame
+      if ~ARRAY_EQUAL(frame, frames[*,*,i]) then $
+         ERRORS_ADD, nb_errors, 'frame '+STRTRIM(i,2)+', block '+STRTRIM(blockSize,2)
+   endfor
+   if ~EOF(lun) then ERRORS_ADD, nb_errors, 'EOF, block '+STRTRIM(blockSize,2)
+   ;
+   ; back and forth
+   POINT_LUN, lun, 7*frameBytes
+   READU, lun, frame
+   if ~ARRAY_EQUAL(frame, frames[*,*,7]) then ERRORS_ADD, nb_errors, 'seek backward'
+   POINT_LUN, lun, 40*frameBytes+4
+   v=0L
+   READU, lun, v
+   if v NE frames[1,0,40] then ERRORS_ADD, nb_errors, 'seek forward'
+   FREE_LUN, lun
+endforeach
+;
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, 'TEST_READU_BULK_READ_AHEAD', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_READU_BULK, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_READU_BULK, help=help, verbose=verbose, $'
+   print, '                     no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+file=GDL_IDL_FL(/lower)+'_test_readu_bulk.dat'
+;
+TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, verbose=verbose
+TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, verbose=verbose, /swap_endian
+TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, verbose=verbose, /xdr
+TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, verbose=verbose, /xdr, /swap_endian
+TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, verbose=verbose, /compress
+TEST_READU_BULK_ROUNDTRIP, cumul_errors, file, verbose=verbose, /compress, /swap_endian
+TEST_READU_BULK_SWAPPED, cumul_errors, file, verbose=verbose
+TEST_READU_BULK_READ_AHEAD, cumul_errors, file, verbose=verbose
+TEST_READU_BULK_READ_AHEAD, cumul_errors, file, verbose=verbose, /compress
+;
+BANNER_FOR_TESTSUITE, 'TEST_READU_BULK', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
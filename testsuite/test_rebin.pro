@@ -8,4 +8,26 @@ pro test_rebin
     ~array_equal([4,6,8,10], size(rebin(a,4,6,8,10), /dim)) || $
     ~array_equal([4,6,8,10], size(rebin(a,[4,6,8,10]), /dim)) $
   then exit, status=1
+
+  ; values: block averages, /SAMPLE, linear expansion, integer types
+  b = findgen(4,4)
+  if $
+    ~array_equal(rebin(b,2,2), [[2.5,4.5],[10.5,12.5]]) || $
+    ~array_equal(rebin(b,2,2,/sample), [[0.,2],[8,10]]) || $
+    ~array_equal(rebin([0.,2.],4), [0.,1,2,2]) || $
+    ~array_equal(rebin(bindgen(4),2), [0b,2b]) || $
+    ~array_equal(rebin([-1,-3,5,7],2), [-2,6]) || $
+    ~array_equal(rebin(indgen(2,2),4,4,/sample), [[0,0,1,1],[0,0,1,1],[2,2,3,3],[2,2,3,3]]) $
+  then exit, status=1
+
+  ; compress then expand, threaded and not
+  c = dindgen(64,32,6)
+  ref = rebin(rebin(rebin(c,16,32,6),16,8,6),16,8,12)
+  savecpu = !cpu
+  cpu, tpool_min_elts=100, tpool_nthreads=!cpu.hw_ncpu
+  if $
+    ~array_equal(rebin(c,16,8,12), ref) || $
+    ~array_equal(rebin(c,16,8,12,/sample), rebin(rebin(c,16,8,6,/sample),16,8,12,/sample)) $
+  then exit, status=1
+  cpu, restore=savecpu
 end
@@ -122,6 +122,64 @@ end
 ;
 ; -----------------------------------------------
 ;
+; large compressed records (deflated in parallel blocks) and restoring
+; a subset of the variables with VARIABLES=
+;
+pro TEST_SAVE_RESTORE_COMPRESS_LAZY, cumul_errors, file=file, $
+                                     verbose=verbose, test=test
+;
+errors=0
+;
+big_ref=DINDGEN(3000000L)/7d
+small_ref=INDGEN(10)
+name_ref='lazy restore'
+big=big_ref
+small=small_ref
+name=name_ref
+SAVE, file=file, big, small, name, /compress
+big=0 & small=0 & name=0
+;
+RESTORE, file
+if ~ARRAY_EQUAL(big, big_ref, /no_typeconv) then ERRORS_ADD, errors, 'compressed, large'
+if ~ARRAY_EQUAL(small, small_ref, /no_typeconv) then ERRORS_ADD, errors, 'compressed, small'
+;
+big=0 & small=0 & name=0
+RESTORE, file, variables=['small', 'Name']
+if ~ARRAY_EQUAL(small, small_ref, /no_typeconv) then ERRORS_ADD, errors, 'VARIABLES, small'
+if name NE name_ref then ERRORS_ADD, errors, 'VARIABLES, name'
+if ~ARRAY_EQUAL(big, 0) then ERRORS_ADD, errors, 'VARIABLES, big restored'
+;
+; the same, uncompressed
+SAVE, file=file, big_ref, small_ref
+big_ref=0
+RESTORE, file, variables='small_ref'
+if ~ARRAY_EQUAL(big_ref, 0) then ERRORS_ADD, errors, 'uncompressed VARIABLES'
+;
+; pointers: only the heap data reachable from the requested variables
+; is kept
+p_keep=PTR_NEW({a:PTR_NEW(INDGEN(5)), b:'kept'})
+p_skip=PTR_NEW(FINDGEN(1000))
+SAVE, file=file, p_skip, p_keep, /compress
+PTR_FREE, (*p_keep).a, p_keep, p_skip
+p_keep=0 & p_skip=0
+before=PTR_VALID(count=nb_before)
+RESTORE, file, variables='p_keep'
+after=PTR_VALID(count=nb_after)
+if ~PTR_VALID(p_keep) || ~ISA(p_skip, /number) then ERRORS_ADD, errors, 'pointer VARIABLES'
+if (*p_keep).b NE 'kept' || ~ARRAY_EQUAL(*(*p_keep).a, INDGEN(5)) then $
+   ERRORS_ADD, errors, 'pointer VARIABLES, values'
+if nb_after NE nb_before+2 then ERRORS_ADD, errors, 'pointer VARIABLES, heap not freed'
+PTR_FREE, (*p_keep).a, p_keep
+;
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, "TEST_SAVE_RESTORE_COMPRESS_LAZY", errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; -----------------------------------------------
+;
 pro TEST_SAVE_RESTORE, help=help, test=test, verbose=verbose
 ;
 if KEYWORD_SET(help) then begin
@@ -158,6 +216,25 @@ TEST_SAVE_NUMERIC, dim1, dim2, file=fullfile, test=test, verbose=verbose
 TEST_RESTORE_NUMERIC, total_errors, file=fullfile, dim1ref=dim1, dim2ref=dim2, $
                       test=test, verbose=verbose
 ;
+; third test : compression, VARIABLES=
+;
+fullfile=path+prefix+'_save_test_lazy.sav'
+TEST_SAVE_RESTORE_COMPRESS_LAZY, total_errors, file=fullfile, $
+                                 test=test, verbose=verbose
+;
+; fourth test : large arrays (bulk XDR coding, more than one chunk)
+;
+radical='_save_test_numeric3.sav'
+fullfile=path+prefix+radical
+;
+dim1=1100000L
+dim2=[300,40]
+;
+TEST_SAVE_NUMERIC, dim1, dim2, file=fullfile, test=test, verbose=verbose
+TEST_RESTORE_NUMERIC, total_errors, file=fullfile, dim1ref=dim1, dim2ref=dim2, $
+                      test=test, verbose=verbose
+FILE_DELETE, fullfile, /quiet
+;
 ; final message
 ;
 BANNER_FOR_TESTSUITE, 'TEST_SAVE_RESTORE', total_errors, short=short
@@ -0,0 +1,138 @@
+;
+; Tests for SHMMAP, SHMVAR, SHMUNMAP and for ASSOC reads on
+; read-only files (served from a memory mapping)
+;
+; ---------------------------------------
+;
+pro TEST_SHMMAP_SEGMENT, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+SHMMAP, 'test_shm_seg', 10, 20, /long
+a=SHMVAR('test_shm_seg')
+b=SHMVAR('test_shm_seg')
+if ~ARRAY_EQUAL(SIZE(a, /dim), [10,20]) then ERRORS_ADD, nb_errors, 'dimensions'
+if SIZE(a, /type) NE 3 then ERRORS_ADD, nb_errors, 'type'
+;
+; both variables see the same memory
+a[*]=LINDGEN(200)
+if ~ARRAY_EQUAL(b, LINDGEN(10,20)) then ERRORS_ADD, nb_errors, 'shared write'
+b[5]=-1
+if a[5] NE -1 then ERRORS_ADD, nb_errors, 'shared write back'
+;
+; another view on the same segment
+c=SHMVAR('test_shm_seg', 400, /byte)
+if N_ELEMENTS(c) NE 400 || SIZE(c, /type) NE 1 then ERRORS_ADD, nb_errors, 'BYTE view'
+;
+; larger than the segment
+catch, err
+if err EQ 0 then begin
+   d=SHMVAR('test_shm_seg', 1000, /double)
+   ERRORS_ADD, nb_errors, 'too large not detected'
+endif
+catch, /cancel
+;
+; unmapped only once the variables are gone
+SHMUNMAP, 'test_shm_seg'
+if b[5] NE -1 then ERRORS_ADD, nb_errors, 'data kept after SHMUNMAP'
+a=0 & b=0 & c=0
+;
+; GET_NAME, DIMENSION=
+SHMMAP, dimension=[5,5], /double, get_name=name
+e=SHMVAR(name)
+if ~ARRAY_EQUAL(SIZE(e, /dim), [5,5]) || SIZE(e, /type) NE 5 then $
+   ERRORS_ADD, nb_errors, 'DIMENSION / GET_NAME'
+e=0
+SHMUNMAP, name
+;
+BANNER_FOR_TESTSUITE, 'TEST_SHMMAP_SEGMENT', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_SHMMAP_FILES, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+file='test_shmmap.dat'
+data=FINDGEN(8,100)
+GET_LUN, lun
+OPENW, lun, file
+WRITEU, lun, LONG(42), data
+CLOSE, lun
+;
+; ASSOC records on a read-only unit
+OPENR, lun, file
+x=ASSOC(lun, FLTARR(8), 4)
+if ~ARRAY_EQUAL(x[0], data[*,0]) then ERRORS_ADD, nb_errors, 'ASSOC first record'
+if ~ARRAY_EQUAL(x[99], data[*,99]) then ERRORS_ADD, nb_errors, 'ASSOC last record'
+if x[3,2] NE data[3,2] then ERRORS_ADD, nb_errors, 'ASSOC element'
+CLOSE, lun
+;
+; the file is mapped on first access: after a CD, the relative name
+; must not give a file of the same name in the new directory
+OPENR, lun, file
+x=ASSOC(lun, FLTARR(8), 4)
+subdir='test_shmmap_dir'
+FILE_MKDIR, subdir
+CD, subdir, current=olddir
+OPENW, lun2, file, /get_lun
+WRITEU, lun2, LONG(0), -data
+FREE_LUN, lun2
+r=x[5]
+FILE_DELETE, file
+CD, olddir
+FILE_DELETE, subdir
+if ~ARRAY_EQUAL(r, data[*,5]) then ERRORS_ADD, nb_errors, 'ASSOC after CD'
+CLOSE, lun
+FREE_LUN, lun
+;
+; the file itself as a segment, past the header
+SHMMAP, 'test_shm_file', 8, 100, filename=file, offset=4
+f=SHMVAR('test_shm_file')
+if ~ARRAY_EQUAL(f, data) then ERRORS_ADD, nb_errors, 'FILENAME read'
+f[0]=-5.
+f=0
+SHMUNMAP, 'test_shm_file'
+OPENR, lun, file, /GET_LUN
+h=0L & g=FLTARR(8,100)
+READU, lun, h, g
+FREE_LUN, lun
+if g[0] NE -5. || h NE 42 then ERRORS_ADD, nb_errors, 'FILENAME write'
+;
+FILE_DELETE, file
+;
+BANNER_FOR_TESTSUITE, 'TEST_SHMMAP_FILES', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_SHMMAP, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_SHMMAP, help=help, verbose=verbose, $'
+   print, '                 no_exit=no_exit, test=test'
+   return
+endif
+;
+if !version.os_family EQ 'Windows' then begin
+   MESSAGE, /continue, 'Shared memory not available on this platform'
+   if ~KEYWORD_SET(no_exit) then EXIT, status=77 else return
+endif
+;
+cumul_errors=0
+;
+TEST_SHMMAP_SEGMENT, cumul_errors, verbose=verbose
+TEST_SHMMAP_FILES, cumul_errors, verbose=verbose
+;
+BANNER_FOR_TESTSUITE, 'TEST_SHMMAP', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
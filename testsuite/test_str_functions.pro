@@ -85,6 +85,57 @@ end
 ;
 ; ---------------
 ;
+; STRTRIM, STRCOMPRESS, STRUPCASE, STRLOWCASE, STRPOS on arrays large
+; enough to use the threads; temporaries are processed in place, the
+; input variables must stay untouched
+;
+pro TEST_STR_ARRAYS, exit_on_error=exit_on_error, test=test
+;
+flag_pb=0
+;
+a=[' a b ', '', '  ', 'x'+STRING(9b)+STRING(9b)+'y  ', 'long string without any blank at all']
+n=20000L
+big=a[LINDGEN(n) mod N_ELEMENTS(a)]
+save=big
+;
+exp0=[' a b', '', '', 'x'+STRING(9b)+STRING(9b)+'y', a[4]]
+exp1=['a b ', '', '', 'x'+STRING(9b)+STRING(9b)+'y  ', a[4]]
+exp2=['a b', '', '', 'x'+STRING(9b)+STRING(9b)+'y', a[4]]
+ix=LINDGEN(n) mod N_ELEMENTS(a)
+if ~ARRAY_EQUAL(STRTRIM(big), exp0[ix]) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRTRIM(big,1), exp1[ix]) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRTRIM(big,2), exp2[ix]) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRTRIM(big+'',2), exp2[ix]) then flag_pb=flag_pb+1
+;
+expc=[' a b ', '', ' ', 'x y ', a[4]]
+expr=['ab', '', '', 'xy', 'longstringwithoutanyblankatall']
+if ~ARRAY_EQUAL(STRCOMPRESS(big), expc[ix]) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRCOMPRESS(big+'', /remove_all), expr[ix]) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(big, save) then flag_pb=flag_pb+1
+;
+; only ASCII letters change case
+s='aZ09_~'+STRING(200b)
+if STRUPCASE(s) NE 'AZ09_~'+STRING(200b) then flag_pb=flag_pb+1
+if STRLOWCASE(s) NE 'az09_~'+STRING(200b) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRLOWCASE(STRUPCASE(big)), big) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRPOS(big, 'b'), ([3,-1,-1,-1,24])[ix]) then flag_pb=flag_pb+1
+if ~ARRAY_EQUAL(STRLEN(big), STRLEN(a[ix])) then flag_pb=flag_pb+1
+mid=STRMID(a, 1, 2)
+if ~ARRAY_EQUAL(STRMID(big, 1, 2), mid[ix]) then flag_pb=flag_pb+1
+;
+if flag_pb GT 0 then begin
+    MESSAGE, /continue, STRING(flag_pb)+' ERROR(s) found on string arrays'
+    if KEYWORD_SET(exit_on_error) then  EXIT, status=1
+endif else begin
+    MESSAGE, /continue, 'No ERROR found on string arrays'
+endelse
+;
+if KEYWORD_SET(test) then STOP
+;
+end
+;
+; ---------------
+;
 pro TEST_STR_FUNCTIONS
 ;
 ; this is bad because tests in TEST_STRSPLIT
@@ -92,5 +143,12 @@ pro TEST_STR_FUNCTIONS
 ; 
 TEST_STRMID, /exit_on_error
 TEST_STRSPLIT, /exit_on_error
+TEST_STR_ARRAYS, /exit_on_error
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_STR_ARRAYS, /exit_on_error
+CPU, RESTORE=SAVECPU
 ;
 end
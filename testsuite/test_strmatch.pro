@@ -41,5 +41,16 @@ pro test_strmatch
   err += assert('.()+{}|^$', '.()+{?^$', 0)
   err += assert('foot', 'f??t', 1)
   err += ~array_equal(strmatch(['gdl', 'GDL'], 'gdl'), [1,0])
+  err += ~array_equal(strmatch([['a.pro','b.txt'],['c.PRO','d']], '*.pro', /fold), [[1,0],[1,0]])
+  ; large array, threaded: same as the loop on scalars
+  ext = ['.pro', '.txt']
+  names = 'file_' + strtrim(lindgen(5000), 2) + ext[lindgen(5000) mod 2]
+  savecpu = !cpu
+  cpu, tpool_min_elts=100, tpool_nthreads=!cpu.hw_ncpu
+  res = strmatch(names, 'file_*[02].pro')
+  cpu, restore=savecpu
+  ref = bytarr(n_elements(names))
+  for i = 0, n_elements(names)-1 do ref[i] = strmatch(names[i], 'file_*[02].pro')
+  err += ~array_equal(res, ref) || (total(res) ne 1000)
   if err ne 0 then exit, status=1
 end
@@ -357,6 +357,36 @@ endelse
 ;new version: supports arrays:
 res=strsplit(strarray,COUNT=c, LENGTH=l)
 ;
+; array input: a LIST of the STRSPLIT of each element, COUNT an array,
+; LENGTH a LIST; checked against the scalar calls, also threaded
+SAVECPU=!CPU
+for pass=0,1 do begin
+   if pass EQ 1 then CPU, TPOOL_MIN_ELTS=2, TPOOL_NTHREADS=!CPU.HW_NCPU
+   for regex=0,1 do begin
+      pattern=(regex) ? '\$+' : '$'
+      res=STRSPLIT(strarray, pattern, COUNT=c, LENGTH=l, /extract, regex=regex)
+      if ~ISA(res, 'LIST') || (N_ELEMENTS(res) NE N_ELEMENTS(strarray)) then begin
+         if KEYWORD_SET(verbose) then MESSAGE, 'array input: not a LIST', /continue
+         nb_pbs=nb_pbs+1
+         continue
+      endif
+      for i=0, N_ELEMENTS(strarray)-1 do begin
+         ref=STRSPLIT(strarray[i], pattern, COUNT=ci, LENGTH=li, /extract, regex=regex)
+         if ~ARRAY_EQUAL(res[i], ref) || (c[i] NE ci) || ~ARRAY_EQUAL(l[i], li) then begin
+            if KEYWORD_SET(verbose) then MESSAGE, 'array input, element '+STRTRIM(i,2), /continue
+            nb_pbs=nb_pbs+1
+         endif
+      endfor
+   endfor
+endfor
+CPU, RESTORE=SAVECPU
+;
+res=STRSPLIT(['a b', 'c;d;e'], [' ', ';'], /extract)
+if ~ARRAY_EQUAL(res[1], ['c','d','e']) then begin
+   if KEYWORD_SET(verbose) then MESSAGE, 'one pattern per element', /continue
+   nb_pbs=nb_pbs+1
+endif
+;
 line="======================================="
 MESSAGE, /Continue, line
 MESSAGE, /Continue, " "
@@ -0,0 +1,103 @@
+;
+; Binary operators reuse the buffer of a temporary operand (result of
+; another expression, TEMPORARY()) instead of allocating the result.
+; Checks that the results are right and that the named operands are
+; never overwritten.
+;
+; ---------------------------------------
+;
+pro TEST_TMP_SCALAR, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+; (temporary scalar) op (variable scalar), all operators, some types
+a=6 & b=4 & c=3
+if (a*b)+c NE 27 then ERRORS_ADD, nb_errors, 'INT +'
+if (a*b)-c NE 21 then ERRORS_ADD, nb_errors, 'INT -'
+if (a+b)*c NE 30 then ERRORS_ADD, nb_errors, 'INT *'
+if (a*b)/c NE 8 then ERRORS_ADD, nb_errors, 'INT /'
+if (a*b) MOD 5 NE 4 then ERRORS_ADD, nb_errors, 'INT MOD'
+if (a*b) MOD c NE 0 then ERRORS_ADD, nb_errors, 'INT MOD var'
+if ((a+b) AND c) NE 2 then ERRORS_ADD, nb_errors, 'INT AND'
+if ((a+b) OR c) NE 11 then ERRORS_ADD, nb_errors, 'INT OR'
+if ((a+b) XOR c) NE 9 then ERRORS_ADD, nb_errors, 'INT XOR'
+if (a+b) < c NE 3 then ERRORS_ADD, nb_errors, 'INT <'
+if (a+b) > c NE 10 then ERRORS_ADD, nb_errors, 'INT >'
+if (a NE 6) || (b NE 4) || (c NE 3) then ERRORS_ADD, nb_errors, 'INT operands changed'
+;
+x=2.5 & y=0.5
+if (x*2)-y NE 4.5 then ERRORS_ADD, nb_errors, 'FLOAT -'
+if (x*2)/y NE 10. then ERRORS_ADD, nb_errors, 'FLOAT /'
+if ((x-2.5) AND y) NE 0. then ERRORS_ADD, nb_errors, 'FLOAT AND (zero)'
+if ((x*2) AND y) NE y then ERRORS_ADD, nb_errors, 'FLOAT AND'
+if (x NE 2.5) || (y NE 0.5) then ERRORS_ADD, nb_errors, 'FLOAT operands changed'
+;
+s1='ab' & s2='cd'
+if (s1+s2)+s1 NE 'abcdab' then ERRORS_ADD, nb_errors, 'STRING +'
+if STRUPCASE(s1)+s2 NE 'ABcd' then ERRORS_ADD, nb_errors, 'STRING + (function result)'
+if (s1 NE 'ab') || (s2 NE 'cd') then ERRORS_ADD, nb_errors, 'STRING operands changed'
+;
+; result of a mixed type expression
+if (a*b)+y NE 24.5 then ERRORS_ADD, nb_errors, 'INT + FLOAT'
+if SIZE((a*b)+y, /type) NE 4 then ERRORS_ADD, nb_errors, 'INT + FLOAT type'
+;
+; scalar loop accumulating into temporaries
+tot=0L
+for i=0L, 999 do tot=(tot+i)-1
+if tot NE 499500L-1000 then ERRORS_ADD, nb_errors, 'loop'
+;
+BANNER_FOR_TESTSUITE, 'TEST_TMP_SCALAR', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_TMP_ARRAY, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+n=1000
+a=FINDGEN(n) & b=FINDGEN(n)+1 & c=2. & d=REPLICATE(4., n)
+;
+x=((a+b)*c)/d
+if ~ARRAY_EQUAL(x, (2*FINDGEN(n)+1)/2.) then ERRORS_ADD, nb_errors, 'chain'
+if ~ARRAY_EQUAL(a, FINDGEN(n)) || ~ARRAY_EQUAL(b, FINDGEN(n)+1) || $
+   ~ARRAY_EQUAL(d, REPLICATE(4., n)) then ERRORS_ADD, nb_errors, 'chain operands changed'
+;
+; temporary larger than the variable operand: result has the smaller size
+y=(a+b)-d[0:9]
+if N_ELEMENTS(y) NE 10 then ERRORS_ADD, nb_errors, 'sizes'
+if ~ARRAY_EQUAL(y, 2*FINDGEN(10)-3) then ERRORS_ADD, nb_errors, 'sizes values'
+;
+t=a
+z=TEMPORARY(t)*c+1
+if ~ARRAY_EQUAL(z, 2*FINDGEN(n)+1) then ERRORS_ADD, nb_errors, 'TEMPORARY()'
+if N_ELEMENTS(t) NE 0 then ERRORS_ADD, nb_errors, 'TEMPORARY() variable still defined'
+;
+BANNER_FOR_TESTSUITE, 'TEST_TMP_ARRAY', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_TEMPORARY_OPERANDS, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_TEMPORARY_OPERANDS, help=help, verbose=verbose, $'
+   print, '                             no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+TEST_TMP_SCALAR, cumul_errors, verbose=verbose
+TEST_TMP_ARRAY, cumul_errors, verbose=verbose
+;
+BANNER_FOR_TESTSUITE, 'TEST_TEMPORARY_OPERANDS', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
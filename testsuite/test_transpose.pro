@@ -0,0 +1,118 @@
+;
+; Tests for TRANSPOSE(): tiled copy for any permutation,
+; and in place path for square temporaries.
+;
+; ---------------------------------------
+;
+; reference transpose, element by element
+function TRANSPOSE_REF, a, perm
+;
+dims=SIZE(a, /dim)
+rank=N_ELEMENTS(dims)
+rdims=dims[perm]
+res=MAKE_ARRAY(rdims, type=SIZE(a, /type))
+for e=0L, N_ELEMENTS(a)-1 do begin
+   ;; result multi-index -> source index
+   r=ARRAY_INDICES(rdims, e, /dim)
+   s=LONARR(rank)
+   s[perm]=r
+   ix=0L & stride=1L
+   for i=0, rank-1 do begin
+      ix=ix+s[i]*stride
+      stride=stride*dims[i]
+   endfor
+   res[e]=a[ix]
+endfor
+return, res
+end
+;
+; ---------------------------------------
+;
+pro TEST_TRANSPOSE_PERM, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+; 2D, sizes not multiple of the tiles
+a=FINDGEN(37,130)
+if ~ARRAY_EQUAL(TRANSPOSE(a), TRANSPOSE_REF(a,[1,0])) then ERRORS_ADD, nb_errors, '2D float'
+b=BINDGEN(300,5)
+if ~ARRAY_EQUAL(TRANSPOSE(b), TRANSPOSE_REF(b,[1,0])) then ERRORS_ADD, nb_errors, '2D byte'
+c=DCOMPLEX(DINDGEN(17,19), -DINDGEN(17,19))
+if ~ARRAY_EQUAL(TRANSPOSE(c), TRANSPOSE_REF(c,[1,0])) then ERRORS_ADD, nb_errors, '2D dcomplex'
+s=STRING(INDGEN(9,4))
+if ~ARRAY_EQUAL(TRANSPOSE(s), TRANSPOSE_REF(s,[1,0])) then ERRORS_ADD, nb_errors, '2D string'
+;
+; 3D and 4D, all kinds of permutations
+d=LINDGEN(13,7,21)
+perms=[[0,1,2],[0,2,1],[1,0,2],[1,2,0],[2,0,1],[2,1,0]]
+for i=0, 5 do begin
+   p=perms[*,i]
+   if ~ARRAY_EQUAL(TRANSPOSE(d,p), TRANSPOSE_REF(d,p)) then $
+      ERRORS_ADD, nb_errors, '3D perm '+STRJOIN(STRTRIM(p,2),',')
+endfor
+if ~ARRAY_EQUAL(SIZE(TRANSPOSE(d),/dim), [21,7,13]) then ERRORS_ADD, nb_errors, '3D default dims'
+if ~ARRAY_EQUAL(TRANSPOSE(d), TRANSPOSE_REF(d,[2,1,0])) then ERRORS_ADD, nb_errors, '3D default'
+;
+e=DINDGEN(5,6,7,3)
+p=[3,0,2,1]
+if ~ARRAY_EQUAL(TRANSPOSE(e,p), TRANSPOSE_REF(e,p)) then ERRORS_ADD, nb_errors, '4D perm'
+;
+BANNER_FOR_TESTSUITE, 'TEST_TRANSPOSE_PERM', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_TRANSPOSE_INPLACE, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+for n=1, 150, 37 do begin
+   a=FINDGEN(n,n)
+   expected=TRANSPOSE_REF(a,[1,0])
+   b=a
+   res=TRANSPOSE(TEMPORARY(b))
+   if ~ARRAY_EQUAL(res, expected) then ERRORS_ADD, nb_errors, 'temporary, n='+STRTRIM(n,2)
+   res=TRANSPOSE(a+0., [1,0])
+   if ~ARRAY_EQUAL(res, expected) then ERRORS_ADD, nb_errors, 'expression, n='+STRTRIM(n,2)
+   ;; the input variable must not be modified
+   res=TRANSPOSE(a)
+   if ~ARRAY_EQUAL(a, FINDGEN(n,n)) then ERRORS_ADD, nb_errors, 'input modified, n='+STRTRIM(n,2)
+endfor
+;
+BANNER_FOR_TESTSUITE, 'TEST_TRANSPOSE_INPLACE', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_TRANSPOSE, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_TRANSPOSE, help=help, verbose=verbose, $'
+   print, '                    no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+TEST_TRANSPOSE_PERM, cumul_errors, verbose=verbose
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_TRANSPOSE_PERM, cumul_errors, verbose=verbose
+TEST_TRANSPOSE_INPLACE, cumul_errors, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+TEST_TRANSPOSE_INPLACE, cumul_errors, verbose=verbose
+;
+BANNER_FOR_TESTSUITE, 'TEST_TRANSPOSE', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
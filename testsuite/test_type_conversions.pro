@@ -0,0 +1,116 @@
+;
+; Tests for the implicit type conversions (Convert2): numeric
+; arrays converted by chunks, and the number -> string formatting.
+;
+; ---------------------------------------
+;
+pro TEST_CONV_NUMERIC, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+n=100003L
+;
+u=UINDGEN(n)
+f=FLOAT(u)
+if ~ARRAY_EQUAL(LONG(f), LONG(u)) then ERRORS_ADD, nb_errors, 'UINT -> FLOAT'
+d=DOUBLE(LINDGEN(n)-n/2)
+if ~ARRAY_EQUAL(LONG64(d), L64INDGEN(n)-n/2) then ERRORS_ADD, nb_errors, 'LONG -> DOUBLE -> LONG64'
+;
+; BYTE is modulo 256, also from floats (through LONG)
+b=BYTE(-FINDGEN(n))
+ok=1
+for i=0L, n-1, 997 do if b[i] NE BYTE(-LONG(i)) then ok=0
+if ~ok then ERRORS_ADD, nb_errors, 'FLOAT -> BYTE'
+if BYTE(-1.0) NE 255b then ERRORS_ADD, nb_errors, 'BYTE(-1.0)'
+if BYTE(-1d) NE 255b then ERRORS_ADD, nb_errors, 'BYTE(-1d)'
+if BYTE(COMPLEX(-2,5)) NE 254b then ERRORS_ADD, nb_errors, 'BYTE(complex)'
+;
+; real part from complex, both parts kept between complex types
+c=COMPLEX(FINDGEN(n), -FINDGEN(n))
+if ~ARRAY_EQUAL(FIX(c), FIX(FINDGEN(n))) then ERRORS_ADD, nb_errors, 'COMPLEX -> INT'
+dc=DCOMPLEX(c)
+if ~ARRAY_EQUAL(IMAGINARY(dc), -DINDGEN(n)) then ERRORS_ADD, nb_errors, 'COMPLEX -> DCOMPLEX'
+if ~ARRAY_EQUAL(COMPLEX(dc), c) then ERRORS_ADD, nb_errors, 'DCOMPLEX -> COMPLEX'
+;
+; every integer type to DCOMPLEX
+types=[1,2,3,12,13,14,15]
+for k=0, N_ELEMENTS(types)-1 do begin
+   dc=DCOMPLEX(INDGEN(n, type=types[k]))
+   if ~ARRAY_EQUAL(REAL_PART(dc), DOUBLE(INDGEN(n, type=types[k]))) || $
+      ~ARRAY_EQUAL(IMAGINARY(dc), 0d) then $
+      ERRORS_ADD, nb_errors, 'type '+STRTRIM(types[k],2)+' -> DCOMPLEX'
+endfor
+if DCOMPLEX(4000000000ul) NE DCOMPLEX(4d9, 0) then ERRORS_ADD, nb_errors, 'ULONG -> DCOMPLEX'
+;
+; integer wrap around
+if ~ARRAY_EQUAL(FIX([40000L,-40000L]), [-25536,25536]) then ERRORS_ADD, nb_errors, 'LONG -> INT'
+if ~ARRAY_EQUAL(UINT(-LINDGEN(3)), [0us,65535us,65534us]) then ERRORS_ADD, nb_errors, 'LONG -> UINT'
+;
+BANNER_FOR_TESTSUITE, 'TEST_CONV_NUMERIC', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_CONV_STRING, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+fl=[1.5, 123123., -0.25, 1e20, 1.2345678e-5, 0., 100000., 1234567.]
+exp_fl=['      1.50000','      123123.','    -0.250000','  1.00000e+20', $
+        '  1.23457e-05','      0.00000','      100000.','  1.23457e+06']
+if ~ARRAY_EQUAL(STRING(fl), exp_fl) then ERRORS_ADD, nb_errors, 'FLOAT -> STRING'
+;
+db=[1d, -!dpi, 1d-300, 12345678.9d, 0.001d]
+exp_db=['       1.0000000','      -3.1415927','  1.0000000e-300', $
+        '       12345679.','    0.0010000000']
+if ~ARRAY_EQUAL(STRING(db), exp_db) then ERRORS_ADD, nb_errors, 'DOUBLE -> STRING'
+;
+if STRING(-5) NE '      -5' then ERRORS_ADD, nb_errors, 'INT -> STRING'
+if STRING(65535us) NE '   65535' then ERRORS_ADD, nb_errors, 'UINT -> STRING'
+if STRING(-2147483647L-1) NE ' -2147483648' then ERRORS_ADD, nb_errors, 'LONG -> STRING'
+if STRING(-9223372036854775807LL-1) NE '  -9223372036854775808' then $
+   ERRORS_ADD, nb_errors, 'LONG64 -> STRING'
+if STRING(18446744073709551615ULL) NE  '  18446744073709551615' then $
+   ERRORS_ADD, nb_errors, 'ULONG64 -> STRING'
+;
+; string concatenation goes through the same formatting
+if 'x'+STRING(7L) NE 'x'+7L then ERRORS_ADD, nb_errors, 'concatenation'
+;
+; round trip
+v=RANDOMU(seed, 1000)*1e4
+if MAX(ABS(FLOAT(STRING(v))-v)/v) GT 1e-5 then ERRORS_ADD, nb_errors, 'FLOAT round trip'
+;
+BANNER_FOR_TESTSUITE, 'TEST_CONV_STRING', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_TYPE_CONVERSIONS, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_TYPE_CONVERSIONS, help=help, verbose=verbose, $'
+   print, '                           no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+TEST_CONV_NUMERIC, cumul_errors, verbose=verbose
+TEST_CONV_STRING, cumul_errors, verbose=verbose
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_CONV_NUMERIC, cumul_errors, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+BANNER_FOR_TESTSUITE, 'TEST_TYPE_CONVERSIONS', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
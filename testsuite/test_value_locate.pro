@@ -0,0 +1,101 @@
+;
+; Tests for VALUE_LOCATE and UNIQ (native versions of the former
+; value_locate.pro and uniq.pro)
+;
+; ---------------------------------------
+;
+pro TEST_VALUE_LOCATE_BASIC, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+x=[1., 2., 2., 4., 8.]
+u=[0., 1., 1.5, 2., 3., 8., 9.]
+if ~ARRAY_EQUAL(VALUE_LOCATE(x, u), [-1,0,0,2,2,4,4]) then $
+   ERRORS_ADD, nb_errors, 'increasing'
+if ~ARRAY_EQUAL(VALUE_LOCATE(REVERSE(x), u), [4,3,3,1,1,-1,-1]) then $
+   ERRORS_ADD, nb_errors, 'decreasing'
+;
+; shape and type of the result
+if SIZE(VALUE_LOCATE(x, 3.), /n_dim) NE 0 then ERRORS_ADD, nb_errors, 'scalar'
+if SIZE(VALUE_LOCATE(x, 3.), /type) NE 3 then ERRORS_ADD, nb_errors, 'LONG type'
+if SIZE(VALUE_LOCATE(x, 3., /l64), /type) NE 14 then ERRORS_ADD, nb_errors, 'L64 type'
+if ~ARRAY_EQUAL(SIZE(VALUE_LOCATE(x, FLTARR(3,2)), /dim), [3,2]) then $
+   ERRORS_ADD, nb_errors, 'dimensions'
+;
+; integers are compared exactly
+big=[2LL^60, 2LL^60+1, 2LL^60+2]
+if ~ARRAY_EQUAL(VALUE_LOCATE(big, 2LL^60+1), 1) then ERRORS_ADD, nb_errors, 'LONG64'
+;
+if ~ARRAY_EQUAL(VALUE_LOCATE([5], [4,5,6]), [-1,0,0]) then ERRORS_ADD, nb_errors, 'one element'
+;
+; against a loop on a large random case
+n=10000L
+x=FLOAT(LINDGEN(n))+RANDOMU(seed, n)*0.5
+u=RANDOMU(seed, n/2)*(n+10)-5
+res=VALUE_LOCATE(x, u)
+ref=LONARR(n/2)
+for i=0L, n/2-1 do ref[i]=TOTAL(x LE u[i])-1
+if ~ARRAY_EQUAL(res, ref) then ERRORS_ADD, nb_errors, 'random'
+;
+BANNER_FOR_TESTSUITE, 'TEST_VALUE_LOCATE_BASIC', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_UNIQ, cumul_errors, test=test, verbose=verbose
+;
+nb_errors=0
+;
+a=[1,1,2,2,2,3,5,5]
+if ~ARRAY_EQUAL(UNIQ(a), [1,4,5,7]) then ERRORS_ADD, nb_errors, 'sorted'
+if ~ARRAY_EQUAL(a[UNIQ(a)], [1,2,3,5]) then ERRORS_ADD, nb_errors, 'values'
+;
+b=[5,1,3,1,5,2]
+ix=SORT(b)
+if ~ARRAY_EQUAL(b[UNIQ(b, ix)], [1,2,3,5]) then ERRORS_ADD, nb_errors, 'index'
+;
+if UNIQ([7,7,7]) NE 2 then ERRORS_ADD, nb_errors, 'all equal'
+if UNIQ(3) NE 0 then ERRORS_ADD, nb_errors, 'scalar'
+if ~ARRAY_EQUAL(UNIQ(['a','a','b']), [1,2]) then ERRORS_ADD, nb_errors, 'strings'
+;
+; large array, checked against WHERE
+c=LONG(RANDOMU(seed, 100000)*1000)
+c=c[SORT(c)]
+if ~ARRAY_EQUAL(UNIQ(c), WHERE(c NE SHIFT(c, -1))) then ERRORS_ADD, nb_errors, 'large'
+;
+BANNER_FOR_TESTSUITE, 'TEST_UNIQ', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_VALUE_LOCATE, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_VALUE_LOCATE, help=help, verbose=verbose, $'
+   print, '                       no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+;
+TEST_VALUE_LOCATE_BASIC, cumul_errors, verbose=verbose
+TEST_UNIQ, cumul_errors, verbose=verbose
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_VALUE_LOCATE_BASIC, cumul_errors, verbose=verbose
+TEST_UNIQ, cumul_errors, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+BANNER_FOR_TESTSUITE, 'TEST_VALUE_LOCATE', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end
@@ -0,0 +1,116 @@
+;
+; Tests for the native WRITE_CSV (formerly write_csv.pro), read back
+; as text and with READ_CSV
+;
+; ---------------------------------------
+;
+function TEST_WRITE_CSV_LINES, file
+nl=FILE_LINES(file)
+lines=STRARR(nl)
+OPENR, lun, file, /get_lun
+READF, lun, lines
+FREE_LUN, lun
+return, lines
+end
+;
+; ---------------------------------------
+;
+pro TEST_WRITE_CSV_FORMS, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+; structure: tag names as header, numbers as STRING() gives them
+s={planet:['Saturn','Mars'], weight:[95.159, 0.107], moons:[146L, 2], $
+   note:['say "hi"', 'a, b']}
+WRITE_CSV, file, s
+lines=TEST_WRITE_CSV_LINES(file)
+expected=['"PLANET","WEIGHT","MOONS","NOTE"', $
+          '"Saturn",95.1590,146,"say ""hi"""', $
+          '"Mars",0.107000,2,"a, b"']
+if ~ARRAY_EQUAL(lines, expected) then ERRORS_ADD, nb_errors, 'structure'
+;
+; 2D array: one column per element of the first dimension
+WRITE_CSV, file, [[1,2,3],[4,5,6]]
+if ~ARRAY_EQUAL(TEST_WRITE_CSV_LINES(file), ['1,2,3','4,5,6']) then $
+   ERRORS_ADD, nb_errors, '2D array'
+;
+; vectors, header, table header, delimiter
+WRITE_CSV, file, [1d,2.5d], COMPLEX([1,2],[3,4]), header=['x','c'], $
+           table_header=['produced by', 'nobody'], delimiter=';'
+expected=['produced by', 'nobody', '"x";"c"', $
+          '1.0000000;"(1.00000,3.00000)"', '2.5000000;"(2.00000,4.00000)"']
+if ~ARRAY_EQUAL(TEST_WRITE_CSV_LINES(file), expected) then $
+   ERRORS_ADD, nb_errors, 'vectors, keywords'
+;
+WRITE_CSV, file, [!pi, 1e-9, !values.f_nan], precision=3
+if ~ARRAY_EQUAL(TEST_WRITE_CSV_LINES(file), ['3.14','1e-09','NaN']) then $
+   ERRORS_ADD, nb_errors, 'PRECISION'
+;
+; errors
+CATCH, err
+if err EQ 0 then begin
+   WRITE_CSV, file, [1,2], [1,2,3]
+   ERRORS_ADD, nb_errors, 'no error on different sizes'
+endif
+CATCH, /cancel
+;
+BANNER_FOR_TESTSUITE, 'TEST_WRITE_CSV_FORMS', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_WRITE_CSV_LARGE, cumul_errors, file, test=test, verbose=verbose
+;
+nb_errors=0
+;
+n=300001L
+x=LINDGEN(n)-n/2
+y=RANDOMU(seed, n)*1d6
+z=LONG64(x)*10000000000LL
+WRITE_CSV, file, x, y, z, 'r'+STRTRIM(x,2), precision=17
+;
+a=READ_CSV(file, count=count)
+if count NE n then ERRORS_ADD, nb_errors, 'count'
+if ~ARRAY_EQUAL(a.field1, x) then ERRORS_ADD, nb_errors, 'LONG'
+if ~ARRAY_EQUAL(a.field2, y) then ERRORS_ADD, nb_errors, 'DOUBLE'
+if ~ARRAY_EQUAL(a.field3, z) then ERRORS_ADD, nb_errors, 'LONG64'
+if ~ARRAY_EQUAL(a.field4, 'r'+STRTRIM(x,2)) then ERRORS_ADD, nb_errors, 'STRING'
+;
+BANNER_FOR_TESTSUITE, 'TEST_WRITE_CSV_LARGE', nb_errors, /status, verb=verbose
+ERRORS_CUMUL, cumul_errors, nb_errors
+if KEYWORD_SET(test) then STOP
+end
+;
+; ---------------------------------------
+;
+pro TEST_WRITE_CSV, help=help, verbose=verbose, no_exit=no_exit, test=test
+;
+if KEYWORD_SET(help) then begin
+   print, 'pro TEST_WRITE_CSV, help=help, verbose=verbose, $'
+   print, '                    no_exit=no_exit, test=test'
+   return
+endif
+;
+cumul_errors=0
+file=GDL_IDL_FL(/lower)+'_test_write_csv.csv'
+;
+TEST_WRITE_CSV_FORMS, cumul_errors, file, verbose=verbose
+TEST_WRITE_CSV_LARGE, cumul_errors, file, verbose=verbose
+;
+; forcing the threaded path
+SAVECPU=!CPU
+CPU, TPOOL_MIN_ELTS=100, TPOOL_NTHREADS=!CPU.HW_NCPU
+TEST_WRITE_CSV_LARGE, cumul_errors, file, verbose=verbose
+CPU, RESTORE=SAVECPU
+;
+FILE_DELETE, file, /quiet
+;
+BANNER_FOR_TESTSUITE, 'TEST_WRITE_CSV', cumul_errors
+;
+if (cumul_errors GT 0) AND ~KEYWORD_SET(no_exit) then EXIT, status=1
+;
+if KEYWORD_SET(test) then STOP
+;
+end